@@ -7,6 +7,7 @@
 #include <SDL_system.h>
 
 #include "SNES.hpp"
+#include "RunAhead/RunAhead.hpp"
 #include "AndroidRenderer.hpp"
 
 #define LOG_TAG "ComSquare_Native"
@@ -16,6 +17,10 @@
 // Globais
 std::unique_ptr<ComSquare::Renderer::AndroidRenderer> g_renderer;
 std::unique_ptr<ComSquare::SNES> g_snes;
+std::unique_ptr<ComSquare::RunAhead::RunAhead> g_runAhead;
+// Run-ahead: número de frames executados à frente (0 desativa) e uso de uma segunda instância em outra thread.
+unsigned g_runAheadFrames = 0;
+bool g_runAheadSecondInstance = false;
 std::string g_romPath = "";
 bool g_romLoaded = false;
 
@@ -30,7 +35,14 @@ Java_com_comsquare_emulator_MainActivity_onRomSelectedNative(JNIEnv* env, jobjec
         try {
             // Reinicia o emulador ao carregar nova ROM para limpar estado
             // g_snes->reset(); // Se existir método reset
+            g_runAhead.reset();
             g_snes->loadRom(g_romPath);
+            if (g_runAheadSecondInstance && g_runAheadFrames > 0) {
+                auto ahead = std::make_unique<ComSquare::SNES>(g_romPath, *g_renderer);
+                g_runAhead = std::make_unique<ComSquare::RunAhead::RunAhead>(*g_snes, g_runAheadFrames, std::move(ahead));
+            } else {
+                g_runAhead = std::make_unique<ComSquare::RunAhead::RunAhead>(*g_snes, g_runAheadFrames);
+            }
             g_romLoaded = true;
             LOGI("ROM carregada com sucesso!");
         } catch (const std::exception& e) {
@@ -119,9 +131,10 @@ int main(int argc, char* argv[]) {
         // Limpa a tela
         SDL_RenderClear(renderer);
 
-        if (g_romLoaded) {
+        if (g_romLoaded && g_runAhead) {
             try {
-                g_snes->update();
+                // Executa um frame inteiro (e os frames à frente, se o run-ahead estiver ativo) antes de apresentar.
+                g_runAhead->runFrame();
                 
                 // Atualiza textura
                 void* pixels;
@@ -4,15 +4,18 @@
 
 #include "APU.hpp"
 #include "Exceptions/InvalidAddress.hpp"
-#include "Exceptions/InvalidOpcode.hpp"
+#include "Exceptions/InvalidAction.hpp"
 #include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace ComSquare::APU
 {
-	APU::APU(Renderer::IRenderer &renderer)
-		: _dsp(renderer, this->_map)
+	APU::APU(Renderer::IRenderer &renderer, const Scheduler::Scheduler &scheduler)
+		: _dsp(renderer, this->_map.ram),
+		  _scheduler(scheduler)
 	{
 		this->reset();
 	}
@@ -27,16 +30,15 @@ namespace ComSquare::APU
 		return Apu;
 	}
 
-	uint8_t APU::_internalRead(uint24_t addr) const
+	uint8_t APU::_readSpecial(uint24_t addr)
 	{
 		switch (addr) {
-		case 0x0000 ... 0x00EF:
-			return this->_map.Page0[addr];
 		case 0xF0:
 			return this->_registers.unknown;
 		case 0xF2:
 			return this->_registers.dspregAddr;
 		case 0xF3:
+			this->_syncDSP();
 			return this->_dsp.read(this->_registers.dspregAddr);
 		case 0xF4:
 			return this->_registers.port0;
@@ -50,16 +52,16 @@ namespace ComSquare::APU
 			return this->_registers.regmem1;
 		case 0xF9:
 			return this->_registers.regmem2;
+		// Reading a counter resets it.
 		case 0xFD:
-			return this->_registers.counter0;
+			this->_updateTimers();
+			return std::exchange(this->_registers.counter0, 0);
 		case 0xFE:
-			return this->_registers.counter1;
+			this->_updateTimers();
+			return std::exchange(this->_registers.counter1, 0);
 		case 0xFF:
-			return this->_registers.counter2;
-		case 0x0100 ... 0x01FF:
-			return this->_map.Page1[addr - 0x0100];
-		case 0x0200 ... 0xFFBF:
-			return this->_map.Memory[addr - 0x200];
+			this->_updateTimers();
+			return std::exchange(this->_registers.counter2, 0);
 		case 0xFFC0 ... 0xFFFF:
 			return this->_map.IPL[addr - 0xFFC0];
 		default:
@@ -67,22 +69,33 @@ namespace ComSquare::APU
 		}
 	}
 
-	void APU::_internalWrite(uint24_t addr, uint8_t data)
+	void APU::_writeSpecial(uint24_t addr, uint8_t data)
 	{
 		switch (addr) {
-		case 0x0000 ... 0x00EF:
-			this->_map.Page0.write(addr, data);
-			break;
 		case 0xF0:
 			this->_registers.unknown = data;
 			break;
-		case 0xF1:
+		case 0xF1: {
+			this->_updateTimers();
+			// A timer that gets enabled starts over.
+			uint8_t enabled = data & ~this->_registers.ctrlreg;
+			for (unsigned i = 0; i < this->_timerStages.size(); i++)
+				if (enabled & (1u << i))
+					this->_timerStages[i] = 0;
+			if (enabled & 0x01u)
+				this->_registers.counter0 = 0;
+			if (enabled & 0x02u)
+				this->_registers.counter1 = 0;
+			if (enabled & 0x04u)
+				this->_registers.counter2 = 0;
 			this->_registers.ctrlreg = data;
 			break;
+		}
 		case 0xF2:
 			this->_registers.dspregAddr = data;
 			break;
 		case 0xF3:
+			this->_syncDSP();
 			this->_dsp.write(this->_registers.dspregAddr, data);
 			break;
 		case 0xF4:
@@ -104,22 +117,19 @@ namespace ComSquare::APU
 			this->_registers.regmem2 = data;
 			break;
 		case 0xFA:
+			this->_updateTimers();
 			this->_registers.timer0 = data;
 			break;
 		case 0xFB:
+			this->_updateTimers();
 			this->_registers.timer1 = data;
 			break;
 		case 0xFC:
+			this->_updateTimers();
 			this->_registers.timer2 = data;
 			break;
-		case 0x0100 ... 0x01FF:
-			this->_map.Page1.write(addr - 0x0100, data);
-			break;
-		case 0x0200 ... 0xFFBF:
-			this->_map.Memory.write(addr - 0x200, data);
-			break;
 		case 0xFFC0 ... 0xFFFF:
-			this->_map.IPL.write(addr - 0xFFC0, data);
+			this->_map.IPL[addr - 0xFFC0] = data;
 			break;
 		default:
 			throw InvalidAddress("APU Registers write", addr);
@@ -128,6 +138,7 @@ namespace ComSquare::APU
 
 	uint8_t APU::read(uint24_t addr)
 	{
+		this->sync();
 		switch (addr) {
 		case 0x00:
 			return this->_registers.port0;
@@ -144,6 +155,9 @@ namespace ComSquare::APU
 
 	void APU::write(uint24_t addr, uint8_t data)
 	{
+		this->sync();
+		// The SPC700 may be waiting for this write.
+		this->_isWaitingForPort = false;
 		switch (addr) {
 		case 0x00:
 			this->_registers.port0 = data;
@@ -175,653 +189,945 @@ namespace ComSquare::APU
 		this->_registers.port3 = 0x00;
 
 		this->_paddingCycles = 0;
+		this->_timestamp = this->_scheduler.getTimestamp();
+		this->_masterRemainder = 0;
+		this->_cycles = 0;
+		this->_dspCycles = 0;
+		this->_timersCycles = 0;
+		this->_timerStages = {};
+		this->_idleLoopStart = -1;
+		this->_isIdling = false;
+		this->_isWaitingForPort = false;
 		this->_internalRegisters.ya = 0x0000;
 		this->_internalRegisters.x = 0x00;
 		this->_internalRegisters.sp = 0xEF;
 		this->_internalRegisters.pc = 0xFFC0;
 	}
 
+	void APU::setMuted(bool muted)
+	{
+		this->_dsp.isMuted = muted;
+	}
+
+	const DSP::DSP &APU::getDSP() const
+	{
+		return this->_dsp;
+	}
+
+	void APU::saveState(SaveState::SaveState &state) const
+	{
+		if (this->_timestamp != this->_scheduler.getTimestamp())
+			throw InvalidAction("The APU should be synced before saving its state.");
+		state.write(this->_registers);
+		state.write(this->_internalRegisters);
+		state.write(this->_state);
+		state.write(this->_paddingCycles);
+		state.write(this->_timestamp);
+		state.write(this->_masterRemainder);
+		state.write(this->_cycles);
+		state.write(this->_dspCycles);
+		state.write(this->_timerStages);
+		state.write(this->_timersCycles);
+		this->_map.ram.saveState(state);
+		this->_dsp.saveState(state);
+	}
+
+	void APU::loadState(SaveState::SaveState &state)
+	{
+		state.read(this->_registers);
+		state.read(this->_internalRegisters);
+		state.read(this->_state);
+		state.read(this->_paddingCycles);
+		state.read(this->_timestamp);
+		state.read(this->_masterRemainder);
+		state.read(this->_cycles);
+		state.read(this->_dspCycles);
+		state.read(this->_timerStages);
+		state.read(this->_timersCycles);
+		this->_map.ram.loadState(state);
+		this->_dsp.loadState(state);
+		this->_idleLoopStart = -1;
+		this->_isIdling = false;
+		this->_isWaitingForPort = false;
+	}
+
+	template<bool directPage>
+	constexpr APU::DispatchTable APU::_makeDispatchTable()
+	{
+		return {
+			// 0x00
+			[](APU &apu) { return apu.NOP(); },
+			// 0x01
+			[](APU &apu) { return apu.TCALL(0); },
+			// 0x02
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 0); },
+			// 0x03
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBS(addr, offset, 0);
+			},
+			// 0x04
+			[](APU &apu) { return apu.ORacc(apu._getDirectAddr<directPage>(), 3); },
+			// 0x05
+			[](APU &apu) { return apu.ORacc(apu._getAbsoluteAddr(), 4); },
+			// 0x06
+			[](APU &apu) { return apu.ORacc(apu._getIndexXAddr<directPage>(), 3); },
+			// 0x07
+			[](APU &apu) { return apu.ORacc(apu._getAbsoluteDirectByXAddr<directPage>(), 6); },
+			// 0x08
+			[](APU &apu) { return apu.ORacc(apu._getImmediateData(), 2); },
+			// 0x09
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getDirectAddr<directPage>();
+				return apu.OR(ope1, ope2, 6);
+			},
+			// 0x0A
+			[](APU &apu) { return apu.OR1(apu._getAbsoluteBit()); },
+			// 0x0B
+			[](APU &apu) { return apu.ASL(apu._getDirectAddr<directPage>(), 4); },
+			// 0x0C
+			[](APU &apu) { return apu.ASL(apu._getAbsoluteAddr(), 5); },
+			// 0x0D
+			[](APU &apu) { return apu.PUSH(apu._internalRegisters.psw); },
+			// 0x0E
+			[](APU &apu) { return apu.TSET1(apu._getAbsoluteAddr()); },
+			// 0x0F
+			[](APU &apu) { return apu.BRK(); },
+			// 0x10
+			[](APU &apu) { return apu.BPL(apu._getImmediateData()); },
+			// 0x11
+			[](APU &apu) { return apu.TCALL(1); },
+			// 0x12
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 0); },
+			// 0x13
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.BBC(ope1, ope2, 0);
+			},
+			// 0x14
+			[](APU &apu) { return apu.ORacc(apu._getDirectAddrByX<directPage>(), 4); },
+			// 0x15
+			[](APU &apu) { return apu.ORacc(apu._getAbsoluteAddrByX(), 5); },
+			// 0x16
+			[](APU &apu) { return apu.ORacc(apu._getAbsoluteAddrByY(), 5); },
+			// 0x17
+			[](APU &apu) { return apu.ORacc(apu._getAbsoluteDirectAddrByY<directPage>(), 6); },
+			// 0x18
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.OR(ope1, ope2, 5);
+			},
+			// 0x19
+			[](APU &apu) { return apu.OR(apu._getIndexXAddr<directPage>(), apu._getIndexYAddr<directPage>(), 5); },
+			// 0x1A
+			[](APU &apu) { return apu.DECW(apu._getDirectAddr<directPage>()); },
+			// 0x1B
+			[](APU &apu) { return apu.ASL(apu._getDirectAddrByX<directPage>(), 5); },
+			// 0x1C
+			[](APU &apu) { return apu.ASL(apu._internalRegisters.a, 2, true); },
+			// 0x1D
+			[](APU &apu) { return apu.DECreg(apu._internalRegisters.x); },
+			// 0x1E
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.x, apu._getAbsoluteAddr(), 4); },
+			// 0x1F
+			[](APU &apu) { return apu.JMP(apu._getAbsoluteByXAddr(), true); },
+			// 0x20
+			[](APU &apu) { return apu.CLRP(); },
+			// 0x21
+			[](APU &apu) { return apu.TCALL(2); },
+			// 0x22
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 1); },
+			// 0x23
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.BBS(ope1, ope2, 1);
+			},
+			// 0x24
+			[](APU &apu) { return apu.ANDacc(apu._getDirectAddr<directPage>(), 3); },
+			// 0x25
+			[](APU &apu) { return apu.ANDacc(apu._getAbsoluteAddr(), 4); },
+			// 0x26
+			[](APU &apu) { return apu.ANDacc(apu._getIndexXAddr<directPage>(), 3); },
+			// 0x27
+			[](APU &apu) { return apu.ANDacc(apu._getAbsoluteDirectByXAddr<directPage>(), 6); },
+			// 0x28
+			[](APU &apu) { return apu.ANDacc(apu._getImmediateData(), 2); },
+			// 0x29
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getDirectAddr<directPage>();
+				return apu.AND(ope1, ope2, 6);
+			},
+			// 0x2A
+			[](APU &apu) { return apu.OR1(apu._getAbsoluteBit(), true); },
+			// 0x2B
+			[](APU &apu) { return apu.ROL(apu._getDirectAddr<directPage>(), 4); },
+			// 0x2C
+			[](APU &apu) { return apu.ROL(apu._getAbsoluteAddr(), 5); },
+			// 0x2D
+			[](APU &apu) { return apu.PUSH(apu._internalRegisters.a); },
+			// 0x2E
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.CBNE(addr, offset);
+			},
+			// 0x2F
+			[](APU &apu) { return apu.BRA(apu._getImmediateData()); },
+			// 0x30
+			[](APU &apu) { return apu.BMI(apu._getImmediateData()); },
+			// 0x31
+			[](APU &apu) { return apu.TCALL(3); },
+			// 0x32
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 1); },
+			// 0x33
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBC(addr, offset, 1);
+			},
+			// 0x34
+			[](APU &apu) { return apu.ANDacc(apu._getDirectAddrByX<directPage>(), 4); },
+			// 0x35
+			[](APU &apu) { return apu.ANDacc(apu._getAbsoluteAddrByX(), 5); },
+			// 0x36
+			[](APU &apu) { return apu.ANDacc(apu._getAbsoluteAddrByY(), 5); },
+			// 0x37
+			[](APU &apu) { return apu.ANDacc(apu._getAbsoluteDirectAddrByY<directPage>(), 6); },
+			// 0x38
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.AND(ope1, ope2, 5);
+			},
+			// 0x39
+			[](APU &apu) { return apu.AND(apu._getIndexXAddr<directPage>(), apu._getIndexYAddr<directPage>(), 5); },
+			// 0x3A
+			[](APU &apu) { return apu.INCW(apu._getDirectAddr<directPage>()); },
+			// 0x3B
+			[](APU &apu) { return apu.ROL(apu._getAbsoluteAddrByX(), 5); },
+			// 0x3C
+			[](APU &apu) { return apu.ROL(apu._internalRegisters.a, 2, true); },
+			// 0x3D
+			[](APU &apu) { return apu.INCreg(apu._internalRegisters.x); },
+			// 0x3E
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.x, apu._getDirectAddr<directPage>(), 3); },
+			// 0x3F
+			[](APU &apu) { return apu.CALL(apu._getAbsoluteAddr()); },
+			// 0x40
+			[](APU &apu) { return apu.SETP(); },
+			// 0x41
+			[](APU &apu) { return apu.TCALL(4); },
+			// 0x42
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 2); },
+			// 0x43
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBS(addr, offset, 2);
+			},
+			// 0x44
+			[](APU &apu) { return apu.EORacc(apu._getDirectAddr<directPage>(), 3); },
+			// 0x45
+			[](APU &apu) { return apu.EORacc(apu._getAbsoluteAddr(), 4); },
+			// 0x46
+			[](APU &apu) { return apu.EORacc(apu._getIndexXAddr<directPage>(), 3); },
+			// 0x47
+			[](APU &apu) { return apu.EORacc(apu._getAbsoluteDirectByXAddr<directPage>(), 6); },
+			// 0x48
+			[](APU &apu) { return apu.EORacc(apu._getImmediateData(), 2); },
+			// 0x49
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getDirectAddr<directPage>();
+				return apu.EOR(ope1, ope2, 6);
+			},
+			// 0x4A
+			[](APU &apu) { return apu.AND1(apu._getAbsoluteBit()); },
+			// 0x4B
+			[](APU &apu) { return apu.LSR(apu._getDirectAddr<directPage>(), 4); },
+			// 0x4C
+			[](APU &apu) { return apu.LSR(apu._getAbsoluteAddr(), 5); },
+			// 0x4D
+			[](APU &apu) { return apu.PUSH(apu._internalRegisters.x); },
+			// 0x4E
+			[](APU &apu) { return apu.TCLR1(apu._getAbsoluteAddr()); },
+			// 0x4F
+			[](APU &apu) { return apu.PCALL(); },
+			// 0x50
+			[](APU &apu) { return apu.BVC(apu._getImmediateData()); },
+			// 0x51
+			[](APU &apu) { return apu.TCALL(5); },
+			// 0x52
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 2); },
+			// 0x53
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBC(addr, offset, 2);
+			},
+			// 0x54
+			[](APU &apu) { return apu.EORacc(apu._getDirectAddrByX<directPage>(), 4); },
+			// 0x55
+			[](APU &apu) { return apu.EORacc(apu._getAbsoluteAddrByX(), 5); },
+			// 0x56
+			[](APU &apu) { return apu.EORacc(apu._getAbsoluteAddrByY(), 5); },
+			// 0x57
+			[](APU &apu) { return apu.EORacc(apu._getAbsoluteDirectAddrByY<directPage>(), 6); },
+			// 0x58
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.EOR(ope1, ope2, 5);
+			},
+			// 0x59
+			[](APU &apu) { return apu.EOR(apu._getIndexXAddr<directPage>(), apu._getIndexYAddr<directPage>(), 5); },
+			// 0x5A
+			[](APU &apu) { return apu.CMPW(apu._getDirectAddr<directPage>()); },
+			// 0x5B
+			[](APU &apu) { return apu.LSR(apu._getDirectAddrByX<directPage>(), 5); },
+			// 0x5C
+			[](APU &apu) { return apu.LSR(apu._internalRegisters.a, 2, true); },
+			// 0x5D
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._internalRegisters.x); },
+			// 0x5E
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.y, apu._getAbsoluteAddr(), 4); },
+			// 0x5F
+			[](APU &apu) { return apu.JMP(apu._getAbsoluteAddr()); },
+			// 0x60
+			[](APU &apu) { return apu.CLRC(); },
+			// 0x61
+			[](APU &apu) { return apu.TCALL(6); },
+			// 0x62
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 3); },
+			// 0x63
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBS(addr, offset, 3);
+			},
+			// 0x64
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getDirectAddr<directPage>(), 3); },
+			// 0x65
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getAbsoluteAddr(), 4); },
+			// 0x66
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getIndexXAddr<directPage>(), 3); },
+			// 0x67
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getAbsoluteDirectByXAddr<directPage>(), 6); },
+			// 0x68
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getImmediateData(), 2); },
+			// 0x69
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getDirectAddr<directPage>();
+				return apu.CMP(ope1, ope2, 6);
+			},
+			// 0x6A
+			[](APU &apu) { return apu.AND1(apu._getAbsoluteBit(), true); },
+			// 0x6B
+			[](APU &apu) { return apu.ROR(apu._getDirectAddr<directPage>(), 4); },
+			// 0x6C
+			[](APU &apu) { return apu.ROR(apu._getAbsoluteAddr(), 5); },
+			// 0x6D
+			[](APU &apu) { return apu.PUSH(apu._internalRegisters.y); },
+			// 0x6E
+			[](APU &apu) { return apu.DBNZ(apu._getImmediateData(), true); },
+			// 0x6F
+			[](APU &apu) { return apu.RET(); },
+			// 0x70
+			[](APU &apu) { return apu.BVS(apu._getImmediateData()); },
+			// 0x71
+			[](APU &apu) { return apu.TCALL(7); },
+			// 0x72
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 3); },
+			// 0x73
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBC(addr, offset, 3);
+			},
+			// 0x74
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getDirectAddrByX<directPage>(), 4); },
+			// 0x75
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getAbsoluteAddrByX(), 5); },
+			// 0x76
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getAbsoluteAddrByY(), 5); },
+			// 0x77
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.a, apu._getAbsoluteDirectAddrByY<directPage>(), 6); },
+			// 0x78
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.CMP(ope1, ope2, 5);
+			},
+			// 0x79
+			[](APU &apu) { return apu.CMP(apu._getIndexXAddr<directPage>(), apu._getIndexYAddr<directPage>(), 5); },
+			// 0x7A
+			[](APU &apu) { return apu.ADDW(apu._getDirectAddr<directPage>()); },
+			// 0x7B
+			[](APU &apu) { return apu.ROR(apu._getDirectAddrByX<directPage>(), 5); },
+			// 0x7C
+			[](APU &apu) { return apu.ROR(apu._internalRegisters.a, 2, true); },
+			// 0x7D
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._internalRegisters.a); },
+			// 0x7E
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.y, apu._getDirectAddr<directPage>(), 3); },
+			// 0x7F
+			[](APU &apu) { return apu.RETI(); },
+			// 0x80
+			[](APU &apu) { return apu.SETC(); },
+			// 0x81
+			[](APU &apu) { return apu.TCALL(8); },
+			// 0x82
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 4); },
+			// 0x83
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBS(addr, offset, 4);
+			},
+			// 0x84
+			[](APU &apu) { return apu.ADCacc(apu._getDirectAddr<directPage>(), 3); },
+			// 0x85
+			[](APU &apu) { return apu.ADCacc(apu._getAbsoluteAddr(), 5); },
+			// 0x86
+			[](APU &apu) { return apu.ADCacc(apu._getIndexXAddr<directPage>(), 3); },
+			// 0x87
+			[](APU &apu) { return apu.ADCacc(apu._getAbsoluteDirectByXAddr<directPage>(), 6); },
+			// 0x88
+			[](APU &apu) { return apu.ADCacc(apu._getImmediateData(), 2); },
+			// 0x89
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getDirectAddr<directPage>();
+				return apu.ADC(ope1, ope2, 6);
+			},
+			// 0x8A
+			[](APU &apu) { return apu.EOR1(apu._getAbsoluteBit()); },
+			// 0x8B
+			[](APU &apu) { return apu.DEC(apu._getDirectAddr<directPage>(), 4); },
+			// 0x8C
+			[](APU &apu) { return apu.DEC(apu._getAbsoluteAddr(), 5); },
+			// 0x8D
+			[](APU &apu) { return apu.MOV(apu._getImmediateData(), apu._internalRegisters.y, 2); },
+			// 0x8E
+			[](APU &apu) { return apu.POP(apu._internalRegisters.psw); },
+			// 0x8F
+			[](APU &apu) {
+				auto to = apu._getDirectAddr<directPage>();
+				auto from = apu._getImmediateData();
+				return apu.MOV(to, from);
+			},
+			// 0x90
+			[](APU &apu) { return apu.BCC(apu._getImmediateData()); },
+			// 0x91
+			[](APU &apu) { return apu.TCALL(9); },
+			// 0x92
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 4); },
+			// 0x93
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBC(addr, offset, 4);
+			},
+			// 0x94
+			[](APU &apu) { return apu.ADCacc(apu._getDirectAddrByX<directPage>(), 4); },
+			// 0x95
+			[](APU &apu) { return apu.ADCacc(apu._getAbsoluteAddrByX(), 5); },
+			// 0x96
+			[](APU &apu) { return apu.ADCacc(apu._getAbsoluteAddrByY(), 5); },
+			// 0x97
+			[](APU &apu) { return apu.ADCacc(apu._getAbsoluteDirectAddrByY<directPage>(), 6); },
+			// 0x98
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.ADC(ope1, ope2, 5);
+			},
+			// 0x99
+			[](APU &apu) { return apu.ADC(apu._getIndexXAddr<directPage>(), apu._getIndexYAddr<directPage>(), 3); },
+			// 0x9A
+			[](APU &apu) { return apu.SUBW(apu._getDirectAddr<directPage>()); },
+			// 0x9B
+			[](APU &apu) { return apu.DEC(apu._getDirectAddrByX<directPage>(), 5); },
+			// 0x9C
+			[](APU &apu) { return apu.DECreg(apu._internalRegisters.a); },
+			// 0x9D
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.sp, apu._internalRegisters.x); },
+			// 0x9E
+			[](APU &apu) { return apu.DIV(); },
+			// 0x9F
+			[](APU &apu) { return apu.XCN(); },
+			// 0xA0
+			[](APU &apu) { return apu.EI(); },
+			// 0xA1
+			[](APU &apu) { return apu.TCALL(10); },
+			// 0xA2
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 5); },
+			// 0xA3
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBS(addr, offset, 5);
+			},
+			// 0xA4
+			[](APU &apu) { return apu.SBCacc(apu._getDirectAddr<directPage>(), 3); },
+			// 0xA5
+			[](APU &apu) { return apu.SBCacc(apu._getAbsoluteAddr(), 4); },
+			// 0xA6
+			[](APU &apu) { return apu.SBCacc(apu._getIndexXAddr<directPage>(), 3); },
+			// 0xA7
+			[](APU &apu) { return apu.SBCacc(apu._getAbsoluteDirectByXAddr<directPage>(), 6); },
+			// 0xA8
+			[](APU &apu) { return apu.SBCacc(apu._getImmediateData(), 2); },
+			// 0xA9
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getDirectAddr<directPage>();
+				return apu.SBC(ope1, ope2, 6);
+			},
+			// 0xAA
+			[](APU &apu) { return apu.MOV1(apu._getAbsoluteBit(), true); },
+			// 0xAB
+			[](APU &apu) { return apu.INC(apu._getDirectAddr<directPage>(), 4); },
+			// 0xAC
+			[](APU &apu) { return apu.INC(apu._getAbsoluteAddr(), 5); },
+			// 0xAD
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.y, apu._getImmediateData(), 2); },
+			// 0xAE
+			[](APU &apu) { return apu.POP(apu._internalRegisters.a); },
+			// 0xAF
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getIndexXAddr<directPage>(), 4, true); },
+			// 0xB0
+			[](APU &apu) { return apu.BCS(apu._getImmediateData()); },
+			// 0xB1
+			[](APU &apu) { return apu.TCALL(11); },
+			// 0xB2
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 5); },
+			// 0xB3
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBC(addr, offset, 5);
+			},
+			// 0xB4
+			[](APU &apu) { return apu.SBCacc(apu._getDirectAddrByX<directPage>(), 4); },
+			// 0xB5
+			[](APU &apu) { return apu.SBCacc(apu._getAbsoluteAddrByX(), 5); },
+			// 0xB6
+			[](APU &apu) { return apu.SBCacc(apu._getAbsoluteAddrByY(), 5); },
+			// 0xB7
+			[](APU &apu) { return apu.SBCacc(apu._getAbsoluteDirectAddrByY<directPage>(), 6); },
+			// 0xB8
+			[](APU &apu) {
+				auto ope1 = apu._getDirectAddr<directPage>();
+				auto ope2 = apu._getImmediateData();
+				return apu.SBC(ope1, ope2, 5);
+			},
+			// 0xB9
+			[](APU &apu) { return apu.SBC(apu._getIndexXAddr<directPage>(), apu._getIndexYAddr<directPage>(), 5); },
+			// 0xBA
+			[](APU &apu) { return apu.MOVW(apu._getDirectAddr<directPage>(), true); },
+			// 0xBB
+			[](APU &apu) { return apu.INC(apu._getDirectAddrByX<directPage>(), 5); },
+			// 0xBC
+			[](APU &apu) { return apu.INCreg(apu._internalRegisters.a); },
+			// 0xBD
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._internalRegisters.sp, false); },
+			// 0xBE
+			[](APU &apu) { return apu.DAS(); },
+			// 0xBF
+			[](APU &apu) { return apu.MOV(apu._getIndexXAddr<directPage>(), apu._internalRegisters.a, 4, true); },
+			// 0xC0
+			[](APU &apu) { return apu.DI(); },
+			// 0xC1
+			[](APU &apu) { return apu.TCALL(12); },
+			// 0xC2
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 6); },
+			// 0xC3
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBS(addr, offset, 6);
+			},
+			// 0xC4
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getDirectAddr<directPage>(), 4); },
+			// 0xC5
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteAddr()); },
+			// 0xC6
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getIndexXAddr<directPage>(), 4); },
+			// 0xC7
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteDirectByXAddr<directPage>(), 7); },
+			// 0xC8
+			[](APU &apu) { return apu.CMPreg(apu._internalRegisters.x, apu._getImmediateData(), 2); },
+			// 0xC9
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._getAbsoluteAddr(), 5); },
+			// 0xCA
+			[](APU &apu) { return apu.MOV1(apu._getAbsoluteBit()); },
+			// 0xCB
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._getDirectAddr<directPage>(), 4); },
+			// 0xCC
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._getAbsoluteAddr(), 5); },
+			// 0xCD
+			[](APU &apu) { return apu.MOV(apu._getImmediateData(), apu._internalRegisters.x, 2); },
+			// 0xCE
+			[](APU &apu) { return apu.POP(apu._internalRegisters.x); },
+			// 0xCF
+			[](APU &apu) { return apu.MUL(); },
+			// 0xD0
+			[](APU &apu) { return apu.BNE(apu._getImmediateData()); },
+			// 0xD1
+			[](APU &apu) { return apu.TCALL(13); },
+			// 0xD2
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 6); },
+			// 0xD3
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBC(addr, offset, 6);
+			},
+			// 0xD4
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getDirectAddrByX<directPage>(), 5); },
+			// 0xD5
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteAddrByX(), 6); },
+			// 0xD6
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteAddrByY(), 6); },
+			// 0xD7
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteDirectAddrByY<directPage>(), 7); },
+			// 0xD8
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._getDirectAddr<directPage>(), 4); },
+			// 0xD9
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._getDirectAddrByY<directPage>(), 5); },
+			// 0xDA
+			[](APU &apu) { return apu.MOVW(apu._getDirectAddr<directPage>()); },
+			// 0xDB
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._getDirectAddrByX<directPage>(), 5); },
+			// 0xDC
+			[](APU &apu) { return apu.DECreg(apu._internalRegisters.y); },
+			// 0xDD
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._internalRegisters.a); },
+			// 0xDE
+			[](APU &apu) {
+				auto addr = apu._getDirectAddrByX<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.CBNE(addr, offset, true);
+			},
+			// 0xDF
+			[](APU &apu) { return apu.DAA(); },
+			// 0xE0
+			[](APU &apu) { return apu.CLRV(); },
+			// 0xE1
+			[](APU &apu) { return apu.TCALL(14); },
+			// 0xE2
+			[](APU &apu) { return apu.SET1(apu._getDirectAddr<directPage>(), 7); },
+			// 0xE3
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBS(addr, offset, 7);
+			},
+			// 0xE4
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._internalRead(apu._getDirectAddr<directPage>()), 3); },
+			// 0xE5
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteAddrByX(), 5); },
+			// 0xE6
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getIndexXAddr<directPage>(), 3); },
+			// 0xE7
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteDirectByXAddr<directPage>(), 6); },
+			// 0xE8
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getImmediateData(), 2); },
+			// 0xE9
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._getAbsoluteAddr(), 4); },
+			// 0xEA
+			[](APU &apu) { return apu.NOT1(apu._getAbsoluteBit()); },
+			// 0xEB
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._getDirectAddr<directPage>(), 3); },
+			// 0xEC
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._getAbsoluteAddr(), 4); },
+			// 0xED
+			[](APU &apu) { return apu.NOTC(); },
+			// 0xEE
+			[](APU &apu) { return apu.POP(apu._internalRegisters.y); },
+			// 0xEF
+			[](APU &apu) { return apu.SLEEP(); },
+			// 0xF0
+			[](APU &apu) { return apu.BEQ(apu._getImmediateData()); },
+			// 0xF1
+			[](APU &apu) { return apu.TCALL(15); },
+			// 0xF2
+			[](APU &apu) { return apu.CLR1(apu._getDirectAddr<directPage>(), 7); },
+			// 0xF3
+			[](APU &apu) {
+				auto addr = apu._getDirectAddr<directPage>();
+				auto offset = apu._getImmediateData();
+				return apu.BBC(addr, offset, 7);
+			},
+			// 0xF4
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._internalRead(apu._getDirectAddrByX<directPage>()), 4); },
+			// 0xF5
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._internalRead(apu._getAbsoluteAddrByX()), 5); },
+			// 0xF6
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteAddrByY(), 5); },
+			// 0xF7
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.a, apu._getAbsoluteDirectAddrByY<directPage>(), 6); },
+			// 0xF8
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._getDirectAddr<directPage>(), 3); },
+			// 0xF9
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.x, apu._getDirectAddrByY<directPage>(), 4); },
+			// 0xFA
+			[](APU &apu) { return apu.MOV(apu._getDirectAddr<directPage>(), apu._getDirectAddr<directPage>()); },
+			// 0xFB
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._getDirectAddrByX<directPage>(), 4); },
+			// 0xFC
+			[](APU &apu) { return apu.INCreg(apu._internalRegisters.y); },
+			// 0xFD
+			[](APU &apu) { return apu.MOV(apu._internalRegisters.y, apu._internalRegisters.a); },
+			// 0xFE
+			[](APU &apu) { return apu.DBNZ(apu._getImmediateData()); },
+			// 0xFF
+			[](APU &apu) { return apu.STOP(); },
+		};
+	}
+
+	constexpr std::array<APU::DispatchTable, 2> APU::_dispatchTables = {
+		_makeDispatchTable<false>(),
+		_makeDispatchTable<true>(),
+	};
+
 	int APU::_executeInstruction()
 	{
 		uint8_t opcode = this->_getImmediateData();
 
-		switch (opcode) {
-		case 0x00:
-			return this->NOP();
-		case 0x01:
-			return this->TCALL(0);
-		case 0x02:
-			return this->SET1(this->_getDirectAddr(), 0);
-		case 0x03: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBS(addr, offset, 0);
-		}
-		case 0x04:
-			return this->ORacc(this->_getDirectAddr(), 3);
-		case 0x05:
-			return this->ORacc(this->_getAbsoluteAddr(), 4);
-		case 0x06:
-			return this->ORacc(this->_getIndexXAddr(), 3);
-		case 0x07:
-			return this->ORacc(this->_getAbsoluteDirectByXAddr(), 6);
-		case 0x08:
-			return this->ORacc(this->_getImmediateData(), 2);
-		case 0x09: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getDirectAddr();
-			return this->OR(ope1, ope2, 6);
-		}
-		case 0x0A:
-			return this->OR1(this->_getAbsoluteBit());
-		case 0x0B:
-			return this->ASL(this->_getDirectAddr(), 4);
-		case 0x0C:
-			return this->ASL(this->_getAbsoluteAddr(), 5);
-		case 0x0D:
-			return this->PUSH(this->_internalRegisters.psw);
-		case 0x0E:
-			return this->TSET1(this->_getAbsoluteAddr());
-		case 0x0F:
-			return this->BRK();
-		case 0x10:
-			return this->BPL(this->_getImmediateData());
-		case 0x11:
-			return this->TCALL(1);
-		case 0x12:
-			return this->CLR1(this->_getDirectAddr(), 0);
-		case 0x13: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->BBC(ope1, ope2, 0);
-		}
-		case 0x14:
-			return this->ORacc(this->_getDirectAddrByX(), 4);
-		case 0x15:
-			return this->ORacc(this->_getAbsoluteAddrByX(), 5);
-		case 0x16:
-			return this->ORacc(this->_getAbsoluteAddrByY(), 5);
-		case 0x17:
-			return this->ORacc(this->_getAbsoluteDirectAddrByY(), 6);
-		case 0x18: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->OR(ope1, ope2, 5);
-		}
-		case 0x19:
-			return this->OR(this->_getIndexXAddr(), this->_getIndexYAddr(), 5);
-		case 0x1A:
-			return this->DECW(this->_getDirectAddr());
-		case 0x1B:
-			return this->ASL(this->_getDirectAddrByX(), 5);
-		case 0x1C:
-			return this->ASL(this->_internalRegisters.a, 2, true);
-		case 0x1D:
-			return this->DECreg(this->_internalRegisters.x);
-		case 0x1E:
-			return this->CMPreg(this->_internalRegisters.x, this->_getAbsoluteAddr(), 4);
-		case 0x1F:
-			return this->JMP(this->_getAbsoluteByXAddr(), true);
-		case 0x20:
-			return this->CLRP();
-		case 0x21:
-			return this->TCALL(2);
-		case 0x22:
-			return this->SET1(this->_getDirectAddr(), 1);
-		case 0x23: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->BBS(ope1, ope2, 1);
-		}
-		case 0x24:
-			return this->ANDacc(this->_getDirectAddr(), 3);
-		case 0x25:
-			return this->ANDacc(this->_getAbsoluteAddr(), 4);
-		case 0x26:
-			return this->ANDacc(this->_getIndexXAddr(), 3);
-		case 0x27:
-			return this->ANDacc(this->_getAbsoluteDirectByXAddr(), 6);
-		case 0x28:
-			return this->ANDacc(this->_getImmediateData(), 2);
-		case 0x29: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getDirectAddr();
-			return this->AND(ope1, ope2, 6);
-		}
-		case 0x2A:
-			return this->OR1(this->_getAbsoluteBit(), true);
-		case 0x2B:
-			return this->ROL(this->_getDirectAddr(), 4);
-		case 0x2C:
-			return this->ROL(this->_getAbsoluteAddr(), 5);
-		case 0x2D:
-			return this->PUSH(this->_internalRegisters.a);
-		case 0x2E: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->CBNE(addr, offset);
-		}
-		case 0x2F:
-			return this->BRA(this->_getImmediateData());
-		case 0x30:
-			return this->BMI(this->_getImmediateData());
-		case 0x31:
-			return this->TCALL(3);
-		case 0x32:
-			return this->CLR1(this->_getDirectAddr(), 1);
-		case 0x33: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBC(addr, offset, 1);
-		}
-		case 0x34:
-			return this->ANDacc(this->_getDirectAddrByX(), 4);
-		case 0x35:
-			return this->ANDacc(this->_getAbsoluteAddrByX(), 5);
-		case 0x36:
-			return this->ANDacc(this->_getAbsoluteAddrByY(), 5);
-		case 0x37:
-			return this->ANDacc(this->_getAbsoluteDirectAddrByY(), 6);
-		case 0x38: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->AND(ope1, ope2, 5);
-		}
-		case 0x39:
-			return this->AND(this->_getIndexXAddr(), this->_getIndexYAddr(), 5);
-		case 0x3A:
-			return this->INCW(this->_getDirectAddr());
-		case 0x3B:
-			return this->ROL(this->_getAbsoluteAddrByX(), 5);
-		case 0x3C:
-			return this->ROL(this->_internalRegisters.a, 2, true);
-		case 0x3D:
-			return this->INCreg(this->_internalRegisters.x);
-		case 0x3E:
-			return this->CMPreg(this->_internalRegisters.x, this->_getDirectAddr(), 3);
-		case 0x3F:
-			return this->CALL(this->_getAbsoluteAddr());
-		case 0x40:
-			return this->SETP();
-		case 0x41:
-			return this->TCALL(4);
-		case 0x42:
-			return this->SET1(this->_getDirectAddr(), 2);
-		case 0x43: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBS(addr, offset, 2);
-		}
-		case 0x44:
-			return this->EORacc(this->_getDirectAddr(), 3);
-		case 0x45:
-			return this->EORacc(this->_getAbsoluteAddr(), 4);
-		case 0x46:
-			return this->EORacc(this->_getIndexXAddr(), 3);
-		case 0x47:
-			return this->EORacc(this->_getAbsoluteDirectByXAddr(), 6);
-		case 0x48:
-			return this->EORacc(this->_getImmediateData(), 2);
-		case 0x49: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getDirectAddr();
-			return this->EOR(ope1, ope2, 6);
-		}
-		case 0x4A:
-			return this->AND1(this->_getAbsoluteBit());
-		case 0x4B:
-			return this->LSR(this->_getDirectAddr(), 4);
-		case 0x4C:
-			return this->LSR(this->_getAbsoluteAddr(), 5);
-		case 0x4D:
-			return this->PUSH(this->_internalRegisters.x);
-		case 0x4E:
-			return this->TCLR1(this->_getAbsoluteAddr());
-		case 0x4F:
-			return this->PCALL();
-		case 0x50:
-			return this->BVC(this->_getImmediateData());
-		case 0x51:
-			return this->TCALL(5);
-		case 0x52:
-			return this->CLR1(this->_getDirectAddr(), 2);
-		case 0x53: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBC(addr, offset, 2);
-		}
-		case 0x54:
-			return this->EORacc(this->_getDirectAddrByX(), 4);
-		case 0x55:
-			return this->EORacc(this->_getAbsoluteAddrByX(), 5);
-		case 0x56:
-			return this->EORacc(this->_getAbsoluteAddrByY(), 5);
-		case 0x57:
-			return this->EORacc(this->_getAbsoluteDirectAddrByY(), 6);
-		case 0x58: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->EOR(ope1, ope2, 5);
-		}
-		case 0x59:
-			return this->EOR(this->_getIndexXAddr(), this->_getIndexYAddr(), 5);
-		case 0x5A:
-			return this->CMPW(this->_getDirectAddr());
-		case 0x5B:
-			return this->LSR(this->_getDirectAddrByX(), 5);
-		case 0x5C:
-			return this->LSR(this->_internalRegisters.a, 2, true);
-		case 0x5D:
-			return this->MOV(this->_internalRegisters.a, this->_internalRegisters.x);
-		case 0x5E:
-			return this->CMPreg(this->_internalRegisters.y, this->_getAbsoluteAddr(), 4);
-		case 0x5F:
-			return this->JMP(this->_getAbsoluteAddr());
-		case 0x60:
-			return this->CLRC();
-		case 0x61:
-			return this->TCALL(6);
-		case 0x62:
-			return this->SET1(this->_getDirectAddr(), 3);
-		case 0x63: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBS(addr, offset, 3);
-		}
-		case 0x64:
-			return this->CMPreg(this->_internalRegisters.a, this->_getDirectAddr(), 3);
-		case 0x65:
-			return this->CMPreg(this->_internalRegisters.a, this->_getAbsoluteAddr(), 4);
-		case 0x66:
-			return this->CMPreg(this->_internalRegisters.a, this->_getIndexXAddr(), 3);
-		case 0x67:
-			return this->CMPreg(this->_internalRegisters.a, this->_getAbsoluteDirectByXAddr(), 6);
-		case 0x68:
-			return this->CMPreg(this->_internalRegisters.a, this->_getImmediateData(), 2);
-		case 0x69: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getDirectAddr();
-			return this->CMP(ope1, ope2, 6);
-		}
-		case 0x6A:
-			return this->AND1(this->_getAbsoluteBit(), true);
-		case 0x6B:
-			return this->ROR(this->_getDirectAddr(), 4);
-		case 0x6C:
-			return this->ROR(this->_getAbsoluteAddr(), 5);
-		case 0x6D:
-			return this->PUSH(this->_internalRegisters.y);
-		case 0x6E:
-			return this->DBNZ(this->_getImmediateData(), true);
-		case 0x6F:
-			return this->RET();
-		case 0x70:
-			return this->BVS(this->_getImmediateData());
-		case 0x71:
-			return this->TCALL(7);
-		case 0x72:
-			return this->CLR1(this->_getDirectAddr(), 3);
-		case 0x73: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBC(addr, offset, 3);
-		}
-		case 0x74:
-			return this->CMPreg(this->_internalRegisters.a, this->_getDirectAddrByX(), 4);
-		case 0x75:
-			return this->CMPreg(this->_internalRegisters.a, this->_getAbsoluteAddrByX(), 5);
-		case 0x76:
-			return this->CMPreg(this->_internalRegisters.a, this->_getAbsoluteAddrByY(), 5);
-		case 0x77:
-			return this->CMPreg(this->_internalRegisters.a, this->_getAbsoluteDirectAddrByY(), 6);
-		case 0x78: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->CMP(ope1, ope2, 5);
-		}
-		case 0x79:
-			return this->CMP(this->_getIndexXAddr(), this->_getIndexYAddr(), 5);
-		case 0x7A:
-			return this->ADDW(this->_getDirectAddr());
-		case 0x7B:
-			return this->ROR(this->_getDirectAddrByX(), 5);
-		case 0x7C:
-			return this->ROR(this->_internalRegisters.a, 2, true);
-		case 0x7D:
-			return this->MOV(this->_internalRegisters.x, this->_internalRegisters.a);
-		case 0x7E:
-			return this->CMPreg(this->_internalRegisters.y, this->_getDirectAddr(), 3);
-		case 0x7F:
-			return this->RETI();
-		case 0x80:
-			return this->SETC();
-		case 0x81:
-			return this->TCALL(8);
-		case 0x82:
-			return this->SET1(this->_getDirectAddr(), 4);
-		case 0x83: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBS(addr, offset, 4);
-		}
-		case 0x84:
-			return this->ADCacc(this->_getDirectAddr(), 3);
-		case 0x85:
-			return this->ADCacc(this->_getAbsoluteAddr(), 5);
-		case 0x86:
-			return this->ADCacc(this->_getIndexXAddr(), 3);
-		case 0x87:
-			return this->ADCacc(this->_getAbsoluteDirectByXAddr(), 6);
-		case 0x88:
-			return this->ADCacc(this->_getImmediateData(), 2);
-		case 0x89: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getDirectAddr();
-			return this->ADC(ope1, ope2, 6);
-		}
-		case 0x8A:
-			return this->EOR1(this->_getAbsoluteBit());
-		case 0x8B:
-			return this->DEC(this->_getDirectAddr(), 4);
-		case 0x8C:
-			return this->DEC(this->_getAbsoluteAddr(), 5);
-		case 0x8D:
-			return this->MOV(this->_getImmediateData(), this->_internalRegisters.y, 2);
-		case 0x8E:
-			return this->POP(this->_internalRegisters.psw);
-		case 0x8F: {
-			auto to = this->_getDirectAddr();
-			auto from = this->_getImmediateData();
-			return this->MOV(to, from);
-		}
-		case 0x90:
-			return this->BCC(this->_getImmediateData());
-		case 0x91:
-			return this->TCALL(9);
-		case 0x92:
-			return this->CLR1(this->_getDirectAddr(), 4);
-		case 0x93: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBC(addr, offset, 4);
-		}
-		case 0x94:
-			return this->ADCacc(this->_getDirectAddrByX(), 4);
-		case 0x95:
-			return this->ADCacc(this->_getAbsoluteAddrByX(), 5);
-		case 0x96:
-			return this->ADCacc(this->_getAbsoluteAddrByY(), 5);
-		case 0x97:
-			return this->ADCacc(this->_getAbsoluteDirectAddrByY(), 6);
-		case 0x98: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->ADC(ope1, ope2, 5);
-		}
-		case 0x99:
-			return this->ADC(this->_getIndexXAddr(), this->_getIndexYAddr(), 3);
-		case 0x9A:
-			return this->SUBW(this->_getDirectAddr());
-		case 0x9B:
-			return this->DEC(this->_getDirectAddrByX(), 5);
-		case 0x9C:
-			return this->DECreg(this->_internalRegisters.a);
-		case 0x9D:
-			return this->MOV(this->_internalRegisters.sp, this->_internalRegisters.x);
-		case 0x9E:
-			return this->DIV();
-		case 0x9F:
-			return this->XCN();
-		case 0xA0:
-			return this->EI();
-		case 0xA1:
-			return this->TCALL(10);
-		case 0xA2:
-			return this->SET1(this->_getDirectAddr(), 5);
-		case 0xA3: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBS(addr, offset, 5);
-		}
-		case 0xA4:
-			return this->SBCacc(this->_getDirectAddr(), 3);
-		case 0xA5:
-			return this->SBCacc(this->_getAbsoluteAddr(), 4);
-		case 0xA6:
-			return this->SBCacc(this->_getIndexXAddr(), 3);
-		case 0xA7:
-			return this->SBCacc(this->_getAbsoluteDirectByXAddr(), 6);
-		case 0xA8:
-			return this->SBCacc(this->_getImmediateData(), 2);
-		case 0xA9: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getDirectAddr();
-			return this->SBC(ope1, ope2, 6);
-		}
-		case 0xAA:
-			return this->MOV1(this->_getAbsoluteBit(), true);
-		case 0xAB:
-			return this->INC(this->_getDirectAddr(), 4);
-		case 0xAC:
-			return this->INC(this->_getAbsoluteAddr(), 5);
-		case 0xAD:
-			return this->CMPreg(this->_internalRegisters.y, this->_getImmediateData(), 2);
-		case 0xAE:
-			return this->POP(this->_internalRegisters.a);
-		case 0xAF:
-			return this->MOV(this->_internalRegisters.a, this->_getIndexXAddr(), 4, true);
-		case 0xB0:
-			return this->BCS(this->_getImmediateData());
-		case 0xB1:
-			return this->TCALL(11);
-		case 0xB2:
-			return this->CLR1(this->_getDirectAddr(), 5);
-		case 0xB3: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBC(addr, offset, 5);
-		}
-		case 0xB4:
-			return this->SBCacc(this->_getDirectAddrByX(), 4);
-		case 0xB5:
-			return this->SBCacc(this->_getAbsoluteAddrByX(), 5);
-		case 0xB6:
-			return this->SBCacc(this->_getAbsoluteAddrByY(), 5);
-		case 0xB7:
-			return this->SBCacc(this->_getAbsoluteDirectAddrByY(), 6);
-		case 0xB8: {
-			auto ope1 = this->_getDirectAddr();
-			auto ope2 = this->_getImmediateData();
-			return this->SBC(ope1, ope2, 5);
-		}
-		case 0xB9:
-			return this->SBC(this->_getIndexXAddr(), this->_getIndexYAddr(), 5);
-		case 0xBA:
-			return this->MOVW(this->_getDirectAddr(), true);
-		case 0xBB:
-			return this->INC(this->_getDirectAddrByX(), 5);
-		case 0xBC:
-			return this->INCreg(this->_internalRegisters.a);
-		case 0xBD:
-			return this->MOV(this->_internalRegisters.x, this->_internalRegisters.sp, false);
-		case 0xBE:
-			return this->DAS();
-		case 0xBF:
-			return this->MOV(this->_getIndexXAddr(), this->_internalRegisters.a, 4, true);
-		case 0xC0:
-			return this->DI();
-		case 0xC1:
-			return this->TCALL(12);
-		case 0xC2:
-			return this->SET1(this->_getDirectAddr(), 6);
-		case 0xC3: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBS(addr, offset, 6);
-		}
-		case 0xC4:
-			return this->MOV(this->_internalRegisters.a, this->_getDirectAddr(), 4);
-		case 0xC5:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteAddr());
-		case 0xC6:
-			return this->MOV(this->_internalRegisters.a, this->_getIndexXAddr(), 4);
-		case 0xC7:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteDirectByXAddr(), 7);
-		case 0xC8:
-			return this->CMPreg(this->_internalRegisters.x, this->_getImmediateData(), 2);
-		case 0xC9:
-			return this->MOV(this->_internalRegisters.x, this->_getAbsoluteAddr(), 5);
-		case 0xCA:
-			return this->MOV1(this->_getAbsoluteBit());
-		case 0xCB:
-			return this->MOV(this->_internalRegisters.y, this->_getDirectAddr(), 4);
-		case 0xCC:
-			return this->MOV(this->_internalRegisters.y, this->_getAbsoluteAddr(), 5);
-		case 0xCD:
-			return this->MOV(this->_getImmediateData(), this->_internalRegisters.x, 2);
-		case 0xCE:
-			return this->POP(this->_internalRegisters.x);
-		case 0xCF:
-			return this->MUL();
-		case 0xD0:
-			return this->BNE(this->_getImmediateData());
-		case 0xD1:
-			return this->TCALL(13);
-		case 0xD2:
-			return this->CLR1(this->_getDirectAddr(), 6);
-		case 0xD3: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBC(addr, offset, 6);
-		}
-		case 0xD4:
-			return this->MOV(this->_internalRegisters.a, this->_getDirectAddrByX(), 5);
-		case 0xD5:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteAddrByX(), 6);
-		case 0xD6:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteAddrByY(), 6);
-		case 0xD7:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteDirectAddrByY(), 7);
-		case 0xD8:
-			return this->MOV(this->_internalRegisters.x, this->_getDirectAddr(), 4);
-		case 0xD9:
-			return this->MOV(this->_internalRegisters.x, this->_getDirectAddrByY(), 5);
-		case 0xDA:
-			return this->MOVW(this->_getDirectAddr());
-		case 0xDB:
-			return this->MOV(this->_internalRegisters.y, this->_getDirectAddrByX(), 5);
-		case 0xDC:
-			return this->DECreg(this->_internalRegisters.y);
-		case 0xDD:
-			return this->MOV(this->_internalRegisters.y, this->_internalRegisters.a);
-		case 0xDE: {
-			auto addr = this->_getDirectAddrByX();
-			auto offset = this->_getImmediateData();
-			return this->CBNE(addr, offset, true);
-		}
-		case 0xDF:
-			return this->DAA();
-		case 0xE0:
-			return this->CLRV();
-		case 0xE1:
-			return this->TCALL(14);
-		case 0xE2:
-			return this->SET1(this->_getDirectAddr(), 7);
-		case 0xE3: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBS(addr, offset, 7);
-		}
-		case 0xE4:
-			return this->MOV(this->_internalRegisters.a, this->_internalRead(this->_getDirectAddr()), 3);
-		case 0xE5:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteAddrByX(), 5);
-		case 0xE6:
-			return this->MOV(this->_internalRegisters.a, this->_getIndexXAddr(), 3);
-		case 0xE7:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteDirectByXAddr(), 6);
-		case 0xE8:
-			return this->MOV(this->_internalRegisters.a, this->_getImmediateData(), 2);
-		case 0xE9:
-			return this->MOV(this->_internalRegisters.x, this->_getAbsoluteAddr(), 4);
-		case 0xEA:
-			return this->NOT1(this->_getAbsoluteBit());
-		case 0xEB:
-			return this->MOV(this->_internalRegisters.y, this->_getDirectAddr(), 3);
-		case 0xEC:
-			return this->MOV(this->_internalRegisters.y, this->_getAbsoluteAddr(), 4);
-		case 0xED:
-			return this->NOTC();
-		case 0xEE:
-			return this->POP(this->_internalRegisters.y);
-		case 0xEF:
-			return this->SLEEP();
-		case 0xF0:
-			return BEQ(this->_getImmediateData());
-		case 0xF1:
-			return this->TCALL(15);
-		case 0xF2:
-			return this->CLR1(this->_getDirectAddr(), 7);
-		case 0xF3: {
-			auto addr = this->_getDirectAddr();
-			auto offset = this->_getImmediateData();
-			return this->BBC(addr, offset, 7);
-		}
-		case 0xF4:
-			return this->MOV(this->_internalRegisters.a, this->_internalRead(this->_getDirectAddrByX()), 4);
-		case 0xF5:
-			return this->MOV(this->_internalRegisters.a, this->_internalRead(this->_getAbsoluteAddrByX()), 5);
-		case 0xF6:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteAddrByY(), 5);
-		case 0xF7:
-			return this->MOV(this->_internalRegisters.a, this->_getAbsoluteDirectAddrByY(), 6);
-		case 0xF8:
-			return this->MOV(this->_internalRegisters.x, this->_getDirectAddr(), 3);
-		case 0xF9:
-			return this->MOV(this->_internalRegisters.x, this->_getDirectAddrByY(), 4);
-		case 0xFA:
-			return this->MOV(this->_getDirectAddr(), this->_getDirectAddr());
-		case 0xFB:
-			return this->MOV(this->_internalRegisters.y, this->_getDirectAddrByX(), 4);
-		case 0xFC:
-			return this->INCreg(this->_internalRegisters.y);
-		case 0xFD:
-			return this->MOV(this->_internalRegisters.y, this->_internalRegisters.a);
-		case 0xFE:
-			return this->DBNZ(this->_getImmediateData());
-		case 0xFF:
-			return this->STOP();
-		default:
-			throw InvalidOpcode("APU", opcode);
-		}
+		return _dispatchTables[this->_internalRegisters.p][opcode](*this);
 	}
 
 	void APU::update(unsigned cycles)
+	{
+		this->_runSPC700(cycles);
+		this->_syncDSP();
+	}
+
+	void APU::_runSPC700(unsigned cycles)
 	{
 		if (this->isDisabled)
 			return;
 
-		unsigned total = 0;
-
 		if (this->_paddingCycles > cycles) {
 			this->_paddingCycles -= cycles;
 			return;
 		}
 		cycles -= this->_paddingCycles;
-		while (total < cycles && this->_state == Running)
-			total += this->_executeInstruction();
+		uint64_t end = this->_cycles + cycles;
+		if (this->_isWaitingForPort) {
+			// Only a write of the main CPU to a port can end the loop.
+			this->idleLoopStatistics.skippedCycles += cycles;
+			this->_paddingCycles = 0;
+			this->_cycles = end;
+			return;
+		}
+		while (this->_cycles < end && this->_state == Running) {
+			this->_cycles += this->_executeInstruction();
+			if (this->_isIdling) {
+				this->_isIdling = false;
+				this->idleLoopStatistics.skippedLoops++;
+				// A loop polling a counter only has to run again when the counter changes.
+				uint64_t wakeUp = end;
+				if (this->_idleLoopReadsCounter)
+					wakeUp = this->_cycles + std::min(this->_getCyclesUntilCounterIncrement(), end - this->_cycles);
+				if (this->_cycles < wakeUp) {
+					this->idleLoopStatistics.skippedCycles += wakeUp - this->_cycles;
+					this->_cycles = wakeUp;
+				}
+			}
+		}
 		if (this->_state == Running)
-			this->_paddingCycles = total - cycles;
+			this->_paddingCycles = this->_cycles - end;
+		else
+			// The timers keep running while the SPC700 sleeps.
+			this->_cycles = std::max(this->_cycles, end);
+	}
+
+	void APU::_syncDSP()
+	{
+		uint64_t samples = (this->_cycles - this->_dspCycles) / cyclesPerSample;
+
+		this->_dsp.renderSamples(samples);
+		this->_dspCycles += samples * cyclesPerSample;
+	}
+
+	void APU::sync()
+	{
+		uint64_t timestamp = this->_scheduler.getTimestamp();
 
-		this->_dsp.update();
+		if (timestamp == this->_timestamp)
+			return;
+		// The fraction of a cycle that did not elapse yet is kept for the next sync.
+		uint64_t elapsed = (timestamp - this->_timestamp) * clock + this->_masterRemainder;
+		this->_timestamp = timestamp;
+		this->_masterRemainder = elapsed % Scheduler::Scheduler::masterClock;
+		this->_runSPC700(elapsed / Scheduler::Scheduler::masterClock);
+		this->_syncDSP();
+	}
+
+	void APU::_detectIdleLoop(uint16_t loopEnd)
+	{
+		if (!this->isIdleLoopSkippingEnabled)
+			return;
+		const InternalRegisters &regs = this->_internalRegisters;
+		const InternalRegisters &last = this->_idleLoopRegisters;
+		if (this->_idleLoopStart == regs.pc
+		    && regs.ya == last.ya && regs.x == last.x && regs.sp == last.sp && regs.psw == last.psw) {
+			this->_isIdling = true;
+			// A loop reading a counter is woken up by the timers, see update.
+			this->_isWaitingForPort = !this->_idleLoopReadsCounter;
+			return;
+		}
+		bool readsCounter = false;
+		if (static_cast<uint16_t>(loopEnd - regs.pc) > _maxIdleLoopSize || !this->_isIdleLoopBody(loopEnd, readsCounter)) {
+			this->_idleLoopStart = -1;
+			return;
+		}
+		this->_idleLoopStart = regs.pc;
+		this->_idleLoopRegisters = regs;
+		this->_idleLoopReadsCounter = readsCounter;
+	}
+
+	bool APU::_isIdleLoopBody(uint16_t loopEnd, bool &readsCounter)
+	{
+		uint16_t loopStart = this->_internalRegisters.pc;
+		// The registers can't be read as code without side effects.
+		if (loopEnd > 0x00F0 && loopStart < 0x0100)
+			return false;
+
+		for (uint16_t pc = loopStart; pc < loopEnd;) {
+			uint8_t opcode = this->_internalRead(pc);
+			uint24_t operand = this->_internalRead(static_cast<uint16_t>(pc + 1));
+			int32_t readAddr = -1;
+			int branchOffset = 0;
+			unsigned size = 2;
+
+			switch (opcode) {
+			// NOP
+			case 0x00:
+				size = 1;
+				break;
+			// BPL, BMI, BVC, BVS, BCC, BCS, BNE, BEQ and BRA
+			case 0x10: case 0x30: case 0x50: case 0x70:
+			case 0x90: case 0xB0: case 0xD0: case 0xF0: case 0x2F:
+				branchOffset = static_cast<int8_t>(operand);
+				break;
+			// CMP A, dp - CMP X, dp - CMP Y, dp
+			case 0x64: case 0x3E: case 0x7E:
+				readAddr = operand + (this->_internalRegisters.p ? 0x100 : 0);
+				break;
+			// CMP A, !abs - CMP X, !abs - CMP Y, !abs
+			case 0x65: case 0x1E: case 0x5E:
+				readAddr = operand | this->_internalRead(static_cast<uint16_t>(pc + 2)) << 8;
+				size = 3;
+				break;
+			// CMP dp, #imm
+			case 0x78:
+				readAddr = operand + (this->_internalRegisters.p ? 0x100 : 0);
+				size = 3;
+				break;
+			// CBNE dp, rel - BBS dp.bit, rel - BBC dp.bit, rel
+			case 0x2E:
+			case 0x03: case 0x23: case 0x43: case 0x63: case 0x83: case 0xA3: case 0xC3: case 0xE3:
+			case 0x13: case 0x33: case 0x53: case 0x73: case 0x93: case 0xB3: case 0xD3: case 0xF3:
+				readAddr = operand + (this->_internalRegisters.p ? 0x100 : 0);
+				branchOffset = static_cast<int8_t>(this->_internalRead(static_cast<uint16_t>(pc + 2)));
+				size = 3;
+				break;
+			default:
+				return false;
+			}
+			if (readAddr >= 0) {
+				if (!_isStatusRegister(readAddr))
+					return false;
+				readsCounter |= readAddr >= 0xFD;
+			}
+			// Branches exiting the loop are fine but they should not jump to code that has not been checked.
+			if (static_cast<uint16_t>(pc + size + branchOffset) < loopStart)
+				return false;
+			pc += size;
+		}
+		return true;
+	}
+
+	void APU::_updateTimers()
+	{
+		this->_tickTimer(0, this->_registers.timer0, this->_registers.counter0);
+		this->_tickTimer(1, this->_registers.timer1, this->_registers.counter1);
+		this->_tickTimer(2, this->_registers.timer2, this->_registers.counter2);
+		this->_timersCycles = this->_cycles;
+	}
+
+	void APU::_tickTimer(unsigned timer, uint8_t target, uint8_t &counter)
+	{
+		unsigned period = _timerPeriods[timer];
+		// The dividers of the timers run all the time, a timer ticks each time the cycle counter crosses a multiple of its period.
+		uint64_t ticks = this->_cycles / period - this->_timersCycles / period;
+		if (!(this->_registers.ctrlreg & (1u << timer)) || ticks == 0)
+			return;
+
+		uint8_t &stage = this->_timerStages[timer];
+		unsigned untilTarget = _getTicksUntilTarget(target, stage);
+		if (ticks < untilTarget) {
+			stage += ticks;
+			return;
+		}
+		ticks -= untilTarget;
+		unsigned length = target ? target : 0x100;
+		counter = (counter + 1 + ticks / length) & 0x0Fu;
+		stage = ticks % length;
+	}
+
+	unsigned APU::_getTicksUntilTarget(uint8_t target, uint8_t stage)
+	{
+		// The internal counter wraps around if the target has been set below it.
+		return static_cast<uint8_t>(target - stage - 1) + 1u;
+	}
+
+	uint64_t APU::_getCyclesUntilCounterIncrement()
+	{
+		this->_updateTimers();
+		std::array<uint8_t, 3> targets = {this->_registers.timer0, this->_registers.timer1, this->_registers.timer2};
+		uint64_t cycles = UINT64_MAX;
+		for (unsigned i = 0; i < targets.size(); i++) {
+			if (!(this->_registers.ctrlreg & (1u << i)))
+				continue;
+			unsigned period = _timerPeriods[i];
+			uint64_t tick = this->_cycles / period + _getTicksUntilTarget(targets[i], this->_timerStages[i]);
+			cycles = std::min(cycles, tick * period - this->_cycles);
+		}
+		return cycles;
+	}
+
+	bool APU::_isStatusRegister(uint24_t addr)
+	{
+		switch (addr) {
+		// The ports, only written by the main CPU.
+		case 0xF4 ... 0xF7:
+		// The timer counters.
+		case 0xFD ... 0xFF:
+			return true;
+		default:
+			return false;
+		}
 	}
 
 	void APU::loadFromSPC(Cartridge::Cartridge &cartridge)
 	{
-		std::span<const uint8_t> data = cartridge.getData();
 		uint24_t size = cartridge.getSize();
 		if (size < 0x101C0)
 			throw InvalidAddress("Cartridge is not the right size", size);
+		std::vector<uint8_t> data(size);
+		cartridge.copyTo(0, data);
 
 		std::string song = std::string(reinterpret_cast<const char *>(data.data() + 0x2E), 0x20);
 		std::string game = std::string(reinterpret_cast<const char *>(data.data() + 0x4E), 0x20);
@@ -838,9 +1144,7 @@ namespace ComSquare::APU
 		this->_internalRegisters.psw = cartridge.read(0x2A);
 		this->_internalRegisters.sp = cartridge.read(0x2B);
 
-		std::copy_n(data.begin() + 0x100, this->_map.Page0.getSize(), this->_map.Page0.getData().begin());
-		std::copy_n(data.begin() + 0x200, this->_map.Page1.getSize(), this->_map.Page1.getData().begin());
-		std::copy_n(data.begin() + 0x300, this->_map.Memory.getSize(), this->_map.Memory.getData().begin());
+		std::copy_n(data.begin() + 0x100, this->_map.ram.size(), this->_map.ram.begin());
 
 		this->_registers.unknown = cartridge.read(0x100 + 0xF0);
 		this->_registers.ctrlreg = cartridge.read(0x100 + 0xF1);
@@ -894,9 +1198,6 @@ namespace ComSquare::APU
 	}
 
 	MemoryMap::MemoryMap()
-		: Page0(0x00F0, Apu, "APU's Page 0"),
-		  Page1(0x0100, Apu, "APU's Page 1"),
-		  Memory(0xFDC0, Apu, "APU's Ram"),
-		  IPL(Apu, "IPL Rom")
+		: IPL(Apu, "IPL Rom")
 	{}
 }// namespace ComSquare::APU
\ No newline at end of file
@@ -4,13 +4,15 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <vector>
 #include "DSP/DSP.hpp"
 #include "Memory/AMemory.hpp"
-#include "Ram/Ram.hpp"
 #include "IPL/IPL.hpp"
 #include "Renderer/IRenderer.hpp"
 #include "Cartridge/Cartridge.hpp"
+#include "Scheduler/Scheduler.hpp"
 
 #ifdef DEBUGGER_ENABLED
 #include "Debugger/APUDebug.hpp"
@@ -111,6 +113,15 @@ namespace ComSquare::APU
 
 	};
 
+	//! @brief Statistics about the idle loops skipped by the APU.
+	struct IdleLoopStatistics
+	{
+		//! @brief The number of times an idle loop has been detected.
+		uint64_t skippedLoops = 0;
+		//! @brief The number of SPC700 cycles that were not run because of idle loops.
+		uint64_t skippedCycles = 0;
+	};
+
 	enum StateMode
 	{
 		Running,
@@ -120,13 +131,10 @@ namespace ComSquare::APU
 
 	struct MemoryMap
 	{
-		//! @brief Zero page memory
-		Ram::Ram Page0;
-		//! @brief Stack space memory
-		Ram::Ram Page1;
-		//! @brief Any-use memory
-		Ram::Ram Memory;
-		//! @brief IPL ROM
+		//! @brief The whole 64 KiB of audio ram, indexed by the SPC700 address.
+		//! @info The registers ($F0 to $FF) and the IPL ROM hide the bytes under them from the SPC700 but not from the DSP.
+		ARam ram;
+		//! @brief IPL ROM, shown over the end of the ram
 		IPL::IPL IPL;
 
 		MemoryMap();
@@ -152,22 +160,100 @@ namespace ComSquare::APU
 		//! @param addr The address to read from. The address 0x0000 should refer to the first byte of the register.
 		//! @throw InvalidAddress will be thrown if the address is more than $FFFF (the number of register).
 		//! @return Return the data.
-		[[nodiscard]] uint8_t _internalRead(uint24_t addr) const;
+		[[nodiscard]] inline uint8_t _internalRead(uint24_t addr)
+		{
+			if (addr - 0xF0u < 0x10u || addr >= 0xFFC0) [[unlikely]]
+				return this->_readSpecial(addr);
+			return this->_map.ram.read(addr);
+		}
 
 		//! @brief Write data to the APU ram.
 		//! @param addr The address to write to. The address 0x0000 should refer to the first byte of register.
 		//! @param data The new value of the register.
 		//! @throw InvalidAddress will be thrown if the address is more than $FFFF (the number of register).
-		void _internalWrite(uint24_t addr, uint8_t data);
+		inline void _internalWrite(uint24_t addr, uint8_t data)
+		{
+			if (addr - 0xF0u < 0x10u || addr >= 0xFFC0) [[unlikely]]
+				this->_writeSpecial(addr, data);
+			else
+				this->_map.ram.write(addr, data);
+		}
+
+		//! @brief Read from the registers, the IPL ROM or an invalid address.
+		//! @throw InvalidAddress if the address is not a readable register or if it is more than $FFFF.
+		[[nodiscard]] uint8_t _readSpecial(uint24_t addr);
+		//! @brief Write to the registers, the IPL ROM or an invalid address.
+		//! @throw InvalidAddress if the address is more than $FFFF.
+		void _writeSpecial(uint24_t addr, uint8_t data);
 
 		//! @brief Current state of APU CPU
 		StateMode _state = Running;
 
 		//! @brief Keep the number of excess cycles executed to pad the next update
 		unsigned int _paddingCycles = 0;
+		//! @brief The master clock, the APU catches up with its timestamp on sync.
+		const Scheduler::Scheduler &_scheduler;
+		//! @brief The master cycle timestamp the APU has caught up with.
+		uint64_t _timestamp = 0;
+		//! @brief The fraction of a SPC700 cycle (in units of 1 / masterClock) left over by the last sync.
+		uint64_t _masterRemainder = 0;
+		//! @brief The number of cycles the SPC700 has run (or skipped) since the reset.
+		uint64_t _cycles = 0;
+		//! @brief The number of cycles of the SPC700 the DSP has rendered samples for.
+		uint64_t _dspCycles = 0;
+		//! @brief Run the SPC700 for some cycles. The DSP does not run, it is late by the cycles that elapsed.
+		void _runSPC700(unsigned cycles);
+		//! @brief Let the DSP catch up by rendering the whole samples it is late on (a sample every 32 cycles).
+		//! @info The DSP catches up when the SPC700 accesses its registers, so it sees the writes less than a sample late.
+		void _syncDSP();
+
+		//! @brief The number of cycles between two ticks of each timer (8 kHz for the first two, 64 kHz for the third one).
+		static constexpr std::array<unsigned, 3> _timerPeriods = {128, 128, 16};
+		//! @brief The internal counter of each timer, incremented every tick until it reaches the target of the timer.
+		std::array<uint8_t, 3> _timerStages = {};
+		//! @brief The value of _cycles when the timers were last brought up to date.
+		uint64_t _timersCycles = 0;
+		//! @brief Bring the timers up to date by computing the ticks that elapsed since the last call.
+		//! @info The timers are only updated when a counter is read or when a timer is reconfigured.
+		void _updateTimers();
+		//! @brief Apply the ticks of a timer that elapsed since the last update of the timers.
+		//! @param timer The index of the timer.
+		//! @param target The target of the timer ($FA-$FC, 0 means 256).
+		//! @param counter The 4 bit counter of the timer ($FD-$FF), incremented each time the target is reached.
+		void _tickTimer(unsigned timer, uint8_t target, uint8_t &counter);
+		//! @brief Get the number of ticks before the internal counter of a timer reaches its target.
+		static unsigned _getTicksUntilTarget(uint8_t target, uint8_t stage);
+		//! @brief Get the number of cycles before one of the enabled timers increments its counter.
+		//! @return The number of cycles, or UINT64_MAX if every timer is disabled.
+		uint64_t _getCyclesUntilCounterIncrement();
+
+		//! @brief The maximum size (in bytes) of a loop that can be detected as idle.
+		static constexpr unsigned _maxIdleLoopSize = 16;
+		//! @brief The address of the start of the last backward branch that may be an idle loop (or -1 if there is none).
+		int32_t _idleLoopStart = -1;
+		//! @brief The registers at the end of the last iteration of the possible idle loop.
+		InternalRegisters _idleLoopRegisters {};
+		//! @brief True if the possible idle loop reads a timer counter (else it only reads the ports).
+		bool _idleLoopReadsCounter = false;
+		//! @brief True if the current loop has been detected as idle and the remaining cycles of this update can be skipped.
+		bool _isIdling = false;
+		//! @brief True if the SPC700 sleeps in a loop polling the ports until the main CPU writes to one of them.
+		bool _isWaitingForPort = false;
+		//! @brief Check if the loop that just branched backward is an idle loop.
+		//! @param loopEnd The address after the instruction that branched backward.
+		//! @info A loop is idle if the same iteration ran twice in a row and it only reads the ports or the timer counters.
+		void _detectIdleLoop(uint16_t loopEnd);
+		//! @brief Check if every instruction between the program counter and loopEnd can be part of an idle loop.
+		//! @param readsCounter Set to true if one of the instructions reads a timer counter.
+		bool _isIdleLoopBody(uint16_t loopEnd, bool &readsCounter);
+		//! @brief Check if the address is a register that can only be changed by the main CPU or the timers.
+		static bool _isStatusRegister(uint24_t addr);
 
 		//! @brief Get value of the Pointer Counter
-		uint8_t _getImmediateData();
+		inline uint8_t _getImmediateData()
+		{
+			return this->_internalRead(this->_internalRegisters.pc++);
+		}
 		//! @brief Get direct page offset
 		uint24_t _getDirectAddr();
 		//! @brief Get Index X offset
@@ -193,6 +279,61 @@ namespace ComSquare::APU
 		//! @brief Get absolute offset and separate its bits
 		std::pair<uint24_t, uint24_t> _getAbsoluteBit();
 
+		//! @brief Versions of the addressing modes above specialized for the direct page flag (p).
+		//! @{
+		template<bool directPage>
+		inline uint24_t _getDirectAddr()
+		{
+			uint24_t addr = this->_getImmediateData();
+
+			if constexpr (directPage)
+				addr += 0x100;
+			return addr;
+		}
+		template<bool directPage>
+		inline uint24_t _getIndexXAddr()
+		{
+			return this->_internalRegisters.x + (directPage ? 0x100 : 0);
+		}
+		template<bool directPage>
+		inline uint24_t _getIndexYAddr()
+		{
+			return this->_internalRegisters.y + (directPage ? 0x100 : 0);
+		}
+		template<bool directPage>
+		inline uint24_t _getDirectAddrByX()
+		{
+			return this->_getDirectAddr<directPage>() + this->_internalRegisters.x;
+		}
+		template<bool directPage>
+		inline uint24_t _getDirectAddrByY()
+		{
+			return this->_getDirectAddr<directPage>() + this->_internalRegisters.y;
+		}
+		template<bool directPage>
+		inline uint24_t _getAbsoluteDirectByXAddr()
+		{
+			uint24_t directIndexX = this->_getDirectAddr<directPage>() + this->_internalRegisters.x;
+			uint24_t low = this->_internalRead(directIndexX++);
+
+			if constexpr (directPage)
+				directIndexX += 0x100;
+			uint24_t high = this->_internalRead(directIndexX);
+			return (high << 8u) | low;
+		}
+		template<bool directPage>
+		inline uint24_t _getAbsoluteDirectAddrByY()
+		{
+			uint24_t direct = this->_getDirectAddr<directPage>();
+			uint24_t low = this->_internalRead(direct++);
+
+			if constexpr (directPage)
+				direct += 0x100;
+			uint24_t high = this->_internalRead(direct);
+			return ((high << 8u) | low) + this->_internalRegisters.y;
+		}
+		//! @}
+
 		//! @brief Set Negative and Zero flags with value after an instruction
 		void _setNZflags(uint8_t value);
 
@@ -200,6 +341,16 @@ namespace ComSquare::APU
 		//! @return The number of cycles that the instruction took.
 		int _executeInstruction();
 
+		//! @brief The signature of an instruction handler: it reads its operands and returns the number of cycles it took.
+		using InstructionHandler = int (*)(APU &apu);
+		//! @brief A list of handlers indexed by opcode.
+		using DispatchTable = std::array<InstructionHandler, 0x100>;
+		//! @brief The dispatch tables for both values of the direct page flag (p), indexed by the flag.
+		static const std::array<DispatchTable, 2> _dispatchTables;
+		//! @brief Create the dispatch table of the given direct page flag (its addressing modes don't check the flag at runtime).
+		template<bool directPage>
+		static constexpr DispatchTable _makeDispatchTable();
+
 		//! @brief No Operation instruction, do nothing than delay
 		int NOP();
 		//! @brief Sleep instruction, halts the processor with SLEEP mode
@@ -365,7 +516,12 @@ namespace ComSquare::APU
 		int MOV(uint24_t memFrom, uint8_t &regTo, int cycles, bool incrementX = false);
 		int MOV(uint24_t memFrom, uint24_t memTo);
 	public:
-		explicit APU(Renderer::IRenderer &renderer);
+		//! @brief The frequency of the SPC700 in Hz.
+		static constexpr uint64_t clock = 1024000;
+		//! @brief The number of cycles of the SPC700 between two samples of the DSP (32 kHz).
+		static constexpr unsigned cyclesPerSample = 32;
+
+		APU(Renderer::IRenderer &renderer, const Scheduler::Scheduler &scheduler);
 		APU(const APU &) = delete;
 		APU &operator=(const APU &) = delete;
 		~APU() override = default;
@@ -373,6 +529,11 @@ namespace ComSquare::APU
 		//! @brief Is this APU disabled?
 		bool isDisabled = false;
 
+		//! @brief Set to false to run the idle loops of the SPC700 instead of skipping them.
+		bool isIdleLoopSkippingEnabled = true;
+		//! @brief Statistics about the idle loops skipped since the creation of this APU.
+		IdleLoopStatistics idleLoopStatistics;
+
 		//! @brief Read from the APU ram.
 		//! @param addr The address to read from. The address 0x0000 should refer to the first byte of the register.
 		//! @throw InvalidAddress will be thrown if the address is more than $FFFF (the number of register).
@@ -405,10 +566,24 @@ namespace ComSquare::APU
 		//! @brief This function execute the instructions received until the maximum number of cycles is reached.
 		//! @return The number of cycles that elapsed.
 		void update(unsigned cycles);
+		//! @brief Catch up with the master clock: run the SPC700 for the cycles elapsed since the last sync, then the DSP.
+		//! @info This is called when the main CPU accesses the ports and at the end of the frame, the APU is lazy otherwise.
+		void sync();
 
 		//! @brief This function is executed when the SNES is powered on or the reset button is pushed.
 		void reset();
 
+		//! @brief Discard the samples produced by the DSP instead of playing them.
+		void setMuted(bool muted);
+		//! @brief Get the DSP (to read the samples it produced).
+		[[nodiscard]] const DSP::DSP &getDSP() const;
+
+		//! @brief Write the registers, the ram and the DSP of the APU to a save state.
+		//! @throw InvalidAction if the APU has not caught up with the master clock (see sync).
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Restore the state of the APU from a save state. The idle loop detection starts over.
+		void loadState(SaveState::SaveState &state);
+
 #ifdef DEBUGGER_ENABLED
 		friend Debugger::APU::APUDebug;
 #endif
@@ -0,0 +1,77 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include <utility>
+#include "ARam.hpp"
+
+namespace ComSquare::APU
+{
+	uint8_t *ARam::begin()
+	{
+		this->_dirtyPages = _allPages;
+		return this->_data.data();
+	}
+
+	uint8_t *ARam::end()
+	{
+		return this->_data.data() + ramSize;
+	}
+
+	void ARam::copyFrom(uint16_t addr, std::span<const uint8_t> data)
+	{
+		if (data.empty())
+			return;
+		std::ranges::copy(data, this->_data.begin() + addr);
+		for (size_t page = addr / Ram::PagedBuffer::pageSize; page <= (addr + data.size() - 1) / Ram::PagedBuffer::pageSize; page++)
+			this->_dirtyPages |= 1u << page;
+	}
+
+	bool ARam::operator==(const ARam &other) const
+	{
+		return this->_data == other._data;
+	}
+
+	size_t ARam::getOwnedBytes() const
+	{
+		return sizeof(this->_data) + this->_pages.getOwnedBytes();
+	}
+
+	void ARam::saveState(SaveState::SaveState &state) const
+	{
+		if (!state.isSharingMemories()) {
+			state.write(this->_data);
+			return;
+		}
+		for (size_t page = 0; page < _pageCount; page++) {
+			if (!(this->_dirtyPages & 1u << page))
+				continue;
+			auto data = std::span(this->_data).subspan(page * Ram::PagedBuffer::pageSize, Ram::PagedBuffer::pageSize);
+			// A page written back with the same bytes stays shared.
+			if (!std::ranges::equal(data, std::as_const(this->_pages).getPage(page)))
+				this->_pages.copyFrom(page * Ram::PagedBuffer::pageSize, data);
+		}
+		this->_dirtyPages = 0;
+		state.shareMemory(this->_pages);
+	}
+
+	void ARam::loadState(SaveState::SaveState &state)
+	{
+		if (!state.isSharingMemories()) {
+			state.read(this->_data);
+			this->_dirtyPages = _allPages;
+			return;
+		}
+		const Ram::PagedBuffer &pages = state.readSharedMemory(ramSize);
+		for (size_t page = 0; page < _pageCount; page++) {
+			std::span<const uint8_t> data = pages.getPage(page);
+			// The flat array already holds the pages shared with the state that have not been written since.
+			if (!(this->_dirtyPages & 1u << page) && data.data() == std::as_const(this->_pages).getPage(page).data())
+				continue;
+			std::ranges::copy(data, this->_data.begin() + page * Ram::PagedBuffer::pageSize);
+		}
+		this->_pages = pages;
+		this->_dirtyPages = 0;
+	}
+}
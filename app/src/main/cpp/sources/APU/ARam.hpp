@@ -0,0 +1,102 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Ram/PagedBuffer.hpp"
+#include "SaveState/SaveState.hpp"
+
+namespace ComSquare::APU
+{
+	//! @brief The 64 KiB of audio ram shared by the SPC700 and the DSP.
+	//! @info The SPC700 and the DSP access a flat array. A paged copy of it is shared with the states that share the
+	//! memories (to clone a console): only the pages written since the last save or load are copied to it.
+	class ARam
+	{
+	public:
+		//! @brief The number of bytes of the audio ram.
+		static constexpr size_t ramSize = 0x10000;
+	private:
+		//! @brief The number of pages of the paged copy.
+		static constexpr size_t _pageCount = ramSize / Ram::PagedBuffer::pageSize;
+		static_assert(_pageCount <= 32, "There is a dirty bit per page.");
+		//! @brief The dirty bits of every page.
+		static constexpr uint32_t _allPages = (1ull << _pageCount) - 1;
+
+		//! @brief The bytes read and written by the SPC700 and the DSP.
+		std::array<uint8_t, ramSize> _data = {};
+		//! @brief The ram as it was on the last save or load sharing the memories.
+		//! @info It is a cache of the flat array brought up to date when saving, so it can change in a const save.
+		mutable Ram::PagedBuffer _pages{ramSize};
+		//! @brief A bit per page of the flat array written since the paged copy has been brought up to date.
+		mutable uint32_t _dirtyPages = 0;
+
+		//! @brief Mark the page of an address as written.
+		inline void _setDirty(size_t addr)
+		{
+			this->_dirtyPages |= 1u << (addr / Ram::PagedBuffer::pageSize);
+		}
+	public:
+		ARam() = default;
+		ARam(const ARam &) = delete;
+		ARam &operator=(const ARam &) = delete;
+		~ARam() = default;
+
+		//! @brief Read a byte.
+		[[nodiscard]] inline uint8_t read(uint16_t addr) const
+		{
+			return this->_data[addr];
+		}
+		//! @brief Write a byte.
+		inline void write(uint16_t addr, uint8_t data)
+		{
+			this->_data[addr] = data;
+			this->_setDirty(addr);
+		}
+
+		//! @brief Get a byte that can be modified. Its page is marked as written, even if the byte is only read.
+		inline uint8_t &operator[](size_t addr)
+		{
+			this->_setDirty(addr);
+			return this->_data[addr];
+		}
+		//! @brief Get a byte.
+		inline const uint8_t &operator[](size_t addr) const
+		{
+			return this->_data[addr];
+		}
+
+		//! @brief Get a pointer to the first byte that can be used to modify the whole ram (every page is marked as written).
+		[[nodiscard]] uint8_t *begin();
+		//! @brief Get a pointer past the last byte.
+		[[nodiscard]] uint8_t *end();
+
+		//! @brief Get the number of bytes of the audio ram.
+		[[nodiscard]] static constexpr size_t size()
+		{
+			return ramSize;
+		}
+
+		//! @brief Copy data to the ram.
+		//! @param addr The address of the first byte to overwrite.
+		//! @param data The bytes to copy (they must not go past the end of the ram).
+		void copyFrom(uint16_t addr, std::span<const uint8_t> data);
+
+		//! @brief Compare the content of two audio rams.
+		bool operator==(const ARam &other) const;
+
+		//! @brief Get the number of bytes only used by this ram (the flat array and the pages that are not shared).
+		[[nodiscard]] size_t getOwnedBytes() const;
+
+		//! @brief Save the ram in a state. The paged copy is shared with the state if it is sharing the memories.
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Load the ram from a state. Only the pages that changed are copied if it is sharing the memories.
+		//! @throw InvalidSaveState if the state is truncated.
+		void loadState(SaveState::SaveState &state);
+	};
+}
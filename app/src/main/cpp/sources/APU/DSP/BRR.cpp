@@ -9,11 +9,46 @@ namespace ComSquare::APU::DSP
 {
 	void DSP::decodeBRR(Voice &voice)
 	{
-		int32_t value = this->_brr.value << 8 | this->_readRAM(voice.brrAddress + voice.brrOffset + 1);
+		unsigned lane = this->_getLane(voice);
+		std::array<uint16_t, 24> &samples = this->_lanes.samples[lane];
+		uint8_t &sampleOffset = this->_lanes.sampleOffset[lane];
+		uint16_t address = voice.brrAddress + voice.brrOffset + 1;
+		uint8_t low = this->_readRAM(address);
+		int32_t value = this->_brr.value << 8 | low;
 
 		int32_t filter = this->_brr.header >> 2 & 0b11;
 		int32_t range = this->_brr.header >> 4 & 0b1111;
 
+		// Without filter, the previous samples do not change the result, so the entry can be shared by every history.
+		std::array<uint16_t, 2> history = {};
+		if (filter != 0) {
+			history[0] = samples[sampleOffset + 11];
+			history[1] = samples[sampleOffset + 10];
+		}
+		BRRCacheEntry &entry = this->_brrCache[(address ^ history[0] << 3 ^ history[1] << 6) % this->_brrCache.size()];
+		if (entry.isValid
+		    && entry.address == address
+		    && entry.header == this->_brr.header
+		    && entry.high == this->_brr.value
+		    && entry.low == low
+		    && entry.history == history) {
+			this->brrCacheStatistics.hits++;
+			for (uint16_t sample : entry.samples) {
+				samples[sampleOffset] = sample;
+				samples[sampleOffset + 12] = sample;
+				if (++sampleOffset >= 12)
+					sampleOffset = 0;
+			}
+			return;
+		}
+		this->brrCacheStatistics.misses++;
+		entry.isValid = true;
+		entry.address = address;
+		entry.header = this->_brr.header;
+		entry.high = this->_brr.value;
+		entry.low = low;
+		entry.history = history;
+
 		for (int i = 0; i < 4; i++) {
 			int32_t sample = value >> 12;
 			value <<= 4;
@@ -25,16 +60,9 @@ namespace ComSquare::APU::DSP
 			else
 				sample &= ~0x7FF;
 
-			int offset = voice.sampleOffset;
-			int lastSample;
-			int afterLastSample;
-
-			if (--offset < 0)
-				offset = 11;
-			lastSample = voice.samples[offset];
-			if (--offset < 0)
-				offset = 11;
-			afterLastSample = voice.samples[offset];
+			// The samples are written twice, so the 2 previous ones are always at 11 and 10 samples after the current one.
+			int lastSample = samples[sampleOffset + 11];
+			int afterLastSample = samples[sampleOffset + 10];
 
 			switch (filter) {
 				case 0:
@@ -58,9 +86,11 @@ namespace ComSquare::APU::DSP
 			}
 			sample = std::clamp(sample, 0, 16);
 			sample <<= 1;
-			voice.samples[voice.sampleOffset] = sample;
-			if (++voice.sampleOffset >= 12)
-				voice.sampleOffset = 0;
+			samples[sampleOffset] = sample;
+			samples[sampleOffset + 12] = sample;
+			entry.samples[i] = sample;
+			if (++sampleOffset >= 12)
+				sampleOffset = 0;
 		}
 	}
 }
\ No newline at end of file
@@ -8,9 +8,9 @@
 
 namespace ComSquare::APU::DSP
 {
-	DSP::DSP(Renderer::IRenderer &renderer, MemoryMap &map)
+	DSP::DSP(Renderer::IRenderer &renderer, ARam &ram)
 		: _state(this->_soundBuffer, this->_soundBuffer.size() / 2),
-		  _map(map),
+		  _ram(ram),
 		  _renderer(renderer)
 	{}
 
@@ -568,201 +568,21 @@ namespace ComSquare::APU::DSP
 		}
 	}
 
-	uint8_t DSP::_readRAM(uint24_t addr)
+	void DSP::renderSamples(unsigned count)
 	{
-		switch (addr) {
-		case 0x0000 ... 0x00EF:
-			return this->_map.Page0.read(addr);
-		case 0x0100 ... 0x01FF:
-			return this->_map.Page1.read(addr - 0x0100);
-		case 0x0200 ... 0xFFBF:
-			return this->_map.Memory.read(addr - 0x200);
-		case 0xFFC0 ... 0xFFFF:
-			return this->_map.IPL.read(addr - 0xFFC0);
-		default:
-			throw InvalidAddress("DSP read", addr);
-		}
-	}
-
-	void DSP::_writeRAM(uint24_t addr, uint8_t data)
-	{
-		switch (addr) {
-		case 0x0000 ... 0x00EF:
-			this->_map.Page0.write(addr, data);
-			break;
-		case 0x0100 ... 0x01FF:
-			this->_map.Page1.write(addr - 0x0100, data);
-			break;
-		case 0x0200 ... 0xFFBF:
-			this->_map.Memory.write(addr - 0x200, data);
-			break;
-		case 0xFFC0 ... 0xFFFF:
-			this->_map.IPL.write(addr - 0xFFC0, data);
-			break;
-		default:
-			throw InvalidAddress("DSP write", addr);
-		}
-	}
-
-	void DSP::update()
-	{
-		switch (this->_state.voice) {
-		case 0:
-			this->voice5(this->_voices[0]);
-			this->voice2(this->_voices[1]);
-			break;
-		case 1:
-			this->voice6(this->_voices[0]);
-			this->voice3(this->_voices[1]);
-			break;
-		case 2:
-			this->voice7(this->_voices[0]);
-			this->voice4(this->_voices[1]);
-			this->voice1(this->_voices[3]);
-			break;
-		case 3:
-			this->voice8(this->_voices[0]);
-			this->voice5(this->_voices[1]);
-			this->voice2(this->_voices[2]);
-			break;
-		case 4:
-			this->voice9(this->_voices[0]);
-			this->voice6(this->_voices[1]);
-			this->voice3(this->_voices[2]);
-			break;
-		case 5:
-			this->voice7(this->_voices[1]);
-			this->voice4(this->_voices[2]);
-			this->voice1(this->_voices[4]);
-			break;
-		case 6:
-			this->voice8(this->_voices[1]);
-			this->voice5(this->_voices[2]);
-			this->voice2(this->_voices[3]);
-			break;
-		case 7:
-			this->voice9(this->_voices[1]);
-			this->voice6(this->_voices[2]);
-			this->voice3(this->_voices[3]);
-			break;
-		case 8:
-			this->voice7(this->_voices[2]);
-			this->voice4(this->_voices[3]);
-			this->voice1(this->_voices[5]);
-			break;
-		case 9:
-			this->voice8(this->_voices[2]);
-			this->voice5(this->_voices[3]);
-			this->voice2(this->_voices[4]);
-			break;
-		case 10:
-			this->voice9(this->_voices[2]);
-			this->voice6(this->_voices[3]);
-			this->voice3(this->_voices[4]);
-			break;
-		case 11:
-			this->voice7(this->_voices[3]);
-			this->voice4(this->_voices[4]);
-			this->voice1(this->_voices[6]);
-			break;
-		case 12:
-			this->voice8(this->_voices[3]);
-			this->voice5(this->_voices[4]);
-			this->voice2(this->_voices[5]);
-			break;
-		case 13:
-			this->voice9(this->_voices[3]);
-			this->voice6(this->_voices[4]);
-			this->voice3(this->_voices[5]);
-			break;
-		case 14:
-			this->voice7(this->_voices[4]);
-			this->voice4(this->_voices[5]);
-			this->voice1(this->_voices[7]);
-			break;
-		case 15:
-			this->voice8(this->_voices[4]);
-			this->voice5(this->_voices[5]);
-			this->voice2(this->_voices[6]);
-			break;
-		case 16:
-			this->voice9(this->_voices[4]);
-			this->voice6(this->_voices[5]);
-			this->voice3(this->_voices[6]);
-			break;
-		case 17:
-			this->voice1(this->_voices[0]);
-			this->voice7(this->_voices[5]);
-			this->voice4(this->_voices[6]);
-			break;
-		case 18:
-			this->voice8(this->_voices[5]);
-			this->voice5(this->_voices[6]);
-			this->voice2(this->_voices[7]);
-			break;
-		case 19:
-			this->voice9(this->_voices[5]);
-			this->voice6(this->_voices[6]);
-			this->voice3(this->_voices[7]);
-			break;
-		case 20:
-			this->voice1(this->_voices[1]);
-			this->voice7(this->_voices[6]);
-			this->voice4(this->_voices[7]);
-			break;
-		case 21:
-			this->voice8(this->_voices[6]);
-			this->voice5(this->_voices[7]);
-			this->voice2(this->_voices[0]);
-			break;
-		case 22:
-			this->voice3a(this->_voices[0]);
-			this->voice9(this->_voices[6]);
-			this->voice6(this->_voices[7]);
-			echo22();
-			break;
-		case 23:
-			this->voice7(this->_voices[7]);
-			echo23();
-			break;
-		case 24:
-			this->voice8(this->_voices[7]);
-			echo24();
-			break;
-		case 25:
-			this->voice3b(this->_voices[0]);
-			this->voice9(this->_voices[7]);
-			echo25();
-			break;
-		case 26:
-			echo26();
-			break;
-		case 27:
-			this->misc27();
-			this->echo27();
-			break;
-		case 28:
-			this->misc28();
-			this->echo28();
-			break;
-		case 29:
-			this->misc29();
-			this->echo29();
-			break;
-		case 30:
-			this->misc30();
-			this->voice3c(this->_voices[0]);
-			this->echo30();
-			break;
-		case 31:
-			this->voice4(this->_voices[0]);
-			this->voice1(this->_voices[2]);
-			break;
+		uint32_t start = this->_state.bufferOffset;
+		for (unsigned i = 0; i < count; i++)
+			this->_runSample();
+		if (this->isMuted || count == 0)
+			return;
+		uint32_t end = this->_state.bufferOffset;
+		if (end <= start) {
+			// The buffer wrapped around during the batch.
+			this->_renderer.playAudio(std::span(this->_soundBuffer.begin() + start, this->_state.bufferSize - start));
+			start = 0;
 		}
-		this->_state.voice = (this->_state.voice + 1) % 32;
-		int32_t samples = this->getSamplesCount();
-		if (samples > 0)
-			this->_renderer.playAudio(std::span(this->_soundBuffer.begin(), samples / 2));
+		if (end > start)
+			this->_renderer.playAudio(std::span(this->_soundBuffer.begin() + start, end - start));
 	}
 
 	uint24_t DSP::getSize() const
@@ -804,4 +624,33 @@ namespace ComSquare::APU::DSP
 	{
 		return this->_state.bufferOffset;
 	}
-}
\ No newline at end of file
+
+	std::span<const int16_t> DSP::getSoundBuffer() const
+	{
+		return std::span(this->_soundBuffer.begin(), this->_state.bufferSize);
+	}
+
+	void DSP::saveState(SaveState::SaveState &state) const
+	{
+		state.write(this->_voices);
+		state.write(this->_lanes);
+		state.write(this->_master);
+		state.write(this->_echo);
+		state.write(this->_noise);
+		state.write(this->_brr);
+		state.write(this->_latch);
+		state.write(this->_timer);
+	}
+
+	void DSP::loadState(SaveState::SaveState &state)
+	{
+		state.read(this->_voices);
+		state.read(this->_lanes);
+		state.read(this->_master);
+		state.read(this->_echo);
+		state.read(this->_noise);
+		state.read(this->_brr);
+		state.read(this->_latch);
+		state.read(this->_timer);
+	}
+}
@@ -8,11 +8,12 @@
 #include <array>
 #include "Renderer/IRenderer.hpp"
 #include "Memory/AMemory.hpp"
+#include "SaveState/SaveState.hpp"
+#include "APU/ARam.hpp"
 
 namespace ComSquare::APU
 {
 	class APU;
-	struct MemoryMap;
 }
 
 namespace ComSquare::APU::DSP
@@ -61,9 +62,9 @@ namespace ComSquare::APU::DSP
 		bool enabled = true;
 		//! @brief Application of enabled to channels.
 		bool toggle;
-		//! @brief Last sound produced for each voice in each channel
-		std::array<std::array<int16_t, 8>, 2> history;
-		//! @brief Current position inside history
+		//! @brief Last 8 echo samples (left and right interleaved), written twice so that the 8 samples of the filter never wrap around
+		std::array<int16_t, 32> history;
+		//! @brief Current position inside history (0 to 7)
 		uint8_t historyOffset;
 		//! @brief Address of the current echo
 		uint16_t address;
@@ -174,18 +175,25 @@ namespace ComSquare::APU::DSP
 		bool tempKon : 1;
 		//! @brief temporary Key Off register value
 		bool tempKof : 1;
-		//! @brief all samples Decoded from BRR
-		std::array<uint16_t, 12> samples;
-		//! @brief Offset of current sample in samples buffer
-		uint8_t sampleOffset;
-		//! @brief Current envelope level
-		uint16_t envelope;
 		//! @brief Second envelope level used to make "special" waveforms
 		uint16_t hiddenEnvelope;
 		//! @brief current envelope Mode
 		Envelope envelopeMode;
+	};
+
+	//! @brief The state of the 8 voices used to compute every sample, with an array per field (indexed by voice).
+	//! @info The 8 voices are interpolated together at the start of each sample, in a single loop over these arrays.
+	struct VoiceLanes {
+		//! @brief all samples Decoded from BRR, written twice so that 4 consecutive samples never wrap around
+		std::array<std::array<uint16_t, 24>, 8> samples;
+		//! @brief Offset of current sample in samples buffer (0 to 11)
+		std::array<uint8_t, 8> sampleOffset;
 		//! @brief Relative fractional position in sample
-		uint16_t gaussOffset;
+		std::array<uint16_t, 8> gaussOffset;
+		//! @brief Current envelope level
+		std::array<uint16_t, 8> envelope;
+		//! @brief Interpolated sample scaled by the envelope, computed at the start of each sample
+		std::array<int32_t, 8> output;
 	};
 
 	//! @brief Current state of the DSP
@@ -195,8 +203,6 @@ namespace ComSquare::APU::DSP
 			: buffer(array), bufferSize(size)
 		{};
 
-		//! @brief Current voice modification to do
-		uint8_t voice = 0;
 		//! @brief Current buffer of samples
 		std::array<int16_t, 0x10000> &buffer;
 		//! @brief Size of buffer
@@ -212,6 +218,24 @@ namespace ComSquare::APU::DSP
 		bool sample = true;
 	};
 
+	//! @brief Statistics about the work skipped for the silent voices.
+	struct VoiceStatistics
+	{
+		//! @brief The number of samples computed by the voices (8 per output sample).
+		uint64_t voiceSamples = 0;
+		//! @brief The number of voice samples skipped because the voice was silent.
+		uint64_t silentVoiceSamples = 0;
+	};
+
+	//! @brief Statistics about the cache of decoded BRR samples.
+	struct BRRCacheStatistics
+	{
+		//! @brief The number of times decoded samples were found in the cache.
+		uint64_t hits = 0;
+		//! @brief The number of times the samples had to be decoded.
+		uint64_t misses = 0;
+	};
+
 	class DSP {
 	private:
 		//! @brief Number of samples per counter event
@@ -270,10 +294,34 @@ namespace ComSquare::APU::DSP
 			1299, 1300, 1300, 1301, 1302, 1302, 1303, 1303, 1303, 1304, 1304, 1304, 1304, 1304, 1305, 1305
 		};
 
+		//! @brief 4 samples decoded from BRR and everything they have been decoded from.
+		struct BRRCacheEntry
+		{
+			//! @brief False if this entry has never been filled.
+			bool isValid = false;
+			//! @brief The header of the block.
+			uint8_t header;
+			//! @brief The first byte of data (the 2 upper samples).
+			uint8_t high;
+			//! @brief The second byte of data (the 2 lower samples).
+			uint8_t low;
+			//! @brief The address of the second byte of data.
+			uint16_t address;
+			//! @brief The 2 samples before these ones (only used by the filters, 0 if the block has no filter).
+			std::array<uint16_t, 2> history;
+			//! @brief The samples decoded.
+			std::array<uint16_t, 4> samples;
+		};
+		//! @brief Samples decoded from BRR, indexed by their address and their history.
+		//! @info The entries keep the bytes they have been decoded from, so an entry is not used once the RAM has been written to.
+		std::array<BRRCacheEntry, 512> _brrCache = {};
+
 		//! @brief Buffer containing samples to be played
 		std::array<int16_t, 0x10000> _soundBuffer = {};
 		//! @brief 8x voices of sample used to make sound
 		std::array<Voice, 8> _voices {};
+		//! @brief The state of the voices used for every sample
+		VoiceLanes _lanes {};
 		Master _master {};
 		Echo _echo {};
 		Noise _noise {};
@@ -296,9 +344,6 @@ namespace ComSquare::APU::DSP
 		void voice8(Voice &voice);
 		void voice9(Voice &voice);
 		void echo22();
-		void echo23();
-		void echo24();
-		void echo25();
 		void echo26();
 		void echo27();
 		void echo28();
@@ -308,16 +353,35 @@ namespace ComSquare::APU::DSP
 		void misc28();
 		void misc29();
 		void misc30();
-
-		//! @brief Interpolate voice samples with gauss table
-		int32_t interpolate(const Voice &voice);
+		//! @brief Run the 32 steps of a sample, in the order of the hardware.
+		void _runSample();
+
+		//! @brief Get the index of a voice in the lanes.
+		[[nodiscard]] inline unsigned _getLane(const Voice &voice) const
+		{
+			return &voice - this->_voices.data();
+		}
+
+		//! @brief Check if a voice is keyed off and its envelope has reached 0, so it can't be heard until it is keyed on again.
+		[[nodiscard]] inline bool _isSilent(const Voice &voice) const
+		{
+			return this->isSilentVoiceSkippingEnabled
+				&& voice.envelopeMode == Envelope::Release && this->_lanes.envelope[this->_getLane(voice)] == 0 && !voice.konDelay;
+		}
+
+		//! @brief Interpolate the samples of the 8 voices with gauss table and scale them by their envelope (in _lanes.output)
+		//! @info A voice only changes its samples, position and envelope at its own steps 3c and 4, so the output computed at the start of a sample is the one its step 3c uses (a voice being keyed on outputs 0).
+		void interpolate();
 		//! @brief Modify voice samples with its envelope
 		void runEnvelope(Voice &voice);
 
-		int32_t loadFIR(bool channel, int fir);
-		void loadEcho(bool channel);
+		//! @brief Read the left and right samples of the echo buffer into the history
+		void loadEcho();
+		//! @brief Apply the FIR filter to the history of both channels (in echo input)
+		void filterEcho();
 		int16_t outputEcho(bool channel);
-		void writeEcho(bool channel);
+		//! @brief Write the left and right echo outputs to the echo buffer
+		void writeEcho();
 
 		//! @brief Remove one tick from timer
 		void timerTick();
@@ -325,24 +389,45 @@ namespace ComSquare::APU::DSP
 		bool timerPoll(uint32_t rate);
 
 		//! @brief Transform BRR value to samples
+		//! @info The samples are taken from the cache when the same bytes have already been decoded with the same history.
 		void decodeBRR(Voice &voice);
 
-		//! @brief Whole APU RAM map
-		MemoryMap &_map;
+		//! @brief Whole APU RAM
+		ARam &_ram;
 
 		//! @brief Renderer used to play sounds
 		Renderer::IRenderer &_renderer;
 
-		//! @brief Read inside APU RAM
-		uint8_t _readRAM(uint24_t addr);
+		//! @brief Read inside APU RAM (the DSP does not see the registers or the IPL ROM, addresses wrap around)
+		inline uint8_t _readRAM(uint16_t addr) const
+		{
+			return this->_ram.read(addr);
+		}
 		//! @brief Write into APU RAM
-		void _writeRAM(uint24_t addr, uint8_t data);
+		inline void _writeRAM(uint16_t addr, uint8_t data)
+		{
+			this->_ram.write(addr, data);
+		}
+		//! @brief Read a left and right pair of 16 bits samples inside APU RAM
+		std::array<int16_t, 2> _readStereo(uint16_t addr) const;
+		//! @brief Write a left and right pair of 16 bits samples into APU RAM
+		void _writeStereo(uint16_t addr, std::array<int16_t, 2> samples);
 	public:
-		DSP(Renderer::IRenderer &renderer, MemoryMap &map);
+		DSP(Renderer::IRenderer &renderer, ARam &ram);
 		DSP(const DSP &) = default;
 		DSP &operator=(const DSP &) = delete;
 		~DSP() = default;
 
+		//! @brief Set to true to discard the samples instead of giving them to the renderer.
+		bool isMuted = false;
+		//! @brief Set to false to run the envelope and the output of the silent voices anyway.
+		//! @info The output is the same either way, a silent voice still decodes its samples.
+		bool isSilentVoiceSkippingEnabled = true;
+		//! @brief Statistics about the silent voices since the creation of this DSP.
+		VoiceStatistics voiceStatistics;
+		//! @brief Statistics about the cache of decoded BRR samples since the creation of this DSP.
+		BRRCacheStatistics brrCacheStatistics;
+
 		//! @brief Return all 8 voices from DSP
 		[[nodiscard]] const std::array<Voice, 8> &getVoices() const;
 		[[nodiscard]] const Master &getMaster() const;
@@ -364,8 +449,10 @@ namespace ComSquare::APU::DSP
 
 		//! @brief Get the name of this accessor (used for debug purpose)
 		[[nodiscard]] std::string getName() const;
-		//! @brief Execute current voice transformation
-		void update();
+		//! @brief Render whole output samples (32 steps each).
+		//! @param count The number of samples to render.
+		//! @info The samples are given to the renderer at once at the end of the batch, unless the DSP is muted.
+		void renderSamples(unsigned count);
 
 		//! @brief Get the component of this accessor (used for debug purpose)
 		[[nodiscard]] Component getComponent() const;
@@ -375,5 +462,13 @@ namespace ComSquare::APU::DSP
 		[[nodiscard]] uint24_t getSize() const;
 		//! @brief Return the number of samples written
 		[[nodiscard]] int32_t getSamplesCount() const;
+		//! @brief Get the whole sound buffer. The samples are written from the start again when it is full.
+		[[nodiscard]] std::span<const int16_t> getSoundBuffer() const;
+
+		//! @brief Write the voices, the echo and the internal state of the DSP to a save state.
+		//! @info The samples already written to the sound buffer are not part of the state.
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Restore the state of the DSP from a save state.
+		void loadState(SaveState::SaveState &state);
 	};
 }
\ No newline at end of file
@@ -2,76 +2,98 @@
 // Created by melefo on 2/1/21.
 //
 
+#include <bit>
+#include <cstring>
+#include <span>
+#include <utility>
 #include "DSP.hpp"
 
 namespace ComSquare::APU::DSP
 {
-	int32_t DSP::loadFIR(bool channel, int fir)
+	static_assert(std::endian::native == std::endian::little, "The samples of the echo buffer are copied with the byte order of the host");
+
+	std::array<int16_t, 2> DSP::_readStereo(uint16_t addr) const
 	{
-		int32_t sample = this->_echo.history[channel][this->_echo.historyOffset + fir + 1];
+		std::array<int16_t, 2> samples;
 
-		return (sample * this->_echo.FIR[fir]) >> 6;
+		// The echo buffer is made of 4 bytes frames, so a frame only wraps around the RAM if a save state has moved it.
+		if (addr > this->_ram.size() - sizeof(samples)) {
+			for (unsigned channel = 0; channel < 2; channel++, addr += 2)
+				samples[channel] = static_cast<int16_t>(this->_readRAM(addr) | this->_readRAM(addr + 1) << 8);
+			return samples;
+		}
+		std::memcpy(samples.data(), &std::as_const(this->_ram)[addr], sizeof(samples));
+		return samples;
 	}
 
-	void DSP::loadEcho(bool channel)
+	void DSP::_writeStereo(uint16_t addr, std::array<int16_t, 2> samples)
 	{
-		uint16_t address = this->_echo.address + channel * 2;
-		uint8_t low = this->_readRAM(address++);
-		uint8_t high = this->_readRAM(address);
-		int16_t echo = (high << 8) + low;
-
-		this->_echo.history[channel][this->_echo.historyOffset] = echo >> 1;
+		if (addr > this->_ram.size() - sizeof(samples)) {
+			for (unsigned channel = 0; channel < 2; channel++, addr += 2) {
+				this->_writeRAM(addr, samples[channel]);
+				this->_writeRAM(addr + 1, samples[channel] >> 8);
+			}
+			return;
+		}
+		this->_ram.copyFrom(addr, std::span(reinterpret_cast<const uint8_t *>(samples.data()), sizeof(samples)));
 	}
 
-	void DSP::writeEcho(bool channel)
+	void DSP::loadEcho()
 	{
-		if (!this->_echo.toggle) {
-			uint16_t address = this->_echo.address + channel * 2;
-			int16_t sample = this->_echo.output[channel];
+		std::array<int16_t, 2> samples = this->_readStereo(this->_echo.address);
 
-			this->_writeRAM(address++, sample);
-			this->_writeRAM(address, sample >> 8);
+		for (unsigned channel = 0; channel < 2; channel++) {
+			this->_echo.history[this->_echo.historyOffset * 2 + channel] = samples[channel] >> 1;
+			this->_echo.history[(this->_echo.historyOffset + 8) * 2 + channel] = samples[channel] >> 1;
 		}
-		this->_echo.output[channel] = 0;
 	}
 
-	int16_t DSP::outputEcho(bool channel)
+	void DSP::filterEcho()
 	{
-		int16_t master = this->_master.output[channel] * this->_master.volume[channel] >> 7;
-		int16_t echo = this->_echo.input[channel] * this->_echo.input[channel] >> 7;
+		// The 8 samples after the current position, from the oldest to the one just loaded.
+		const int16_t *samples = &this->_echo.history[(this->_echo.historyOffset + 1) * 2];
+		std::array<int32_t, 16> taps;
+		std::array<int32_t, 2> input = {};
 
-		return master + echo;
+		// The taps of both channels are computed together, then summed by channel.
+		for (unsigned i = 0; i < 16; i++)
+			taps[i] = samples[i] * this->_echo.FIR[i / 2] >> 6;
+		for (unsigned i = 0; i < 16; i += 2) {
+			input[0] += taps[i];
+			input[1] += taps[i + 1];
+		}
+		this->_echo.input[0] = input[0];
+		this->_echo.input[1] = input[1];
 	}
 
-	void DSP::echo22()
+	void DSP::writeEcho()
 	{
-		this->_echo.historyOffset += 1;
-		this->_echo.address = (this->_echo.value << 8) + this->_echo.offset;
-
-		this->loadEcho(0);
-
-		this->_echo.input[0] = this->loadFIR(0, 0);
-		this->_echo.input[1] = this->loadFIR(1, 0);
+		if (!this->_echo.toggle)
+			this->_writeStereo(this->_echo.address, {
+				static_cast<int16_t>(this->_echo.output[0]),
+				static_cast<int16_t>(this->_echo.output[1])
+			});
+		this->_echo.output = {};
 	}
 
-	void DSP::echo23()
+	int16_t DSP::outputEcho(bool channel)
 	{
-		this->loadEcho(1);
+		int16_t master = this->_master.output[channel] * this->_master.volume[channel] >> 7;
+		int16_t echo = this->_echo.input[channel] * this->_echo.input[channel] >> 7;
 
-		this->_echo.input[0] += this->loadFIR(0, 1) + this->loadFIR(0, 2);
-		this->_echo.input[1] += this->loadFIR(1, 1) + this->loadFIR(1, 2);
+		return master + echo;
 	}
 
-	void DSP::echo24()
+	void DSP::echo22()
 	{
-		this->_echo.input[0] += this->loadFIR(0, 3) + this->loadFIR(0, 4) + this->loadFIR(0, 5);
-		this->_echo.input[1] += this->loadFIR(1, 3) + this->loadFIR(1, 4) + this->loadFIR(1, 5);
-	}
+		if (++this->_echo.historyOffset >= 8)
+			this->_echo.historyOffset = 0;
+		this->_echo.address = (this->_echo.value << 8) + this->_echo.offset;
 
-	void DSP::echo25()
-	{
-		this->_echo.input[0] += this->loadFIR(0, 6) + this->loadFIR(0, 7);
-		this->_echo.input[1] += this->loadFIR(1, 6) + this->loadFIR(1, 7);
+		// The hardware reads the right channel and applies the filter during the steps 22 to 25. Nothing else uses the echo
+		// buffer or the history in between, so both channels are read and filtered at once.
+		this->loadEcho();
+		this->filterEcho();
 	}
 
 	void DSP::echo26()
@@ -118,14 +140,13 @@ namespace ComSquare::APU::DSP
 		if (this->_echo.offset >= this->_echo.length)
 			this->_echo.offset = 0;
 
-		this->writeEcho(0);
-
 		echo28();
 	}
 
 	void DSP::echo30()
 	{
-		this->writeEcho(1);
+		// The hardware writes the left channel at the step 29, with the same address and the same toggle.
+		this->writeEcho();
 	}
 
 	void DSP::misc27()
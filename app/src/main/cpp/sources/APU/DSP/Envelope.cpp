@@ -8,13 +8,14 @@ namespace ComSquare::APU::DSP
 {
 	void DSP::runEnvelope(Voice &voice)
 	{
-		int32_t envelope = voice.envelope;
+		uint16_t &voiceEnvelope = this->_lanes.envelope[this->_getLane(voice)];
+		int32_t envelope = voiceEnvelope;
 
 		if (voice.envelopeMode == Envelope::Release) {
 			envelope -= 0x08;
 			if (envelope < 0)
 				envelope = 0;
-			voice.envelope = envelope;
+			voiceEnvelope = envelope;
 			return;
 		}
 
@@ -73,6 +74,6 @@ namespace ComSquare::APU::DSP
 		}
 
 		if (this->timerPoll(rate))
-			voice.envelope = envelope;
+			voiceEnvelope = envelope;
 	}
 }
\ No newline at end of file
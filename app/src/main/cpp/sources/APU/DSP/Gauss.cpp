@@ -8,23 +8,23 @@
 
 namespace ComSquare::APU::DSP
 {
-	int32_t DSP::interpolate(const Voice &voice)
+	void DSP::interpolate()
 	{
-		int32_t interpolated;
-		uint8_t offset = voice.gaussOffset >> 4;
-		int forward = 255 - offset;
-		int reverse = offset;
+		// The samples are written twice, so the 4 samples of a voice are always next to each other.
+		for (unsigned lane = 0; lane < 8; lane++) {
+			uint16_t gaussOffset = this->_lanes.gaussOffset[lane];
+			int forward = 255 - (gaussOffset >> 4 & 0xFF);
+			int reverse = gaussOffset >> 4 & 0xFF;
+			const uint16_t *samples = &this->_lanes.samples[lane][this->_lanes.sampleOffset[lane] + (gaussOffset >> 12)];
 
-		offset = (voice.sampleOffset + (voice.gaussOffset >> 12)) % 12;
-		interpolated = this->_gauss[forward] * voice.samples[offset++] >> 11;
-		offset %= 12;
-		interpolated += this->_gauss[forward + 256] * voice.samples[offset++] >> 11;
-		offset %= 12;
-		interpolated += this->_gauss[reverse + 256] * voice.samples[offset++] >> 11;
-		offset %= 12;
-		interpolated = static_cast<int16_t>(interpolated);
-		interpolated += this->_gauss[reverse] * voice.samples[offset] >> 11;
+			int32_t interpolated = this->_gauss[forward] * samples[0] >> 11;
+			interpolated += this->_gauss[forward + 256] * samples[1] >> 11;
+			interpolated += this->_gauss[reverse + 256] * samples[2] >> 11;
+			interpolated = static_cast<int16_t>(interpolated);
+			interpolated += this->_gauss[reverse] * samples[3] >> 11;
+			interpolated = std::clamp(interpolated, 0, 16) & ~1;
 
-		return std::clamp(interpolated, 0, 16) & ~1;
+			this->_lanes.output[lane] = interpolated * this->_lanes.envelope[lane] >> 11 & ~1;
+		}
 	}
-}
\ No newline at end of file
+}
@@ -56,6 +56,8 @@ namespace ComSquare::APU::DSP
 
 	void DSP::voice3c(Voice &voice)
 	{
+		unsigned lane = this->_getLane(voice);
+
 		if (voice.prevPmon)
 			this->_latch.pitch += (this->_latch.output >> 5) * this->_latch.pitch >> 10;
 
@@ -63,29 +65,39 @@ namespace ComSquare::APU::DSP
 			if (voice.konDelay == 5) {
 				voice.brrAddress = this->_brr.nextAddress;
 				voice.brrOffset = 1;
-				voice.sampleOffset = 0;
+				this->_lanes.sampleOffset[lane] = 0;
 				this->_brr.header = 0;
 			}
 
-			voice.envelope = 0;
+			this->_lanes.envelope[lane] = 0;
+			this->_lanes.output[lane] = 0;
 			voice.hiddenEnvelope = 0;
-			voice.gaussOffset = 0;
+			this->_lanes.gaussOffset[lane] = 0;
 			voice.konDelay -= 1;
 			if (voice.konDelay & 3)
-				voice.gaussOffset = 0x4000;
+				this->_lanes.gaussOffset[lane] = 0x4000;
 			this->_latch.pitch = 0;
 		}
 
-		int32_t interpolated = this->interpolate(voice);
-
-		if (voice.tempNon)
-			interpolated = this->_noise.lfsr << 1;
+		// A silent voice outputs 0 whatever its samples are.
+		bool isSilent = this->_isSilent(voice);
+		this->voiceStatistics.voiceSamples++;
+		if (isSilent) {
+			this->voiceStatistics.silentVoiceSamples++;
+			this->_latch.output = 0;
+			voice.envx = 0;
+		} else {
+			uint16_t envelope = this->_lanes.envelope[lane];
 
-		this->_latch.output = interpolated * voice.envelope >> 11 & ~1;
-		voice.envx = voice.envelope >> 4;
+			if (voice.tempNon)
+				this->_latch.output = (this->_noise.lfsr << 1) * envelope >> 11 & ~1;
+			else
+				this->_latch.output = this->_lanes.output[lane];
+			voice.envx = envelope >> 4;
+		}
 
 		if (this->_master.reset || (this->_brr.header & 3) == 1) {
-			voice.envelope = 0;
+			this->_lanes.envelope[lane] = 0;
 			voice.envelopeMode = Envelope::Release;
 		}
 
@@ -99,14 +111,17 @@ namespace ComSquare::APU::DSP
 			}
 		}
 
-		if (!voice.konDelay)
+		if (!voice.konDelay && !isSilent)
 			this->runEnvelope(voice);
 	}
 
 	void DSP::voice4(Voice &voice)
 	{
+		uint16_t &gaussOffset = this->_lanes.gaussOffset[this->_getLane(voice)];
+
 		voice.loop = false;
-		if (voice.gaussOffset >= 0x4000) {
+		if (gaussOffset >= 0x4000) {
+			// A silent voice still decodes its samples (cheap with the cache), the filter of the next block uses them.
 			this->decodeBRR(voice);
 			voice.brrOffset += 2;
 			if (voice.brrOffset >= 9) {
@@ -119,9 +134,9 @@ namespace ComSquare::APU::DSP
 			}
 		}
 
-		voice.gaussOffset = (voice.gaussOffset & 0x3FFF) + this->_latch.pitch;
-		if (voice.gaussOffset > 0x7FFF)
-			voice.gaussOffset = 0x7FFF;
+		gaussOffset = (gaussOffset & 0x3FFF) + this->_latch.pitch;
+		if (gaussOffset > 0x7FFF)
+			gaussOffset = 0x7FFF;
 		this->voiceOutput(voice, 0);
 	}
 
@@ -153,4 +168,126 @@ namespace ComSquare::APU::DSP
 	{
 		voice.envx = this->_latch.envx;
 	}
-}
\ No newline at end of file
+
+	// The schedule is next to the voice steps so that they can be inlined in it.
+	void DSP::_runSample()
+	{
+		this->interpolate();
+		// Step 0
+		this->voice5(this->_voices[0]);
+		this->voice2(this->_voices[1]);
+		// Step 1
+		this->voice6(this->_voices[0]);
+		this->voice3(this->_voices[1]);
+		// Step 2
+		this->voice7(this->_voices[0]);
+		this->voice4(this->_voices[1]);
+		this->voice1(this->_voices[3]);
+		// Step 3
+		this->voice8(this->_voices[0]);
+		this->voice5(this->_voices[1]);
+		this->voice2(this->_voices[2]);
+		// Step 4
+		this->voice9(this->_voices[0]);
+		this->voice6(this->_voices[1]);
+		this->voice3(this->_voices[2]);
+		// Step 5
+		this->voice7(this->_voices[1]);
+		this->voice4(this->_voices[2]);
+		this->voice1(this->_voices[4]);
+		// Step 6
+		this->voice8(this->_voices[1]);
+		this->voice5(this->_voices[2]);
+		this->voice2(this->_voices[3]);
+		// Step 7
+		this->voice9(this->_voices[1]);
+		this->voice6(this->_voices[2]);
+		this->voice3(this->_voices[3]);
+		// Step 8
+		this->voice7(this->_voices[2]);
+		this->voice4(this->_voices[3]);
+		this->voice1(this->_voices[5]);
+		// Step 9
+		this->voice8(this->_voices[2]);
+		this->voice5(this->_voices[3]);
+		this->voice2(this->_voices[4]);
+		// Step 10
+		this->voice9(this->_voices[2]);
+		this->voice6(this->_voices[3]);
+		this->voice3(this->_voices[4]);
+		// Step 11
+		this->voice7(this->_voices[3]);
+		this->voice4(this->_voices[4]);
+		this->voice1(this->_voices[6]);
+		// Step 12
+		this->voice8(this->_voices[3]);
+		this->voice5(this->_voices[4]);
+		this->voice2(this->_voices[5]);
+		// Step 13
+		this->voice9(this->_voices[3]);
+		this->voice6(this->_voices[4]);
+		this->voice3(this->_voices[5]);
+		// Step 14
+		this->voice7(this->_voices[4]);
+		this->voice4(this->_voices[5]);
+		this->voice1(this->_voices[7]);
+		// Step 15
+		this->voice8(this->_voices[4]);
+		this->voice5(this->_voices[5]);
+		this->voice2(this->_voices[6]);
+		// Step 16
+		this->voice9(this->_voices[4]);
+		this->voice6(this->_voices[5]);
+		this->voice3(this->_voices[6]);
+		// Step 17
+		this->voice1(this->_voices[0]);
+		this->voice7(this->_voices[5]);
+		this->voice4(this->_voices[6]);
+		// Step 18
+		this->voice8(this->_voices[5]);
+		this->voice5(this->_voices[6]);
+		this->voice2(this->_voices[7]);
+		// Step 19
+		this->voice9(this->_voices[5]);
+		this->voice6(this->_voices[6]);
+		this->voice3(this->_voices[7]);
+		// Step 20
+		this->voice1(this->_voices[1]);
+		this->voice7(this->_voices[6]);
+		this->voice4(this->_voices[7]);
+		// Step 21
+		this->voice8(this->_voices[6]);
+		this->voice5(this->_voices[7]);
+		this->voice2(this->_voices[0]);
+		// Step 22
+		this->voice3a(this->_voices[0]);
+		this->voice9(this->_voices[6]);
+		this->voice6(this->_voices[7]);
+		this->echo22();
+		// Step 23
+		this->voice7(this->_voices[7]);
+		// Step 24
+		this->voice8(this->_voices[7]);
+		// Step 25
+		this->voice3b(this->_voices[0]);
+		this->voice9(this->_voices[7]);
+		// Step 26
+		this->echo26();
+		// Step 27
+		this->misc27();
+		this->echo27();
+		// Step 28
+		this->misc28();
+		this->echo28();
+		// Step 29
+		this->misc29();
+		this->echo29();
+		// Step 30
+		this->misc30();
+		this->voice3c(this->_voices[0]);
+		this->echo30();
+		// Step 31
+		this->voice4(this->_voices[0]);
+		this->voice1(this->_voices[2]);
+	}
+}
@@ -8,7 +8,11 @@ namespace ComSquare::APU
 {
 	int APU::BRA(int8_t offset)
 	{
+		uint16_t loopEnd = this->_internalRegisters.pc;
+
 		this->_internalRegisters.pc += offset;
+		if (offset < 0)
+			this->_detectIdleLoop(loopEnd);
 		return 4;
 	}
 
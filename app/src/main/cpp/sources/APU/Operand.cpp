@@ -7,11 +7,6 @@
 
 namespace ComSquare::APU
 {
-	uint8_t APU::_getImmediateData()
-	{
-		return this->_internalRead(this->_internalRegisters.pc++);
-	}
-
 	uint24_t APU::_getDirectAddr()
 	{
 		uint24_t addr = this->_getImmediateData();
@@ -39,6 +39,13 @@ namespace ComSquare::CPU
 		return effective;
 	}
 
+	uint24_t CPU::_getBlockMoveBanks()
+	{
+		uint8_t destination = this->_readPC();
+		uint8_t source = this->_readPC();
+		return source | destination << 8u;
+	}
+
 	uint24_t CPU::_getDirectAddr()
 	{
 		uint8_t addr = this->_readPC();
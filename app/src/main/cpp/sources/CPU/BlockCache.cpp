@@ -0,0 +1,158 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include "CPU/BlockCache.hpp"
+#include "CPU/CPU.hpp"
+#include "Cartridge/Cartridge.hpp"
+#include "Memory/MemoryShadow.hpp"
+#include "Memory/RectangleShadow.hpp"
+
+namespace ComSquare::CPU
+{
+	Block *BlockCache::find(uint32_t key)
+	{
+		auto it = this->_blocks.find(key);
+		if (it == this->_blocks.end())
+			return nullptr;
+		if (it->second.isOutdated()) {
+			this->_blocks.erase(it);
+			return nullptr;
+		}
+		return &it->second;
+	}
+
+	Block &BlockCache::insert(uint32_t key, Block block)
+	{
+		return this->_blocks[key] = std::move(block);
+	}
+
+	void BlockCache::invalidate(uint32_t key)
+	{
+		this->_blocks.erase(key);
+	}
+
+	void BlockCache::clear()
+	{
+		this->_blocks.clear();
+	}
+
+	size_t BlockCache::size() const
+	{
+		return this->_blocks.size();
+	}
+
+	bool CPU::_endsBlock(InstructionHandler handler)
+	{
+		static constexpr InstructionHandler blockEnds[] = {
+			&CPU::BRK, &CPU::COP, &CPU::RTI, &CPU::WAI, &CPU::STP,
+			&CPU::JMP, &CPU::JML, &CPU::JSR, &CPU::JSL, &CPU::RTS, &CPU::RTL, &CPU::BRL,
+			&CPU::BCC, &CPU::BCS, &CPU::BEQ, &CPU::BNE, &CPU::BMI, &CPU::BPL, &CPU::BVC, &CPU::BVS, &CPU::BRA,
+			&CPU::REP, &CPU::SEP, &CPU::XCE, &CPU::PLP, &CPU::MVN, &CPU::MVP,
+		};
+
+		return std::find(std::begin(blockEnds), std::end(blockEnds), handler) != std::end(blockEnds);
+	}
+
+	Block *CPU::_translateBlock(uint32_t key)
+	{
+		uint24_t start = this->_registers.pac;
+		Memory::IMemory *memory = this->getBus().getAccessor(start);
+		if (!memory)
+			return nullptr;
+		uint24_t memoryAddress = memory->getRelativeAddress(start);
+		// Shadows forward their relative address as is, the code is really stored in the mirrored memory.
+		while (true) {
+			if (auto *shadow = dynamic_cast<Memory::MemoryShadow *>(memory))
+				memory = &shadow->getMirrored();
+			else if (auto *rectangleShadow = dynamic_cast<Memory::RectangleShadow *>(memory))
+				memory = &rectangleShadow->getMirrored();
+			else
+				break;
+		}
+		// Only code stored in a ram or in the rom can be tracked, code running from registers is interpreted.
+		auto *ram = dynamic_cast<Ram::Ram *>(memory);
+		if (!ram)
+			return nullptr;
+
+		Block block;
+		if (!dynamic_cast<Cartridge::Cartridge *>(ram)) {
+			block.memory = ram;
+			block.memoryAddress = memoryAddress;
+			block.version = ram->getPageVersion(memoryAddress);
+		}
+
+		const DispatchTable &table = *this->_dispatchTable;
+		uint16_t pc = this->_registers.pc;
+		while (block.instructions.size() < BlockCache::maxBlockSize) {
+			uint8_t opcode = this->getBus().peek_v((this->_registers.pbr << 16u) + pc);
+			const Instruction &instruction = instructions[opcode];
+			unsigned size = this->_getInstructionSize(instruction);
+			// A block stays in a single page so a single version is enough to detect self modifying code.
+			if ((pc + size - 1) >> 8u != this->_registers.pc >> 8u)
+				break;
+			block.instructions.push_back({table[opcode], opcode, instruction.cycleCount, static_cast<uint8_t>(size), instruction.addressingMode});
+			pc += size;
+			if (_endsBlock(instruction.call))
+				break;
+		}
+		if (block.instructions.empty())
+			return nullptr;
+		return &this->_blockCache.insert(key, std::move(block));
+	}
+
+	unsigned CPU::_executeBlock()
+	{
+		unsigned flags = this->_registers.p.m | this->_registers.p.x_b << 1u | this->_isEmulationMode << 2u;
+		uint32_t key = BlockCache::getKey(this->_registers.pac, flags);
+		Block *block = this->_blockCache.find(key);
+		if (!block)
+			block = this->_translateBlock(key);
+		if (!block)
+			return this->executeInstruction();
+
+		bool isChecked = this->executionMode == ExecutionMode::Differential;
+		if (isChecked)
+			this->onBlockStart();
+		uint64_t instructionsBefore = this->instructionCount;
+		unsigned cycles;
+		bool isNative = this->executionMode == ExecutionMode::Native || isChecked;
+		if (isNative && this->_recompiler.isAvailable()) {
+			if (!block->native)
+				block->native = this->_compileBlock(*block, key);
+			if (!block->native) {
+				// The code buffer is full, every block is compiled again from scratch.
+				this->_blockCache.clear();
+				this->_recompiler.clear();
+				return this->executeInstruction();
+			}
+			cycles = block->native(this);
+		} else
+			cycles = this->_runDecodedBlock(*block);
+		// The block wrote over its own code, the next instructions have to be decoded again.
+		if (block->isOutdated())
+			this->_blockCache.invalidate(key);
+		if (isChecked)
+			this->onBlockEnd(cycles, this->instructionCount - instructionsBefore);
+		return cycles;
+	}
+
+	unsigned CPU::_runDecodedBlock(const Block &block)
+	{
+		unsigned cycles = 0;
+		for (const DecodedInstruction &instruction : block.instructions) {
+			if (_needsNZ[instruction.opcode])
+				this->_materializeNZ();
+			// The opcode has already been read when the block was translated.
+			this->_registers.pc++;
+			this->_hasIndexCrossedPageBoundary = false;
+			uint24_t valueAddr = this->_getValueAddr(instruction.addressingMode);
+			cycles += instruction.cycleCount + (this->*instruction.call)(valueAddr, instruction.addressingMode);
+			this->instructionCount++;
+			if (block.isOutdated())
+				break;
+		}
+		return cycles;
+	}
+}
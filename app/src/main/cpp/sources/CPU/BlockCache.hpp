@@ -0,0 +1,100 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "CPU/Instruction.hpp"
+#include "CPU/Recompiler.hpp"
+#include "Models/Ints.hpp"
+#include "Ram/Ram.hpp"
+
+namespace ComSquare::CPU
+{
+	//! @brief How the CPU runs the cartridge's code.
+	enum class ExecutionMode
+	{
+		//! @brief Fetch, decode and execute every instruction one at a time.
+		Interpreter,
+		//! @brief Decode blocks of instructions once and run them from the block cache.
+		BlockCache,
+		//! @brief Compile the blocks to x86-64 code and run it (the block cache is used on the other hosts).
+		Native,
+		//! @brief Run the blocks like Native but notify onBlockStart and onBlockEnd so they can be checked (see Differential::Differential).
+		Differential
+	};
+
+	//! @brief An instruction decoded when its block was translated.
+	struct DecodedInstruction
+	{
+		//! @brief The handler, already specialized for the m, x and e flags of the block.
+		InstructionHandler call = nullptr;
+		//! @brief The opcode of the instruction (used to check the block against the interpreter).
+		uint8_t opcode = 0;
+		//! @brief The base number of cycles of the instruction.
+		uint8_t cycleCount = 0;
+		//! @brief The size of the instruction and its operands.
+		uint8_t size = 0;
+		//! @brief The addressing mode of the instruction.
+		AddressingMode addressingMode = Implied;
+	};
+
+	//! @brief A straight list of instructions, decoded for a given value of the m, x and e flags.
+	struct Block
+	{
+		//! @brief The instructions of this block. Only the last one can change the program flow or the m, x and e flags.
+		std::vector<DecodedInstruction> instructions;
+		//! @brief The memory containing the code of this block or nullptr if the code can't be modified (in the ROM).
+		const Ram::Ram *memory = nullptr;
+		//! @brief The address of the code inside the memory (local to the memory).
+		uint24_t memoryAddress = 0;
+		//! @brief The version of the memory's page when the block was translated. If it changed, the block is outdated.
+		uint32_t version = 0;
+		//! @brief The native code of this block or nullptr if it has not been compiled.
+		NativeBlock native = nullptr;
+
+		//! @brief Check if the code of this block has been written to since it was translated.
+		[[nodiscard]] inline bool isOutdated() const
+		{
+			return this->memory && this->memory->getPageVersion(this->memoryAddress) != this->version;
+		}
+	};
+
+	//! @brief Cache of translated blocks indexed by their address and the m, x and e flags they were translated for.
+	class BlockCache
+	{
+	private:
+		//! @brief The translated blocks, indexed by getKey.
+		std::unordered_map<uint32_t, Block> _blocks;
+	public:
+		//! @brief The maximum number of instructions in a block.
+		static constexpr unsigned maxBlockSize = 32;
+
+		//! @brief Get the key of a block.
+		//! @param addr The 24 bits address of the first instruction of the block.
+		//! @param flags The m, x and e flags, as m | x << 1 | e << 2.
+		static constexpr uint32_t getKey(uint24_t addr, unsigned flags)
+		{
+			return addr | flags << 24u;
+		}
+
+		//! @brief Find a block that is still up to date.
+		//! @param key The key of the block (see getKey).
+		//! @return The block or nullptr if the block has never been translated or if it is outdated.
+		Block *find(uint32_t key);
+		//! @brief Store a newly translated block.
+		//! @param key The key of the block (see getKey).
+		//! @param block The translated block.
+		//! @return The stored block.
+		Block &insert(uint32_t key, Block block);
+		//! @brief Remove a block from the cache.
+		void invalidate(uint32_t key);
+		//! @brief Remove every block of the cache.
+		void clear();
+		//! @brief Get the number of blocks in the cache.
+		[[nodiscard]] size_t size() const;
+	};
+}
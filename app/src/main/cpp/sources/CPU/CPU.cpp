@@ -3,16 +3,19 @@
 //
 
 #include "CPU.hpp"
+#include "Exceptions/InvalidAction.hpp"
 #include "Exceptions/InvalidAddress.hpp"
 #include "Exceptions/InvalidOpcode.hpp"
 #include "Utility/Utility.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace ComSquare::CPU
 {
-	CPU::CPU(Memory::IMemoryBus &bus, Cartridge::Header &cartridgeHeader)
+	CPU::CPU(Memory::IMemoryBus &bus, Cartridge::Header &cartridgeHeader, Scheduler::Scheduler &scheduler)
 	    : _bus(bus),
 	      _cartridgeHeader(cartridgeHeader),
+	      _scheduler(scheduler),
 	      _dmaChannels({DMA(bus), DMA(bus), DMA(bus), DMA(bus), DMA(bus), DMA(bus), DMA(bus), DMA(bus)})
 	{
 		this->RESB();
@@ -30,6 +33,8 @@ namespace ComSquare::CPU
 	{
 		uint8_t tmp = 0;
 
+		if (addr >= 0x14 && addr <= 0x17)
+			this->_updateMathResult();
 		switch (addr) {
 		case 0x0:
 			return this->_internalRegisters.nmitimen;
@@ -62,11 +67,21 @@ namespace ComSquare::CPU
 		case 0xD:
 			return this->_internalRegisters.memsel;
 		case 0x10:
-			return this->_internalRegisters.rdnmi;
+			tmp = this->_internalRegisters.rdnmi;
+			// The NMI flag is cleared by the read and at the end of the vblank.
+			if (!this->_scheduler.isInVBlank())
+				tmp &= 0x7Fu;
+			this->_internalRegisters.rdnmi &= 0x7Fu;
+			return tmp;
 		case 0x11:
-			return this->_internalRegisters.timeup;
+			tmp = this->_internalRegisters.timeup;
+			this->_internalRegisters.timeup &= 0x7Fu;
+			this->IsIRQRequested = false;
+			return tmp;
 		case 0x12:
-			return this->_internalRegisters.hvbjoy;
+			return (this->_internalRegisters.hvbjoy & 0x3Fu)
+				| this->_scheduler.isInVBlank() << 7u
+				| this->_scheduler.isInHBlank() << 6u;
 		case 0x13:
 			return this->_internalRegisters.rdio;
 		case 0x14:
@@ -104,7 +119,15 @@ namespace ComSquare::CPU
 	{
 		switch (addr) {
 		case 0x0:
+			// Enabling the NMI during the vblank triggers it immediately if it has not been acknowledged.
+			if (~this->_internalRegisters.nmitimen & data & 0x80u && this->_internalRegisters.rdnmi & 0x80u && this->_scheduler.isInVBlank())
+				this->IsNMIRequested = true;
 			this->_internalRegisters.nmitimen = data;
+			if (!(data & 0x30u)) {
+				this->_internalRegisters.timeup &= 0x7Fu;
+				this->IsIRQRequested = false;
+			}
+			this->_scheduleTimerIRQ(this->_scheduler.getTimestamp());
 			break;
 		case 0x1:
 			this->_internalRegisters.wrio = data;
@@ -114,6 +137,7 @@ namespace ComSquare::CPU
 			break;
 		case 0x3:
 			this->_internalRegisters.wrmpyb = data;
+			this->_startMathOperation(MathOperation::Multiply);
 			break;
 		case 0x4:
 			this->_internalRegisters.wrdivl = data;
@@ -123,18 +147,23 @@ namespace ComSquare::CPU
 			break;
 		case 0x6:
 			this->_internalRegisters.wrdivb = data;
+			this->_startMathOperation(MathOperation::Divide);
 			break;
 		case 0x7:
 			this->_internalRegisters.htimel = data;
+			this->_scheduleTimerIRQ(this->_scheduler.getTimestamp());
 			break;
 		case 0x8:
 			this->_internalRegisters.htimeh = data;
+			this->_scheduleTimerIRQ(this->_scheduler.getTimestamp());
 			break;
 		case 0x9:
 			this->_internalRegisters.vtimel = data;
+			this->_scheduleTimerIRQ(this->_scheduler.getTimestamp());
 			break;
 		case 0xA:
 			this->_internalRegisters.vtimeh = data;
+			this->_scheduleTimerIRQ(this->_scheduler.getTimestamp());
 			break;
 		case 0xB:
 			for (int i = 0; i < 8; i++)
@@ -202,6 +231,54 @@ namespace ComSquare::CPU
 		}
 	}
 
+	void CPU::saveState(SaveState::SaveState &state) const
+	{
+		state.write(this->_registers);
+		state.write(this->_internalRegisters);
+		state.write(this->_isEmulationMode);
+		state.write(this->_isStopped);
+		state.write(this->_isWaitingForInterrupt);
+		state.write(this->_lazyResult);
+		state.write(this->_lazyNegativeMask);
+		state.write(this->_hasLazyNZ);
+		state.write(this->IsNMIRequested);
+		state.write(this->IsIRQRequested);
+		state.write(this->IsAbortRequested);
+		state.write(this->_mathOperation);
+		state.write(this->_mathOperandA);
+		state.write(this->_mathOperandB);
+		state.write(this->_mathCompletion);
+		for (const DMA &channel : this->_dmaChannels)
+			channel.saveState(state);
+	}
+
+	void CPU::loadState(SaveState::SaveState &state)
+	{
+		state.read(this->_registers);
+		state.read(this->_internalRegisters);
+		state.read(this->_isEmulationMode);
+		state.read(this->_isStopped);
+		state.read(this->_isWaitingForInterrupt);
+		state.read(this->_lazyResult);
+		state.read(this->_lazyNegativeMask);
+		state.read(this->_hasLazyNZ);
+		state.read(this->IsNMIRequested);
+		state.read(this->IsIRQRequested);
+		state.read(this->IsAbortRequested);
+		state.read(this->_mathOperation);
+		state.read(this->_mathOperandA);
+		state.read(this->_mathOperandB);
+		state.read(this->_mathCompletion);
+		for (DMA &channel : this->_dmaChannels)
+			channel.loadState(state);
+
+		this->_updateDispatchTable();
+		this->_blockCache.clear();
+		this->_recompiler.clear();
+		this->_idleLoopStart = -1;
+		this->_isIdling = false;
+	}
+
 	uint24_t CPU::getSize() const
 	{
 		return 0x180;
@@ -212,23 +289,269 @@ namespace ComSquare::CPU
 		if (this->isDisabled)
 			return 0xFF;
 		unsigned cycles = this->runDMA(maxCycles);
+		this->_advanceClock(cycles);
 
 		while (cycles < maxCycles) {
 			if (this->_isStopped) {
-				cycles += 1;
-				continue;
+				this->_advanceClock(maxCycles - cycles);
+				cycles = maxCycles;
+				break;
 			}
 
 			this->_checkInterrupts();
 
-			if (!this->_isWaitingForInterrupt)
-				cycles += this->executeInstruction();
-			else
+			if (this->_isWaitingForInterrupt) {
+				// The clock keeps running, the timer and vblank events are what wake the CPU up.
+				if (cycles < 0xFF)
+					this->_advanceClock(0xFF - cycles);
 				return 0xFF;
+			}
+			unsigned elapsed = this->executionMode == ExecutionMode::Interpreter
+				? this->executeInstruction()
+				: this->_executeBlock();
+			cycles += elapsed;
+			this->_advanceClock(elapsed);
+
+			if (this->_isIdling) {
+				// Nothing can change the outcome of the loop until an event fires, the clock jumps to it even past the
+				// budget of this update. The APU only runs between the updates, a loop waiting for it stops at the budget.
+				this->_isIdling = false;
+				uint64_t skipped = this->_getCyclesUntilWakeUp();
+				if (this->_idleLoopWakeUp == IdleLoopWakeUp::EndOfUpdate)
+					skipped = std::min<uint64_t>(skipped, cycles < maxCycles ? maxCycles - cycles : 0);
+				if (skipped) {
+					this->idleLoopStatistics.skippedLoops++;
+					this->idleLoopStatistics.skippedCycles += skipped;
+					cycles += skipped;
+					this->_advanceClock(skipped);
+				}
+			}
 		}
+		this->_materializeNZ();
 		return cycles;
 	}
 
+	void CPU::_branch(int offset)
+	{
+		uint16_t loopEnd = this->_registers.pc;
+		this->_registers.pc += offset;
+		if (offset < 0)
+			this->_detectIdleLoop(loopEnd);
+	}
+
+	void CPU::_detectIdleLoop(uint16_t loopEnd)
+	{
+		if (!this->isIdleLoopSkippingEnabled)
+			return;
+		this->_materializeNZ();
+		const Registers &regs = this->_registers;
+		const Registers &last = this->_idleLoopRegisters;
+		if (this->_idleLoopStart == static_cast<int32_t>(regs.pac)
+		    && regs.a == last.a && regs.x == last.x && regs.y == last.y
+		    && regs.p.flags == last.p.flags && regs.d == last.d && regs.dbr == last.dbr && regs.s == last.s) {
+			this->_isIdling = true;
+			return;
+		}
+		IdleLoopWakeUp wakeUp = IdleLoopWakeUp::NextEvent;
+		if (static_cast<uint16_t>(loopEnd - regs.pc) > _maxIdleLoopSize || !this->_isIdleLoopBody(loopEnd, wakeUp)) {
+			this->_idleLoopStart = -1;
+			return;
+		}
+		this->_idleLoopWakeUp = wakeUp;
+		this->_idleLoopStart = static_cast<int32_t>(regs.pac);
+		this->_idleLoopRegisters = regs;
+	}
+
+	bool CPU::_isIdleLoopBody(uint16_t loopEnd, IdleLoopWakeUp &wakeUp)
+	{
+		// Instructions that give the same result when they are run twice with the same inputs.
+		static constexpr InstructionHandler idempotentHandlers[] = {
+			&CPU::LDA, &CPU::LDX, &CPU::LDY, &CPU::AND, &CPU::ORA, &CPU::BIT,
+			&CPU::CMP, &CPU::CPX, &CPU::CPY, &CPU::NOP, &CPU::JMP,
+			&CPU::BCC, &CPU::BCS, &CPU::BEQ, &CPU::BNE, &CPU::BMI, &CPU::BPL, &CPU::BVC, &CPU::BVS, &CPU::BRA,
+		};
+
+		uint16_t loopStart = this->_registers.pc;
+		for (uint16_t pc = loopStart; pc < loopEnd;) {
+			uint24_t addr = (this->_registers.pbr << 16u) + pc;
+			const Instruction &instruction = instructions[this->getBus().peek_v(addr)];
+			if (std::find(std::begin(idempotentHandlers), std::end(idempotentHandlers), instruction.call) == std::end(idempotentHandlers))
+				return false;
+
+			unsigned size = this->_getInstructionSize(instruction);
+			switch (instruction.addressingMode) {
+			case Implied:
+				break;
+			case Immediate8bits:
+				// Branches exiting the loop are fine but they should not jump to code that has not been checked.
+				if (static_cast<uint16_t>(pc + size + static_cast<int8_t>(this->getBus().peek_v(addr + 1))) < loopStart)
+					return false;
+				break;
+			case ImmediateForA:
+			case ImmediateForX:
+				break;
+			case Absolute:
+				if (instruction.call == static_cast<InstructionHandler>(&CPU::JMP)) {
+					if (this->getBus().peek_v(addr + 1) + (this->getBus().peek_v(addr + 2) << 8u) < loopStart)
+						return false;
+					break;
+				}
+				if (!_isStatusRegister((this->_registers.dbr << 16u) + this->getBus().peek_v(addr + 1) + (this->getBus().peek_v(addr + 2) << 8u), wakeUp))
+					return false;
+				break;
+			case AbsoluteLong:
+				if (!_isStatusRegister(this->getBus().peek_v(addr + 1) + (this->getBus().peek_v(addr + 2) << 8u) + (this->getBus().peek_v(addr + 3) << 16u), wakeUp))
+					return false;
+				break;
+			default:
+				return false;
+			}
+			pc += size;
+		}
+		return true;
+	}
+
+	bool CPU::_isStatusRegister(uint24_t addr, IdleLoopWakeUp &wakeUp)
+	{
+		// Registers are only mapped in the banks $00-$3F and $80-$BF.
+		if ((addr >> 16u & 0x7Fu) >= 0x40)
+			return false;
+		switch (addr & 0xFFFFu) {
+		// APU ports, only written by the APU.
+		case 0x2140 ... 0x2143:
+			wakeUp = IdleLoopWakeUp::EndOfUpdate;
+			return true;
+		// HVBJOY, updated by the PPU timings.
+		case 0x4212:
+			wakeUp = std::max(wakeUp, IdleLoopWakeUp::NextScanline);
+			return true;
+		// RDNMI and TIMEUP, only set by the vblank and the timer events.
+		case 0x4210 ... 0x4211:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void CPU::_advanceClock(unsigned cycles)
+	{
+		this->_scheduler.advance(static_cast<uint64_t>(cycles) * Scheduler::Scheduler::masterCyclesPerCPUCycle);
+		if (this->_scheduler.hasDueEvent())
+			this->_runEvents();
+	}
+
+	void CPU::_runEvents()
+	{
+		uint64_t timestamp = this->_scheduler.getEventTimestamp(Scheduler::TimerIRQ);
+		if (this->_scheduler.consume(Scheduler::TimerIRQ)) {
+			this->_internalRegisters.timeup |= 0x80u;
+			this->IsIRQRequested = true;
+			this->_scheduleTimerIRQ(timestamp);
+		}
+		timestamp = this->_scheduler.getEventTimestamp(Scheduler::VBlank);
+		if (this->_scheduler.consume(Scheduler::VBlank)) {
+			this->_internalRegisters.rdnmi |= 0x80u;
+			if (this->_internalRegisters.nmitimen & 0x80u)
+				this->IsNMIRequested = true;
+			this->_scheduleVBlank(timestamp);
+		}
+	}
+
+	uint64_t CPU::_getCyclesUntilWakeUp() const
+	{
+		uint64_t now = this->_scheduler.getTimestamp();
+		// The vblank flags are also cleared at the end of the frame, and the frame loop stops there.
+		uint64_t frameEnd = Scheduler::Scheduler::getFrameStart(now) + Scheduler::Scheduler::masterCyclesPerFrame;
+		uint64_t wakeUp = std::min(this->_scheduler.getNextEventTimestamp(), frameEnd);
+		if (this->_idleLoopWakeUp == IdleLoopWakeUp::NextScanline) {
+			uint64_t lineStart = Scheduler::Scheduler::getLineStart(now);
+			uint64_t hblank = lineStart + Scheduler::Scheduler::hblankStartDot * Scheduler::Scheduler::masterCyclesPerDot;
+			wakeUp = std::min(wakeUp, now < hblank ? hblank : lineStart + Scheduler::Scheduler::masterCyclesPerLine);
+		}
+		if (wakeUp <= now)
+			return 0;
+		constexpr unsigned cycleLength = Scheduler::Scheduler::masterCyclesPerCPUCycle;
+		return (wakeUp - now + cycleLength - 1) / cycleLength;
+	}
+
+	void CPU::_scheduleTimerIRQ(uint64_t after)
+	{
+		unsigned mode = this->_internalRegisters.nmitimen >> 4u & 0b11u;
+		unsigned htime = this->_internalRegisters.htimel | (this->_internalRegisters.htimeh & 0b1u) << 8u;
+		unsigned vtime = this->_internalRegisters.vtimel | (this->_internalRegisters.vtimeh & 0b1u) << 8u;
+		bool hasHTime = mode & 0b01u;
+		bool hasVTime = mode & 0b10u;
+
+		if (!mode || (hasHTime && htime >= Scheduler::Scheduler::dotsPerLine) || (hasVTime && vtime >= Scheduler::Scheduler::linesPerFrame)) {
+			this->_scheduler.cancel(Scheduler::TimerIRQ);
+			return;
+		}
+		uint64_t dot = hasHTime ? htime * Scheduler::Scheduler::masterCyclesPerDot : 0;
+		uint64_t timestamp;
+		if (!hasVTime) {
+			// H timer only: fires on every scanline.
+			timestamp = Scheduler::Scheduler::getLineStart(after) + dot;
+			if (timestamp <= after)
+				timestamp += Scheduler::Scheduler::masterCyclesPerLine;
+		} else {
+			timestamp = Scheduler::Scheduler::getFrameStart(after) + vtime * Scheduler::Scheduler::masterCyclesPerLine + dot;
+			if (timestamp <= after)
+				timestamp += Scheduler::Scheduler::masterCyclesPerFrame;
+		}
+		this->_scheduler.schedule(Scheduler::TimerIRQ, timestamp);
+	}
+
+	void CPU::_scheduleVBlank(uint64_t after)
+	{
+		uint64_t timestamp = Scheduler::Scheduler::getFrameStart(after) + Scheduler::Scheduler::vblankStartLine * Scheduler::Scheduler::masterCyclesPerLine;
+		if (timestamp <= after)
+			timestamp += Scheduler::Scheduler::masterCyclesPerFrame;
+		this->_scheduler.schedule(Scheduler::VBlank, timestamp);
+	}
+
+	void CPU::_startMathOperation(MathOperation operation)
+	{
+		// The results of the previous operation stay readable until this one completes.
+		this->_updateMathResult();
+		unsigned cycles;
+		if (operation == MathOperation::Multiply) {
+			this->_mathOperandA = this->_internalRegisters.wrmpya;
+			this->_mathOperandB = this->_internalRegisters.wrmpyb;
+			cycles = _multiplyCycles;
+		} else {
+			this->_mathOperandA = this->_internalRegisters.wrdivl | this->_internalRegisters.wrdivh << 8u;
+			this->_mathOperandB = this->_internalRegisters.wrdivb;
+			cycles = _divideCycles;
+		}
+		this->_mathOperation = operation;
+		this->_mathCompletion = this->_scheduler.getTimestamp() + cycles * Scheduler::Scheduler::masterCyclesPerCPUCycle;
+	}
+
+	void CPU::_updateMathResult()
+	{
+		if (this->_mathOperation == MathOperation::None || this->_scheduler.getTimestamp() < this->_mathCompletion)
+			return;
+
+		uint16_t rddiv;
+		uint16_t rdmpy;
+		if (this->_mathOperation == MathOperation::Multiply) {
+			// The multiplier is shifted out of RDDIV during the operation.
+			rddiv = this->_mathOperandB;
+			rdmpy = this->_mathOperandA * this->_mathOperandB;
+		} else if (this->_mathOperandB == 0) {
+			rddiv = 0xFFFF;
+			rdmpy = this->_mathOperandA;
+		} else {
+			rddiv = this->_mathOperandA / this->_mathOperandB;
+			rdmpy = this->_mathOperandA % this->_mathOperandB;
+		}
+		this->_internalRegisters.rddivl = rddiv;
+		this->_internalRegisters.rddivh = rddiv >> 8u;
+		this->_internalRegisters.rdmpyl = rdmpy;
+		this->_internalRegisters.rdmpyh = rdmpy >> 8u;
+		this->_mathOperation = MathOperation::None;
+	}
+
 	void CPU::_checkInterrupts()
 	{
 		if (!this->IsNMIRequested && !this->IsIRQRequested && !this->IsAbortRequested)
@@ -236,6 +559,8 @@ namespace ComSquare::CPU
 		this->_isWaitingForInterrupt = false;
 
 		if (this->IsNMIRequested) {
+			// The NMI is edge triggered, the IRQ stays requested until TIMEUP is read.
+			this->IsNMIRequested = false;
 			this->_runInterrupt(
 			    this->_cartridgeHeader.nativeInterrupts.nmi,
 			    this->_cartridgeHeader.emulationInterrupts.nmi);
@@ -249,6 +574,33 @@ namespace ComSquare::CPU
 		}
 	}
 
+	void CPU::setJoypad(unsigned port, uint16_t buttons)
+	{
+		uint8_t low = buttons;
+		uint8_t high = buttons >> 8u;
+
+		switch (port) {
+		case 0:
+			this->_internalRegisters.joy1l = low;
+			this->_internalRegisters.joy1h = high;
+			break;
+		case 1:
+			this->_internalRegisters.joy2l = low;
+			this->_internalRegisters.joy2h = high;
+			break;
+		case 2:
+			this->_internalRegisters.joy3l = low;
+			this->_internalRegisters.joy3h = high;
+			break;
+		case 3:
+			this->_internalRegisters.joy4l = low;
+			this->_internalRegisters.joy4h = high;
+			break;
+		default:
+			throw InvalidAction("There are only 4 controller ports.");
+		}
+	}
+
 	unsigned CPU::runDMA(unsigned maxCycles)
 	{
 		unsigned cycles = 0;
@@ -261,9 +613,21 @@ namespace ComSquare::CPU
 		return cycles;
 	}
 
-	uint24_t CPU::_getValueAddr(const Instruction &instruction)
+	unsigned CPU::_getInstructionSize(const Instruction &instruction) const
 	{
 		switch (instruction.addressingMode) {
+		case ImmediateForA:
+			return instruction.size + !this->_registers.p.m;
+		case ImmediateForX:
+			return instruction.size + !this->_registers.p.x_b;
+		default:
+			return instruction.size;
+		}
+	}
+
+	uint24_t CPU::_getValueAddr(AddressingMode mode)
+	{
+		switch (mode) {
 		case Implied:
 			return 0;
 		case Immediate8bits:
@@ -274,6 +638,8 @@ namespace ComSquare::CPU
 			return this->_getImmediateAddrForA();
 		case ImmediateForX:
 			return this->_getImmediateAddrForX();
+		case BlockMove:
+			return this->_getBlockMoveBanks();
 
 		case Absolute:
 			return this->_getAbsoluteAddr();
@@ -322,11 +688,115 @@ namespace ComSquare::CPU
 
 	unsigned CPU::executeInstruction()
 	{
-		const Instruction &instruction = this->instructions[this->_readPC()];
+		uint8_t opcode = this->_readPC();
+		const Instruction &instruction = this->instructions[opcode];
+		if (_needsNZ[opcode])
+			this->_materializeNZ();
 		this->_hasIndexCrossedPageBoundary = false;
-		uint24_t valueAddr = this->_getValueAddr(instruction);
+		uint24_t valueAddr = this->_getValueAddr(instruction.addressingMode);
+
+		this->instructionCount++;
+		return instruction.cycleCount + (this->*(*this->_dispatchTable)[opcode])(valueAddr, instruction.addressingMode);
+	}
 
-		return instruction.cycleCount + (this->*instruction.call)(valueAddr, instruction.addressingMode);
+	template<bool m, bool x, bool e>
+	constexpr InstructionHandler CPU::_specializeHandler(InstructionHandler handler)
+	{
+		struct Specialization {
+			InstructionHandler generic;
+			InstructionHandler specialized;
+		};
+		const Specialization specializations[] = {
+			{&CPU::ADC, &CPU::ADC<m>},
+			{&CPU::SBC, &CPU::SBC<m>},
+			{&CPU::AND, &CPU::AND<m>},
+			{&CPU::ORA, &CPU::ORA<m>},
+			{&CPU::EOR, &CPU::EOR<m>},
+			{&CPU::CMP, &CPU::CMP<m>},
+			{&CPU::LDA, &CPU::LDA<m>},
+			{&CPU::STA, &CPU::STA<m>},
+			{&CPU::STZ, &CPU::STZ<m>},
+			{&CPU::PHA, &CPU::PHA<m>},
+			{&CPU::PLA, &CPU::PLA<m>},
+			{&CPU::LDX, &CPU::LDX<x>},
+			{&CPU::LDY, &CPU::LDY<x>},
+			{&CPU::STX, &CPU::STX<x>},
+			{&CPU::STY, &CPU::STY<x>},
+			{&CPU::CPX, &CPU::CPX<x>},
+			{&CPU::CPY, &CPU::CPY<x>},
+			{&CPU::INX, &CPU::INX<x>},
+			{&CPU::INY, &CPU::INY<x>},
+			{&CPU::DEX, &CPU::DEX<x>},
+			{&CPU::DEY, &CPU::DEY<x>},
+			{&CPU::PHX, &CPU::PHX<x>},
+			{&CPU::PHY, &CPU::PHY<x>},
+			{&CPU::PLX, &CPU::PLX<x>},
+			{&CPU::PLY, &CPU::PLY<x>},
+			{&CPU::BCC, &CPU::BCC<e>},
+			{&CPU::BCS, &CPU::BCS<e>},
+			{&CPU::BEQ, &CPU::BEQ<e>},
+			{&CPU::BNE, &CPU::BNE<e>},
+			{&CPU::BMI, &CPU::BMI<e>},
+			{&CPU::BPL, &CPU::BPL<e>},
+			{&CPU::BVC, &CPU::BVC<e>},
+			{&CPU::BVS, &CPU::BVS<e>},
+			{&CPU::BRA, &CPU::BRA<e>},
+		};
+
+		for (const auto &specialization : specializations)
+			if (specialization.generic == handler)
+				return specialization.specialized;
+		return handler;
+	}
+
+	template<bool m, bool x, bool e>
+	constexpr CPU::DispatchTable CPU::_makeDispatchTable()
+	{
+		DispatchTable table {};
+		for (unsigned i = 0; i < table.size(); i++)
+			table[i] = _specializeHandler<m, x, e>(instructions[i].call);
+		return table;
+	}
+
+	constexpr std::array<CPU::DispatchTable, 8> CPU::_dispatchTables = {
+		_makeDispatchTable<false, false, false>(),
+		_makeDispatchTable<true, false, false>(),
+		_makeDispatchTable<false, true, false>(),
+		_makeDispatchTable<true, true, false>(),
+		_makeDispatchTable<false, false, true>(),
+		_makeDispatchTable<true, false, true>(),
+		_makeDispatchTable<false, true, true>(),
+		_makeDispatchTable<true, true, true>(),
+	};
+
+	constexpr std::array<bool, 0x100> CPU::_needsNZ = [] {
+		// Handlers that overwrite both flags with _setLazyNZ or that do not use them at all.
+		constexpr InstructionHandler ignoringNZ[] = {
+			&CPU::ADC, &CPU::SBC, &CPU::AND, &CPU::ORA, &CPU::EOR, &CPU::CMP, &CPU::CPX, &CPU::CPY,
+			&CPU::LDA, &CPU::LDX, &CPU::LDY, &CPU::INX, &CPU::INY, &CPU::DEX, &CPU::DEY,
+			&CPU::PLA, &CPU::PLX, &CPU::PLY,
+			&CPU::STA, &CPU::STX, &CPU::STY, &CPU::STZ,
+			&CPU::PHA, &CPU::PHB, &CPU::PHD, &CPU::PHK, &CPU::PHX, &CPU::PHY, &CPU::PEA, &CPU::PEI, &CPU::PER,
+			&CPU::JMP, &CPU::JML, &CPU::JSR, &CPU::JSL, &CPU::RTS, &CPU::RTL,
+			&CPU::BCC, &CPU::BCS, &CPU::BVC, &CPU::BVS, &CPU::BRA, &CPU::BRL,
+			&CPU::CLC, &CPU::SEC, &CPU::CLI, &CPU::SEI, &CPU::CLD, &CPU::SED, &CPU::CLV,
+			&CPU::TCS, &CPU::XCE, &CPU::MVN, &CPU::MVP, &CPU::NOP, &CPU::WDM, &CPU::STP,
+		};
+
+		std::array<bool, 0x100> ret {};
+		for (unsigned i = 0; i < ret.size(); i++) {
+			ret[i] = true;
+			for (InstructionHandler handler : ignoringNZ)
+				if (instructions[i].call == handler)
+					ret[i] = false;
+		}
+		return ret;
+	}();
+
+	void CPU::_updateDispatchTable()
+	{
+		unsigned index = this->_registers.p.m | this->_registers.p.x_b << 1u | this->_isEmulationMode << 2u;
+		this->_dispatchTable = &_dispatchTables[index];
 	}
 
 	void CPU::_push(uint8_t data)
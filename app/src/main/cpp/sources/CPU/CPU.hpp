@@ -4,7 +4,8 @@
 
 #pragma once
 
-
+#include <array>
+#include <string_view>
 #include "Memory/AMemory.hpp"
 #include "Memory/MemoryBus.hpp"
 #include "Models/Ints.hpp"
@@ -14,14 +15,49 @@
 #include "Instruction.hpp"
 #include "DMA/DMA.hpp"
 #include "CPU/Registers.hpp"
+#include "CPU/BlockCache.hpp"
+#include "Scheduler/Scheduler.hpp"
 
 #ifdef DEBUGGER_ENABLED
 #include "Debugger/CPU/CPUDebug.hpp"
 #include "Debugger/RegisterViewer.hpp"
 #endif
 
+namespace ComSquare::Differential
+{
+	class Differential;
+}
+
 namespace ComSquare::CPU
 {
+	//! @brief Statistics about the idle loops skipped by the CPU.
+	struct IdleLoopStatistics
+	{
+		//! @brief The number of times an idle loop has been skipped.
+		uint64_t skippedLoops = 0;
+		//! @brief The number of CPU cycles that were not run because of idle loops.
+		uint64_t skippedCycles = 0;
+	};
+
+	//! @brief What ends an idle loop, given the status registers it polls.
+	enum class IdleLoopWakeUp : uint8_t {
+		//! @brief The loop only polls RDNMI or TIMEUP (or nothing), it can only end on a scheduled event.
+		NextEvent,
+		//! @brief The loop polls HVBJOY, its hblank flag also changes at every scanline.
+		NextScanline,
+		//! @brief The loop polls the APU ports, the APU can write them at any time.
+		EndOfUpdate
+	};
+
+	//! @brief The operations of the hardware math unit.
+	enum class MathOperation : uint8_t {
+		None,
+		//! @brief Started by a write to WRMPYB.
+		Multiply,
+		//! @brief Started by a write to WRDIVB.
+		Divide
+	};
+
 	//! @brief The main CPU
 	class CPU : public Memory::AMemory
 	{
@@ -42,6 +78,8 @@ namespace ComSquare::CPU
 		std::reference_wrapper<Memory::IMemoryBus> _bus;
 		//! @brief The cartridge header (stored for interrupt vectors..)
 		Cartridge::Header &_cartridgeHeader;
+		//! @brief The master clock, advanced by this CPU after each instruction.
+		Scheduler::Scheduler &_scheduler;
 
 		//! @brief DMA channels witch are mapped to the bus.
 		std::array<DMA, 8> _dmaChannels;
@@ -49,6 +87,75 @@ namespace ComSquare::CPU
 		//! @brief True if an addressing mode with an iterator (x, y) has crossed the page. (Used because crossing the page boundary take one more cycle to run certain instructions).
 		bool _hasIndexCrossedPageBoundary = false;
 
+		//! @brief A list of handlers indexed by opcode.
+		using DispatchTable = std::array<InstructionHandler, 0x100>;
+		//! @brief The dispatch tables for every combination of flags, indexed by m | x << 1 | e << 2.
+		static const std::array<DispatchTable, 8> _dispatchTables;
+		//! @brief The dispatch table specialized for the current m, x and e flags.
+		//! @info This table is only valid if _updateDispatchTable has been called after the last change of those flags.
+		const DispatchTable *_dispatchTable = nullptr;
+		//! @brief Select the dispatch table matching the current m, x and e flags.
+		void _updateDispatchTable();
+		//! @brief Get the handler to use for an instruction when the m, x and e flags have the given values.
+		//! @param handler The generic handler of the instruction (the one checking the flags at runtime).
+		//! @return The specialized version of the handler or the handler itself if it does not depend on those flags.
+		template<bool m, bool x, bool e>
+		static constexpr InstructionHandler _specializeHandler(InstructionHandler handler);
+		//! @brief Create the dispatch table of the given flags from the generic instruction table.
+		template<bool m, bool x, bool e>
+		static constexpr DispatchTable _makeDispatchTable();
+
+		//! @brief The last result the n and z flags depend on (only used when _hasLazyNZ is true).
+		uint16_t _lazyResult = 0;
+		//! @brief The bits of _lazyResult that set the n flag.
+		uint16_t _lazyNegativeMask = 0;
+		//! @brief True if the n and z flags of the status register are outdated and should be computed from _lazyResult.
+		bool _hasLazyNZ = false;
+		//! @brief For each opcode, true if the instruction reads or partially updates the n and z flags (so they have to be materialized before it runs).
+		static const std::array<bool, 0x100> _needsNZ;
+
+		//! @brief Defer the computation of the n and z flags: z is set if the result is 0 and n if any bit of the negative mask is set.
+		inline void _setLazyNZ(uint16_t result, uint16_t negativeMask)
+		{
+			this->_lazyResult = result;
+			this->_lazyNegativeMask = negativeMask;
+			this->_hasLazyNZ = true;
+		}
+
+		//! @brief Write the deferred n and z flags to the status register.
+		//! @info This must be called before anything outside of the dispatch loop reads the status register (the generic handlers call it too).
+		inline void _materializeNZ()
+		{
+			if (!this->_hasLazyNZ)
+				return;
+			this->_registers.p.z = this->_lazyResult == 0;
+			this->_registers.p.n = this->_lazyResult & this->_lazyNegativeMask;
+			this->_hasLazyNZ = false;
+		}
+
+		//! @brief The maximum size (in bytes) of a loop that can be detected as idle.
+		static constexpr unsigned _maxIdleLoopSize = 16;
+		//! @brief The address of the start of the last backward jump that may be an idle loop (or -1 if there is none).
+		int32_t _idleLoopStart = -1;
+		//! @brief The registers at the end of the last iteration of the possible idle loop.
+		Registers _idleLoopRegisters {};
+		//! @brief What can end the possible idle loop.
+		IdleLoopWakeUp _idleLoopWakeUp = IdleLoopWakeUp::NextEvent;
+		//! @brief True if the current loop has been detected as idle and the clock can jump to its wake up (see _getCyclesUntilWakeUp).
+		bool _isIdling = false;
+		//! @brief Add a relative offset to the program counter and look for idle loops if the jump goes backward.
+		void _branch(int offset);
+		//! @brief Check if the loop that just jumped backward is an idle loop.
+		//! @param loopEnd The address (in the program bank) after the instruction that jumped backward.
+		//! @info A loop is idle if the same iteration ran twice in a row and it only reads status registers.
+		void _detectIdleLoop(uint16_t loopEnd);
+		//! @brief Check if every instruction between the program counter and loopEnd can be part of an idle loop.
+		//! @param wakeUp Set to what can end the loop, from the registers it polls.
+		bool _isIdleLoopBody(uint16_t loopEnd, IdleLoopWakeUp &wakeUp);
+		//! @brief Check if the address is a register that can only change when another component is updated.
+		//! @param wakeUp Raised to what can change this register.
+		static bool _isStatusRegister(uint24_t addr, IdleLoopWakeUp &wakeUp);
+
 		//! @brief Immediate address mode is specified with a value in 8 bits. (This functions returns the 24bit space address of the value).
 		uint24_t _getImmediateAddr8Bits();
 		//! @brief Immediate address mode is specified with a value in 16 bits. (This functions returns the 24bit space address of the value).
@@ -57,6 +164,8 @@ namespace ComSquare::CPU
 		uint24_t _getImmediateAddrForA();
 		//! @brief Immediate address mode is specified with a value in 8 or 16 bits. The value is 16 bits if the x flag is unset. (This functions returns the 24bit space address of the value).
 		uint24_t _getImmediateAddrForX();
+		//! @brief The two banks of a block move (MVN/MVP) follow the opcode, the destination first. (This functions returns the source bank in the low byte and the destination bank in the high byte).
+		uint24_t _getBlockMoveBanks();
 		//! @brief The destination is formed by adding the direct page register with the 8-bit address to form an effective address. (This functions returns the 24bit space address of the value).
 		uint24_t _getDirectAddr();
 		//! @brief The effective address is formed by DBR:<16-bit exp>. (This functions returns the 24bit space address of the value).
@@ -116,10 +225,65 @@ namespace ComSquare::CPU
 		//! @brief Run an interrupt (save state of the processor and jump to the interrupt handler)
 		void _runInterrupt(uint24_t nativeHandler, uint24_t emulationHandler);
 
+		//! @brief Advance the master clock and handle the events that became due.
+		//! @param cycles The number of CPU cycles elapsed.
+		void _advanceClock(unsigned cycles);
+		//! @brief Handle the timer IRQ and the vblank if they are due.
+		void _runEvents();
+		//! @brief Get the number of CPU cycles before the idle loop can end: the next scheduled event or the end of the frame
+		//! (or the next edge of the hblank if the loop polls HVBJOY).
+		[[nodiscard]] uint64_t _getCyclesUntilWakeUp() const;
+		//! @brief Compute the next time the H/V timer fires from NMITIMEN, HTIME and VTIME and schedule it.
+		//! @param after The timer is scheduled strictly after this timestamp.
+		void _scheduleTimerIRQ(uint64_t after);
+		//! @brief Schedule the start of the next vertical blank strictly after the given timestamp.
+		void _scheduleVBlank(uint64_t after);
+
+		//! @brief The number of CPU cycles the math unit takes to multiply.
+		static constexpr unsigned _multiplyCycles = 8;
+		//! @brief The number of CPU cycles the math unit takes to divide.
+		static constexpr unsigned _divideCycles = 16;
+		//! @brief The operation of the math unit whose result has not been written to RDDIV and RDMPY yet.
+		MathOperation _mathOperation = MathOperation::None;
+		//! @brief The multiplicand or the dividend of this operation.
+		uint16_t _mathOperandA = 0;
+		//! @brief The multiplier or the divisor of this operation.
+		uint8_t _mathOperandB = 0;
+		//! @brief The master cycle timestamp at which this operation completes.
+		uint64_t _mathCompletion = 0;
+		//! @brief Record the operands of a math operation. The result is only computed when RDDIV or RDMPY is read.
+		void _startMathOperation(MathOperation operation);
+		//! @brief Write the result of the pending math operation to RDDIV and RDMPY if it has completed.
+		//! @info Reading the results before the completion returns the results of the previous operation.
+		void _updateMathResult();
+
 		//! @brief Get the parameter address of an instruction from it's addressing mode.
 		//! @info The current program counter should point to the instruction's opcode + 1.
 		//! @return The address of the data to read on the instruction.
-		uint24_t _getValueAddr(const Instruction &instruction);
+		uint24_t _getValueAddr(AddressingMode mode);
+		//! @brief Get the size (in bytes) of an instruction with the current m and x flags.
+		[[nodiscard]] unsigned _getInstructionSize(const Instruction &instruction) const;
+
+		//! @brief The translated blocks of this CPU (used when executionMode is not Interpreter).
+		BlockCache _blockCache;
+		//! @brief The native code of the blocks (used when executionMode is Native).
+		Recompiler _recompiler;
+		//! @brief Run the block of instructions starting at the program counter, translating it first if needed.
+		//! @return The number of CPU cycles that the block took.
+		unsigned _executeBlock();
+		//! @brief Run the decoded instructions of a block one after the other.
+		//! @return The number of CPU cycles that the block took.
+		unsigned _runDecodedBlock(const Block &block);
+		//! @brief Compile a block to x86-64 code that calls the handlers directly and runs the simplest instructions inline.
+		//! @param key The key of the block in the block cache.
+		//! @return The native code or nullptr if the code buffer is full.
+		NativeBlock _compileBlock(const Block &block, uint32_t key);
+		//! @brief Decode the instructions starting at the program counter and store them in the block cache.
+		//! @param key The key of the block in the block cache.
+		//! @return The new block or nullptr if the code can't be cached.
+		Block *_translateBlock(uint32_t key);
+		//! @brief Check if an instruction stops a block (because it changes the program flow or the m, x and e flags).
+		static bool _endsBlock(InstructionHandler handler);
 
 		//! @brief Break instruction - Causes a software break. The PC is loaded from a vector table.
 		int BRK(uint24_t, AddressingMode);
@@ -312,6 +476,49 @@ namespace ComSquare::CPU
 		//! @param C_register (16 bits accumulator) Length -1
 		int MVP(uint24_t, AddressingMode);
 
+		//! @brief Versions of the instructions above specialized for the m flag (size of the accumulator).
+		//! @tparam is8Bits The value of the m flag.
+		template<bool is8Bits> int ADC(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int SBC(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int AND(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int ORA(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int EOR(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int CMP(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int LDA(uint24_t addr, AddressingMode mode);
+		template<bool is8Bits> int STA(uint24_t addr, AddressingMode mode);
+		template<bool is8Bits> int STZ(uint24_t addr, AddressingMode mode);
+		template<bool is8Bits> int PHA(uint24_t, AddressingMode);
+		template<bool is8Bits> int PLA(uint24_t, AddressingMode);
+
+		//! @brief Versions of the instructions above specialized for the x flag (size of the index registers).
+		//! @tparam is8Bits The value of the x flag.
+		template<bool is8Bits> int LDX(uint24_t addr, AddressingMode mode);
+		template<bool is8Bits> int LDY(uint24_t addr, AddressingMode mode);
+		template<bool is8Bits> int STX(uint24_t addr, AddressingMode mode);
+		template<bool is8Bits> int STY(uint24_t addr, AddressingMode mode);
+		template<bool is8Bits> int CPX(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int CPY(uint24_t valueAddr, AddressingMode mode);
+		template<bool is8Bits> int INX(uint24_t, AddressingMode);
+		template<bool is8Bits> int INY(uint24_t, AddressingMode);
+		template<bool is8Bits> int DEX(uint24_t, AddressingMode);
+		template<bool is8Bits> int DEY(uint24_t, AddressingMode);
+		template<bool is8Bits> int PHX(uint24_t, AddressingMode);
+		template<bool is8Bits> int PHY(uint24_t, AddressingMode);
+		template<bool is8Bits> int PLX(uint24_t, AddressingMode);
+		template<bool is8Bits> int PLY(uint24_t, AddressingMode);
+
+		//! @brief Versions of the branch instructions specialized for the emulation flag.
+		//! @tparam isEmulationMode The value of the e flag.
+		template<bool isEmulationMode> int BCC(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BCS(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BEQ(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BNE(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BMI(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BPL(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BVC(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BVS(uint24_t valueAddr, AddressingMode);
+		template<bool isEmulationMode> int BRA(uint24_t valueAddr, AddressingMode);
+
 	public:
 		//! @brief Get the memory bus used by this CPU.
 		[[nodiscard]] inline Memory::IMemoryBus &getBus()
@@ -322,271 +529,292 @@ namespace ComSquare::CPU
 		//! @param bus The bus to use.
 		void setBus(Memory::IMemoryBus &bus);
 
-		//! @brief All the instructions of the CPU.
+		//! @brief All the instructions of the CPU, only containing what is needed to run them.
 		//! @info Instructions are indexed by their opcode
-		const Instruction instructions[0x100] = {
-			{&CPU::BRK, 7, "brk", AddressingMode::Immediate8bits,                   2}, // 00
-			{&CPU::ORA, 6, "ora", AddressingMode::DirectPageIndirectIndexedByX,     2}, // 01
-			{&CPU::COP, 7, "cop", AddressingMode::Immediate8bits,                   2}, // 02
-			{&CPU::ORA, 4, "ora", AddressingMode::StackRelative,                    2}, // 03
-			{&CPU::TSB, 5, "tsb", AddressingMode::DirectPage,                       2}, // 04
-			{&CPU::ORA, 3, "ora", AddressingMode::DirectPage,                       2}, // 05
-			{&CPU::ASL, 5, "asl", AddressingMode::DirectPage,                       2}, // 06
-			{&CPU::ORA, 6, "ora", AddressingMode::DirectPageIndirectLong,           2}, // 07
-			{&CPU::PHP, 3, "php", AddressingMode::Implied,                          1}, // 08
-			{&CPU::ORA, 2, "ora", AddressingMode::ImmediateForA,                    2}, // 09
-			{&CPU::ASL, 2, "asl", AddressingMode::Implied,                          1}, // 0A
-			{&CPU::PHD, 4, "phd", AddressingMode::Implied,                          1}, // 0B
-			{&CPU::TSB, 6, "tsb", AddressingMode::Absolute,                         3}, // 0C
-			{&CPU::ORA, 3, "ora", AddressingMode::Absolute,                         4}, // 0D
-			{&CPU::ASL, 6, "asl", AddressingMode::Absolute,                         3}, // 0E
-			{&CPU::ORA, 5, "ora", AddressingMode::AbsoluteLong,                     5}, // 0F
-			{&CPU::BPL, 7, "bpl", AddressingMode::Immediate8bits,                   2}, // 10
-			{&CPU::ORA, 5, "ora", AddressingMode::DirectPageIndirectIndexedByY,     2}, // 11
-			{&CPU::ORA, 5, "ora", AddressingMode::DirectPageIndirect,               2}, // 12
-			{&CPU::ORA, 7, "ora", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 13
-			{&CPU::TRB, 5, "trb", AddressingMode::DirectPage,                       2}, // 14
-			{&CPU::ORA, 4, "ora", AddressingMode::DirectPageIndexedByX,             2}, // 15
-			{&CPU::ASL, 6, "asl", AddressingMode::DirectPageIndexedByX,             2}, // 16
-			{&CPU::ORA, 6, "ora", AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 17
-			{&CPU::CLC, 2, "clc", AddressingMode::Implied,                          1}, // 18
-			{&CPU::ORA, 4, "ora", AddressingMode::AbsoluteIndexedByY,               3}, // 19
-			{&CPU::INC, 2, "inc", AddressingMode::Implied,                          1}, // 1A
-			{&CPU::TCS, 2, "tcs", AddressingMode::Implied,                          1}, // 1B
-			{&CPU::TRB, 6, "trb", AddressingMode::Absolute,                         3}, // 1C
-			{&CPU::ORA, 4, "ora", AddressingMode::AbsoluteIndexedByX,               3}, // 1D
-			{&CPU::ASL, 7, "asl", AddressingMode::AbsoluteIndexedByX,               3}, // 1E
-			{&CPU::ORA, 5, "ora", AddressingMode::AbsoluteIndexedByXLong,           4}, // 1F
-			{&CPU::JSR, 6, "jsr", AddressingMode::Absolute,                         3}, // 20
-			{&CPU::AND, 6, "and", AddressingMode::DirectPageIndirectIndexedByX,     2}, // 21
-			{&CPU::JSL, 8, "jsl", AddressingMode::AbsoluteLong,                     4}, // 22
-			{&CPU::AND, 4, "and", AddressingMode::StackRelative,                    2}, // 23
-			{&CPU::BIT, 3, "bit", AddressingMode::DirectPage,                       2}, // 24
-			{&CPU::AND, 3, "and", AddressingMode::DirectPage,                       2}, // 25
-			{&CPU::ROL, 5, "rol", AddressingMode::DirectPage,                       2}, // 26
-			{&CPU::AND, 6, "and", AddressingMode::DirectPageIndirectLong,           2}, // 27
-			{&CPU::PLP, 4, "plp", AddressingMode::Implied,                          1}, // 28
-			{&CPU::AND, 2, "and", AddressingMode::ImmediateForA,                    2}, // 29
-			{&CPU::ROL, 2, "rol", AddressingMode::Implied,                          1}, // 2A
-			{&CPU::PLD, 5, "pld", AddressingMode::Implied,                          1}, // 2B
-			{&CPU::BIT, 4, "bit", AddressingMode::Absolute,                         3}, // 2C
-			{&CPU::AND, 4, "and", AddressingMode::Absolute,                         3}, // 2D
-			{&CPU::ROL, 6, "rol", AddressingMode::Absolute,                         3}, // 2E
-			{&CPU::AND, 5, "and", AddressingMode::AbsoluteLong,                     4}, // 2F
-			{&CPU::BMI, 2, "bmi", AddressingMode::Immediate8bits,                   2}, // 30
-			{&CPU::AND, 5, "and", AddressingMode::DirectPageIndirectIndexedByY,     2}, // 31
-			{&CPU::AND, 5, "and", AddressingMode::DirectPageIndirect,               2}, // 32
-			{&CPU::AND, 7, "and", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 33
-			{&CPU::BIT, 4, "bit", AddressingMode::DirectPageIndexedByX,             2}, // 34
-			{&CPU::AND, 4, "and", AddressingMode::DirectPageIndexedByX,             2}, // 35
-			{&CPU::ROL, 6, "rol", AddressingMode::DirectPageIndexedByX,             2}, // 36
-			{&CPU::AND, 6, "and", AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 37
-			{&CPU::SEC, 2, "sec", AddressingMode::Implied,                          1}, // 38
-			{&CPU::AND, 4, "and", AddressingMode::AbsoluteIndexedByY,               3}, // 39
-			{&CPU::DEC, 2, "dec", AddressingMode::Implied,                          1}, // 3A
-			{&CPU::TSC, 2, "tsc", AddressingMode::Implied,                          1}, // 3B
-			{&CPU::BIT, 4, "bit", AddressingMode::AbsoluteIndexedByX,               3}, // 3C
-			{&CPU::AND, 4, "and", AddressingMode::AbsoluteIndexedByX,               3}, // 3D
-			{&CPU::ROL, 7, "rol", AddressingMode::AbsoluteIndexedByX,               3}, // 3E
-			{&CPU::AND, 5, "and", AddressingMode::AbsoluteIndexedByXLong,           4}, // 3F
-			{&CPU::RTI, 6, "rti", AddressingMode::Implied,                          1}, // 40
-			{&CPU::EOR, 6, "eor", AddressingMode::DirectPageIndirectIndexedByX,     2}, // 41
-			{&CPU::WDM, 2, "wdm", AddressingMode::Immediate8bits,                   2}, // 42
-			{&CPU::EOR, 4, "eor", AddressingMode::StackRelative,                    2}, // 43
-			{&CPU::MVP, 0, "mvp", AddressingMode::Immediate16bits,                  3}, // 44
-			{&CPU::EOR, 3, "eor", AddressingMode::DirectPage,                       2}, // 45
-			{&CPU::LSR, 5, "lsr", AddressingMode::DirectPage,                       2}, // 46
-			{&CPU::EOR, 6, "eor", AddressingMode::DirectPageIndirectLong,           2}, // 47
-			{&CPU::PHA, 3, "pha", AddressingMode::Implied,                          1}, // 48
-			{&CPU::EOR, 2, "eor", AddressingMode::ImmediateForA,                    2}, // 49
-			{&CPU::LSR, 2, "lsr", AddressingMode::Implied,                          1}, // 4A
-			{&CPU::PHK, 3, "phk", AddressingMode::Implied,                          1}, // 4B
-			{&CPU::JMP, 3, "jmp", AddressingMode::Absolute,                         3}, // 4C
-			{&CPU::EOR, 4, "eor", AddressingMode::Absolute,                         3}, // 4D
-			{&CPU::LSR, 6, "lsr", AddressingMode::Absolute,                         3}, // 4E
-			{&CPU::EOR, 5, "eor", AddressingMode::AbsoluteLong,                     4}, // 4F
-			{&CPU::BVC, 2, "bvc", AddressingMode::Immediate8bits,                   2}, // 50
-			{&CPU::EOR, 5, "eor", AddressingMode::DirectPageIndirectIndexedByY,     2}, // 51
-			{&CPU::EOR, 5, "eor", AddressingMode::DirectPageIndirect,               2}, // 52
-			{&CPU::EOR, 4, "eor", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 53
-			{&CPU::MVN, 0, "mvn", AddressingMode::Immediate16bits,                  2}, // 54
-			{&CPU::EOR, 4, "eor", AddressingMode::DirectPageIndexedByX,             2}, // 55
-			{&CPU::LSR, 6, "lsr", AddressingMode::DirectPageIndexedByX,             2}, // 56
-			{&CPU::EOR, 6, "eor", AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 57
-			{&CPU::CLI, 2, "cli", AddressingMode::Implied,                          1}, // 58
-			{&CPU::EOR, 4, "eor", AddressingMode::AbsoluteIndexedByY,               3}, // 59
-			{&CPU::PHY, 3, "phy", AddressingMode::Implied,                          1}, // 5A
-			{&CPU::TCD, 2, "tcd", AddressingMode::Implied,                          1}, // 5B
-			{&CPU::JML, 4, "jml", AddressingMode::Implied,                          4}, // 5C
-			{&CPU::EOR, 4, "eor", AddressingMode::AbsoluteIndexedByX,               3}, // 5D
-			{&CPU::LSR, 7, "lsr", AddressingMode::AbsoluteIndexedByX,               3}, // 5E
-			{&CPU::EOR, 5, "eor", AddressingMode::AbsoluteIndexedByXLong,           4}, // 5F
-			{&CPU::RTS, 6, "rts", AddressingMode::Implied,                          1}, // 60
-			{&CPU::ADC, 6, "adc", AddressingMode::DirectPageIndirectIndexedByX,     2}, // 61
-			{&CPU::PER, 6, "per", AddressingMode::Immediate16bits,                  3}, // 62
-			{&CPU::ADC, 4, "adc", AddressingMode::StackRelative,                    2}, // 63
-			{&CPU::STZ, 3, "stz", AddressingMode::DirectPage,                       2}, // 64
-			{&CPU::ADC, 3, "adc", AddressingMode::DirectPage,                       2}, // 65
-			{&CPU::ROR, 5, "ror", AddressingMode::DirectPage,                       2}, // 66
-			{&CPU::ADC, 6, "adc", AddressingMode::DirectPageIndirectLong,           2}, // 67
-			{&CPU::PLA, 4, "pla", AddressingMode::Implied,                          1}, // 68
-			{&CPU::ADC, 2, "adc", AddressingMode::ImmediateForA,                    2}, // 69
-			{&CPU::ROR, 2, "ror", AddressingMode::Implied,                          1}, // 6A
-			{&CPU::RTL, 6, "rtl", AddressingMode::Implied,                          1}, // 6B
-			{&CPU::JMP, 5, "jmp", AddressingMode::AbsoluteIndirect,                 3}, // 6C
-			{&CPU::ADC, 4, "adc", AddressingMode::Absolute,                         3}, // 6D
-			{&CPU::ROR, 6, "ror", AddressingMode::Absolute,                         3}, // 6E
-			{&CPU::ADC, 5, "adc", AddressingMode::AbsoluteLong,                     4}, // 6F
-			{&CPU::BVS, 2, "bvs", AddressingMode::Immediate8bits,                   2}, // 70
-			{&CPU::ADC, 5, "adc", AddressingMode::DirectPageIndirectIndexedByY,     2}, // 71
-			{&CPU::ADC, 5, "adc", AddressingMode::DirectPageIndirect,               2}, // 72
-			{&CPU::ADC, 7, "adc", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 73
-			{&CPU::STZ, 4, "stz", AddressingMode::DirectPageIndexedByX,             2}, // 74
-			{&CPU::ADC, 4, "adc", AddressingMode::DirectPageIndexedByX,             2}, // 75
-			{&CPU::ROR, 6, "ror", AddressingMode::DirectPageIndexedByX,             2}, // 76
-			{&CPU::ADC, 6, "adc", AddressingMode::DirectPageIndirectIndexedByY,     2}, // 77
-			{&CPU::SEI, 2, "sei", AddressingMode::Implied,                          1}, // 78
-			{&CPU::ADC, 4, "adc", AddressingMode::AbsoluteIndexedByY,               2}, // 79
-			{&CPU::PLY, 4, "ply", AddressingMode::Implied,                          1}, // 7A
-			{&CPU::TDC, 2, "tdc", AddressingMode::Implied,                          1}, // 7B
-			{&CPU::JMP, 6, "jmp", AddressingMode::AbsoluteIndirectIndexedByX,       3}, // 7C
-			{&CPU::ADC, 4, "adc", AddressingMode::AbsoluteIndexedByX,               3}, // 7D
-			{&CPU::ROR, 7, "ror", AddressingMode::AbsoluteIndexedByX,               3}, // 7E
-			{&CPU::ADC, 5, "adc", AddressingMode::AbsoluteIndexedByXLong,           4}, // 7F
-			{&CPU::BRA, 3, "bra", AddressingMode::Immediate8bits,                   2}, // 80
-			{&CPU::STA, 6, "sta", AddressingMode::DirectPageIndexedByX,             2}, // 81
-			{&CPU::BRL, 4, "brl", AddressingMode::Absolute,                         3}, // 82
-			{&CPU::STA, 4, "sta", AddressingMode::StackRelative,                    2}, // 83
-			{&CPU::STY, 3, "sty", AddressingMode::DirectPage,                       2}, // 84
-			{&CPU::STA, 3, "sta", AddressingMode::DirectPage,                       2}, // 85
-			{&CPU::STX, 3, "stx", AddressingMode::DirectPage,                       2}, // 86
-			{&CPU::STA, 6, "sta", AddressingMode::DirectPageIndirectLong,           2}, // 87
-			{&CPU::DEY, 2, "dey", AddressingMode::Implied,                          1}, // 88
-			{&CPU::BIT, 2, "bit", AddressingMode::ImmediateForA,                    2}, // 89
-			{&CPU::TXA, 2, "txa", AddressingMode::Implied,                          2}, // 8A
-			{&CPU::PHB, 3, "phb", AddressingMode::Implied,                          1}, // 8B
-			{&CPU::STY, 4, "sty", AddressingMode::Absolute,                         3}, // 8C
-			{&CPU::STA, 4, "sta", AddressingMode::Absolute,                         3}, // 8D
-			{&CPU::STX, 4, "stx", AddressingMode::Absolute,                         3}, // 8E
-			{&CPU::STA, 5, "sta", AddressingMode::AbsoluteLong,                     4}, // 8F
-			{&CPU::BCC, 2, "bcc", AddressingMode::Immediate8bits,                   2}, // 90
-			{&CPU::STA, 6, "sta", AddressingMode::DirectPageIndirectIndexedByY,     2}, // 91
-			{&CPU::STA, 5, "sta", AddressingMode::DirectPageIndirect,               2}, // 92
-			{&CPU::STA, 7, "sta", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 93
-			{&CPU::STY, 4, "sty", AddressingMode::DirectPageIndirectIndexedByX,     2}, // 94
-			{&CPU::STA, 4, "sta", AddressingMode::DirectPageIndexedByX,             2}, // 95
-			{&CPU::STX, 4, "stx", AddressingMode::DirectPageIndexedByY,             2}, // 96
-			{&CPU::STA, 6, "sta", AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 97
-			{&CPU::TYA, 2, "tya", AddressingMode::Implied,                          1}, // 98
-			{&CPU::STA, 5, "sta", AddressingMode::AbsoluteIndexedByY,               3}, // 99
-			{&CPU::TXS, 2, "txs", AddressingMode::Implied,                          1}, // 9A
-			{&CPU::TXY, 2, "txy", AddressingMode::Implied,                          1}, // 9B
-			{&CPU::STZ, 4, "stz", AddressingMode::Absolute,                         3}, // 9C
-			{&CPU::STA, 5, "sta", AddressingMode::AbsoluteIndexedByX,               3}, // 9D
-			{&CPU::STZ, 5, "stz", AddressingMode::AbsoluteIndexedByX,               3}, // 9E
-			{&CPU::STA, 5, "sta", AddressingMode::AbsoluteIndexedByXLong,           4}, // 9F
-			{&CPU::LDY, 2, "ldy", AddressingMode::ImmediateForX,                    2}, // A0
-			{&CPU::LDA, 6, "lda", AddressingMode::DirectPageIndirectIndexedByX,     2}, // A1
-			{&CPU::LDX, 2, "ldx", AddressingMode::ImmediateForX,                    2}, // A2
-			{&CPU::LDA, 4, "lda", AddressingMode::StackRelative,                    2}, // A3
-			{&CPU::LDY, 3, "ldy", AddressingMode::DirectPage,                       2}, // A4
-			{&CPU::LDA, 3, "lda", AddressingMode::DirectPage,                       2}, // A5
-			{&CPU::LDX, 3, "ldx", AddressingMode::DirectPage,                       2}, // A6
-			{&CPU::LDA, 6, "lda", AddressingMode::DirectPageIndirectLong,           2}, // A7
-			{&CPU::TAY, 2, "tay", AddressingMode::Implied,                          1}, // A8
-			{&CPU::LDA, 2, "lda", AddressingMode::ImmediateForA,                    2}, // A9
-			{&CPU::TAX, 2, "tax", AddressingMode::Implied,                          1}, // AA
-			{&CPU::PLB, 4, "plb", AddressingMode::Implied,                          1}, // AB
-			{&CPU::LDY, 4, "ldy", AddressingMode::Absolute,                         4}, // AC
-			{&CPU::LDA, 4, "lda", AddressingMode::Absolute,                         3}, // AD
-			{&CPU::LDX, 4, "ldx", AddressingMode::Absolute,                         3}, // AE
-			{&CPU::LDA, 5, "lda", AddressingMode::AbsoluteLong,                     4}, // AF
-			{&CPU::BCS, 2, "bcs", AddressingMode::Immediate8bits,                   2}, // B0
-			{&CPU::LDA, 5, "lda", AddressingMode::DirectPageIndirectIndexedByY,     2}, // B1
-			{&CPU::LDA, 5, "lda", AddressingMode::DirectPageIndirect,               2}, // B2
-			{&CPU::LDA, 7, "lda", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // B3
-			{&CPU::LDY, 4, "ldy", AddressingMode::DirectPageIndexedByX,             2}, // B4
-			{&CPU::LDA, 4, "lda", AddressingMode::DirectPageIndexedByX,             2}, // B5
-			{&CPU::LDX, 4, "ldx", AddressingMode::DirectPageIndexedByY,             2}, // B6
-			{&CPU::LDA, 6, "lda", AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // B7
-			{&CPU::CLV, 7, "clv", AddressingMode::Implied,                          1}, // B8
-			{&CPU::LDA, 4, "lda", AddressingMode::AbsoluteIndexedByY,               3}, // B9
-			{&CPU::TSX, 2, "tsx", AddressingMode::Implied,                          1}, // BA
-			{&CPU::TYX, 2, "tyx", AddressingMode::Implied,                          1}, // BB
-			{&CPU::LDY, 4, "ldy", AddressingMode::AbsoluteIndexedByX,               3}, // BC
-			{&CPU::LDA, 4, "lda", AddressingMode::AbsoluteIndexedByX,               3}, // BD
-			{&CPU::LDX, 4, "ldx", AddressingMode::AbsoluteIndexedByY,               3}, // BE
-			{&CPU::LDA, 5, "lda", AddressingMode::AbsoluteIndexedByXLong,           4}, // BF
-			{&CPU::CPY, 2, "cpy", AddressingMode::ImmediateForX,                    2}, // C0
-			{&CPU::CMP, 6, "cmp", AddressingMode::DirectPageIndirectIndexedByX,     2}, // C1
-			{&CPU::REP, 3, "rep", AddressingMode::Immediate8bits,                   2}, // C2
-			{&CPU::CMP, 4, "cmp", AddressingMode::StackRelative,                    2}, // C3
-			{&CPU::CPY, 3, "cpy", AddressingMode::DirectPage,                       2}, // C4
-			{&CPU::CMP, 3, "cmp", AddressingMode::DirectPage,                       2}, // C5
-			{&CPU::DEC, 5, "dec", AddressingMode::DirectPage,                       2}, // C6
-			{&CPU::CMP, 6, "cmp", AddressingMode::DirectPageIndirectLong,           2}, // C7
-			{&CPU::INY, 2, "iny", AddressingMode::Implied,                          1}, // C8
-			{&CPU::CMP, 2, "cmp", AddressingMode::ImmediateForA,                    2}, // C9
-			{&CPU::DEX, 2, "dex", AddressingMode::Implied,                          1}, // CA
-			{&CPU::WAI, 3, "wai", AddressingMode::Implied,                          1}, // CB
-			{&CPU::CPY, 4, "cpy", AddressingMode::Absolute,                         3}, // CC
-			{&CPU::CMP, 4, "cmp", AddressingMode::Absolute,                         3}, // CD
-			{&CPU::DEC, 6, "dec", AddressingMode::Absolute,                         3}, // CE
-			{&CPU::CMP, 6, "cmp", AddressingMode::AbsoluteLong,                     4}, // CF
-			{&CPU::BNE, 2, "bne", AddressingMode::Immediate8bits,                   2}, // D0
-			{&CPU::CMP, 5, "cmp", AddressingMode::DirectPageIndirectIndexedByY,     2}, // D1
-			{&CPU::CMP, 5, "cmp", AddressingMode::DirectPageIndirect,               2}, // D2
-			{&CPU::CMP, 7, "cmp", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // D3
-			{&CPU::PEI, 6, "pei", AddressingMode::DirectPage,                       2}, // D4
-			{&CPU::CMP, 4, "cmp", AddressingMode::DirectPageIndexedByX,             2}, // D5
-			{&CPU::DEC, 6, "dec", AddressingMode::DirectPageIndexedByX,             2}, // D6
-			{&CPU::CMP, 6, "cmp", AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // D7
-			{&CPU::CLD, 2, "cld", AddressingMode::Implied,                          2}, // D8
-			{&CPU::CMP, 4, "cmp", AddressingMode::AbsoluteIndexedByY,               3}, // D9
-			{&CPU::PHX, 3, "phx", AddressingMode::Implied,                          1}, // DA
-			{&CPU::STP, 3, "stp", AddressingMode::Implied,                          1}, // DB
-			{&CPU::JML, 7, "jml", AddressingMode::AbsoluteIndirectLong,             2}, // DC
-			{&CPU::CMP, 4, "cmp", AddressingMode::AbsoluteIndexedByX,               3}, // DD
-			{&CPU::DEC, 7, "dec", AddressingMode::AbsoluteIndexedByX,               3}, // DE
-			{&CPU::CMP, 5, "cmp", AddressingMode::AbsoluteIndexedByXLong,           4}, // DF
-			{&CPU::CPX, 2, "cpx", AddressingMode::ImmediateForX,                    2}, // E0
-			{&CPU::SBC, 6, "sbc", AddressingMode::DirectPageIndirectIndexedByX,     2}, // E1
-			{&CPU::SEP, 3, "sep", AddressingMode::Immediate8bits,                   2}, // E2
-			{&CPU::SBC, 4, "sbc", AddressingMode::StackRelative,                    2}, // E3
-			{&CPU::CPX, 3, "cpx", AddressingMode::DirectPage,                       2}, // E4
-			{&CPU::SBC, 3, "sbc", AddressingMode::DirectPage,                       2}, // E5
-			{&CPU::INC, 5, "inc", AddressingMode::DirectPage,                       2}, // E6
-			{&CPU::SBC, 6, "sbc", AddressingMode::DirectPageIndirectLong,           2}, // E7
-			{&CPU::INX, 2, "inx", AddressingMode::Implied,                          1}, // E8
-			{&CPU::SBC, 2, "sbc", AddressingMode::ImmediateForA,                    2}, // E9
-			{&CPU::NOP, 2, "nop", AddressingMode::Implied,                          1}, // EA
-			{&CPU::XBA, 3, "xba", AddressingMode::Implied,                          1}, // EB
-			{&CPU::CPX, 4, "cpx", AddressingMode::Absolute,                         3}, // EC
-			{&CPU::SBC, 4, "sbc", AddressingMode::Absolute,                         3}, // ED
-			{&CPU::INC, 6, "inc", AddressingMode::Absolute,                         3}, // EE
-			{&CPU::SBC, 5, "sbc", AddressingMode::AbsoluteLong,                     4}, // EF
-			{&CPU::BEQ, 2, "beq", AddressingMode::Immediate8bits,                   2}, // F0
-			{&CPU::SBC, 5, "sbc", AddressingMode::DirectPageIndirectIndexedByY,     2}, // F1
-			{&CPU::SBC, 5, "sbc", AddressingMode::DirectPageIndirect,               2}, // F2
-			{&CPU::SBC, 7, "sbc", AddressingMode::StackRelativeIndirectIndexedByY,  2}, // F3
-			{&CPU::PEA, 5, "pea", AddressingMode::Immediate16bits,                  3}, // F4
-			{&CPU::SBC, 4, "sbc", AddressingMode::DirectPageIndexedByX,             2}, // F5
-			{&CPU::INC, 6, "inc", AddressingMode::DirectPageIndexedByX,             2}, // F6
-			{&CPU::SBC, 6, "sbc", AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // F7
-			{&CPU::SED, 2, "sed", AddressingMode::Implied,                          1}, // F8
-			{&CPU::SBC, 4, "sbc", AddressingMode::AbsoluteIndexedByY,               3}, // F9
-			{&CPU::PLX, 4, "plx", AddressingMode::Implied,                          1}, // FA
-			{&CPU::XCE, 2, "xce", AddressingMode::Implied,                          1}, // FB
-			{&CPU::JSR, 8, "jsr", AddressingMode::AbsoluteIndirectIndexedByX,       3}, // FC
-			{&CPU::SBC, 4, "sbc", AddressingMode::AbsoluteIndexedByX,               3}, // FD
-			{&CPU::INC, 7, "inc", AddressingMode::AbsoluteIndexedByX,               3}, // FE
-			{&CPU::SBC, 5, "sbc", AddressingMode::AbsoluteIndexedByXLong,           4}, // FF
+		static constexpr std::array<Instruction, 0x100> instructions = {{
+			{&CPU::BRK, 7, AddressingMode::Immediate8bits,                   2}, // 00
+			{&CPU::ORA, 6, AddressingMode::DirectPageIndirectIndexedByX,     2}, // 01
+			{&CPU::COP, 7, AddressingMode::Immediate8bits,                   2}, // 02
+			{&CPU::ORA, 4, AddressingMode::StackRelative,                    2}, // 03
+			{&CPU::TSB, 5, AddressingMode::DirectPage,                       2}, // 04
+			{&CPU::ORA, 3, AddressingMode::DirectPage,                       2}, // 05
+			{&CPU::ASL, 5, AddressingMode::DirectPage,                       2}, // 06
+			{&CPU::ORA, 6, AddressingMode::DirectPageIndirectLong,           2}, // 07
+			{&CPU::PHP, 3, AddressingMode::Implied,                          1}, // 08
+			{&CPU::ORA, 2, AddressingMode::ImmediateForA,                    2}, // 09
+			{&CPU::ASL, 2, AddressingMode::Implied,                          1}, // 0A
+			{&CPU::PHD, 4, AddressingMode::Implied,                          1}, // 0B
+			{&CPU::TSB, 6, AddressingMode::Absolute,                         3}, // 0C
+			{&CPU::ORA, 3, AddressingMode::Absolute,                         3}, // 0D
+			{&CPU::ASL, 6, AddressingMode::Absolute,                         3}, // 0E
+			{&CPU::ORA, 5, AddressingMode::AbsoluteLong,                     4}, // 0F
+			{&CPU::BPL, 7, AddressingMode::Immediate8bits,                   2}, // 10
+			{&CPU::ORA, 5, AddressingMode::DirectPageIndirectIndexedByY,     2}, // 11
+			{&CPU::ORA, 5, AddressingMode::DirectPageIndirect,               2}, // 12
+			{&CPU::ORA, 7, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 13
+			{&CPU::TRB, 5, AddressingMode::DirectPage,                       2}, // 14
+			{&CPU::ORA, 4, AddressingMode::DirectPageIndexedByX,             2}, // 15
+			{&CPU::ASL, 6, AddressingMode::DirectPageIndexedByX,             2}, // 16
+			{&CPU::ORA, 6, AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 17
+			{&CPU::CLC, 2, AddressingMode::Implied,                          1}, // 18
+			{&CPU::ORA, 4, AddressingMode::AbsoluteIndexedByY,               3}, // 19
+			{&CPU::INC, 2, AddressingMode::Implied,                          1}, // 1A
+			{&CPU::TCS, 2, AddressingMode::Implied,                          1}, // 1B
+			{&CPU::TRB, 6, AddressingMode::Absolute,                         3}, // 1C
+			{&CPU::ORA, 4, AddressingMode::AbsoluteIndexedByX,               3}, // 1D
+			{&CPU::ASL, 7, AddressingMode::AbsoluteIndexedByX,               3}, // 1E
+			{&CPU::ORA, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // 1F
+			{&CPU::JSR, 6, AddressingMode::Absolute,                         3}, // 20
+			{&CPU::AND, 6, AddressingMode::DirectPageIndirectIndexedByX,     2}, // 21
+			{&CPU::JSL, 8, AddressingMode::AbsoluteLong,                     4}, // 22
+			{&CPU::AND, 4, AddressingMode::StackRelative,                    2}, // 23
+			{&CPU::BIT, 3, AddressingMode::DirectPage,                       2}, // 24
+			{&CPU::AND, 3, AddressingMode::DirectPage,                       2}, // 25
+			{&CPU::ROL, 5, AddressingMode::DirectPage,                       2}, // 26
+			{&CPU::AND, 6, AddressingMode::DirectPageIndirectLong,           2}, // 27
+			{&CPU::PLP, 4, AddressingMode::Implied,                          1}, // 28
+			{&CPU::AND, 2, AddressingMode::ImmediateForA,                    2}, // 29
+			{&CPU::ROL, 2, AddressingMode::Implied,                          1}, // 2A
+			{&CPU::PLD, 5, AddressingMode::Implied,                          1}, // 2B
+			{&CPU::BIT, 4, AddressingMode::Absolute,                         3}, // 2C
+			{&CPU::AND, 4, AddressingMode::Absolute,                         3}, // 2D
+			{&CPU::ROL, 6, AddressingMode::Absolute,                         3}, // 2E
+			{&CPU::AND, 5, AddressingMode::AbsoluteLong,                     4}, // 2F
+			{&CPU::BMI, 2, AddressingMode::Immediate8bits,                   2}, // 30
+			{&CPU::AND, 5, AddressingMode::DirectPageIndirectIndexedByY,     2}, // 31
+			{&CPU::AND, 5, AddressingMode::DirectPageIndirect,               2}, // 32
+			{&CPU::AND, 7, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 33
+			{&CPU::BIT, 4, AddressingMode::DirectPageIndexedByX,             2}, // 34
+			{&CPU::AND, 4, AddressingMode::DirectPageIndexedByX,             2}, // 35
+			{&CPU::ROL, 6, AddressingMode::DirectPageIndexedByX,             2}, // 36
+			{&CPU::AND, 6, AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 37
+			{&CPU::SEC, 2, AddressingMode::Implied,                          1}, // 38
+			{&CPU::AND, 4, AddressingMode::AbsoluteIndexedByY,               3}, // 39
+			{&CPU::DEC, 2, AddressingMode::Implied,                          1}, // 3A
+			{&CPU::TSC, 2, AddressingMode::Implied,                          1}, // 3B
+			{&CPU::BIT, 4, AddressingMode::AbsoluteIndexedByX,               3}, // 3C
+			{&CPU::AND, 4, AddressingMode::AbsoluteIndexedByX,               3}, // 3D
+			{&CPU::ROL, 7, AddressingMode::AbsoluteIndexedByX,               3}, // 3E
+			{&CPU::AND, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // 3F
+			{&CPU::RTI, 6, AddressingMode::Implied,                          1}, // 40
+			{&CPU::EOR, 6, AddressingMode::DirectPageIndirectIndexedByX,     2}, // 41
+			{&CPU::WDM, 2, AddressingMode::Immediate8bits,                   2}, // 42
+			{&CPU::EOR, 4, AddressingMode::StackRelative,                    2}, // 43
+			{&CPU::MVP, 0, AddressingMode::BlockMove,                        3}, // 44
+			{&CPU::EOR, 3, AddressingMode::DirectPage,                       2}, // 45
+			{&CPU::LSR, 5, AddressingMode::DirectPage,                       2}, // 46
+			{&CPU::EOR, 6, AddressingMode::DirectPageIndirectLong,           2}, // 47
+			{&CPU::PHA, 3, AddressingMode::Implied,                          1}, // 48
+			{&CPU::EOR, 2, AddressingMode::ImmediateForA,                    2}, // 49
+			{&CPU::LSR, 2, AddressingMode::Implied,                          1}, // 4A
+			{&CPU::PHK, 3, AddressingMode::Implied,                          1}, // 4B
+			{&CPU::JMP, 3, AddressingMode::Absolute,                         3}, // 4C
+			{&CPU::EOR, 4, AddressingMode::Absolute,                         3}, // 4D
+			{&CPU::LSR, 6, AddressingMode::Absolute,                         3}, // 4E
+			{&CPU::EOR, 5, AddressingMode::AbsoluteLong,                     4}, // 4F
+			{&CPU::BVC, 2, AddressingMode::Immediate8bits,                   2}, // 50
+			{&CPU::EOR, 5, AddressingMode::DirectPageIndirectIndexedByY,     2}, // 51
+			{&CPU::EOR, 5, AddressingMode::DirectPageIndirect,               2}, // 52
+			{&CPU::EOR, 4, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 53
+			{&CPU::MVN, 0, AddressingMode::BlockMove,                        3}, // 54
+			{&CPU::EOR, 4, AddressingMode::DirectPageIndexedByX,             2}, // 55
+			{&CPU::LSR, 6, AddressingMode::DirectPageIndexedByX,             2}, // 56
+			{&CPU::EOR, 6, AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 57
+			{&CPU::CLI, 2, AddressingMode::Implied,                          1}, // 58
+			{&CPU::EOR, 4, AddressingMode::AbsoluteIndexedByY,               3}, // 59
+			{&CPU::PHY, 3, AddressingMode::Implied,                          1}, // 5A
+			{&CPU::TCD, 2, AddressingMode::Implied,                          1}, // 5B
+			{&CPU::JML, 4, AddressingMode::Implied,                          4}, // 5C
+			{&CPU::EOR, 4, AddressingMode::AbsoluteIndexedByX,               3}, // 5D
+			{&CPU::LSR, 7, AddressingMode::AbsoluteIndexedByX,               3}, // 5E
+			{&CPU::EOR, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // 5F
+			{&CPU::RTS, 6, AddressingMode::Implied,                          1}, // 60
+			{&CPU::ADC, 6, AddressingMode::DirectPageIndirectIndexedByX,     2}, // 61
+			{&CPU::PER, 6, AddressingMode::Immediate16bits,                  3}, // 62
+			{&CPU::ADC, 4, AddressingMode::StackRelative,                    2}, // 63
+			{&CPU::STZ, 3, AddressingMode::DirectPage,                       2}, // 64
+			{&CPU::ADC, 3, AddressingMode::DirectPage,                       2}, // 65
+			{&CPU::ROR, 5, AddressingMode::DirectPage,                       2}, // 66
+			{&CPU::ADC, 6, AddressingMode::DirectPageIndirectLong,           2}, // 67
+			{&CPU::PLA, 4, AddressingMode::Implied,                          1}, // 68
+			{&CPU::ADC, 2, AddressingMode::ImmediateForA,                    2}, // 69
+			{&CPU::ROR, 2, AddressingMode::Implied,                          1}, // 6A
+			{&CPU::RTL, 6, AddressingMode::Implied,                          1}, // 6B
+			{&CPU::JMP, 5, AddressingMode::AbsoluteIndirect,                 3}, // 6C
+			{&CPU::ADC, 4, AddressingMode::Absolute,                         3}, // 6D
+			{&CPU::ROR, 6, AddressingMode::Absolute,                         3}, // 6E
+			{&CPU::ADC, 5, AddressingMode::AbsoluteLong,                     4}, // 6F
+			{&CPU::BVS, 2, AddressingMode::Immediate8bits,                   2}, // 70
+			{&CPU::ADC, 5, AddressingMode::DirectPageIndirectIndexedByY,     2}, // 71
+			{&CPU::ADC, 5, AddressingMode::DirectPageIndirect,               2}, // 72
+			{&CPU::ADC, 7, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 73
+			{&CPU::STZ, 4, AddressingMode::DirectPageIndexedByX,             2}, // 74
+			{&CPU::ADC, 4, AddressingMode::DirectPageIndexedByX,             2}, // 75
+			{&CPU::ROR, 6, AddressingMode::DirectPageIndexedByX,             2}, // 76
+			{&CPU::ADC, 6, AddressingMode::DirectPageIndirectIndexedByY,     2}, // 77
+			{&CPU::SEI, 2, AddressingMode::Implied,                          1}, // 78
+			{&CPU::ADC, 4, AddressingMode::AbsoluteIndexedByY,               3}, // 79
+			{&CPU::PLY, 4, AddressingMode::Implied,                          1}, // 7A
+			{&CPU::TDC, 2, AddressingMode::Implied,                          1}, // 7B
+			{&CPU::JMP, 6, AddressingMode::AbsoluteIndirectIndexedByX,       3}, // 7C
+			{&CPU::ADC, 4, AddressingMode::AbsoluteIndexedByX,               3}, // 7D
+			{&CPU::ROR, 7, AddressingMode::AbsoluteIndexedByX,               3}, // 7E
+			{&CPU::ADC, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // 7F
+			{&CPU::BRA, 3, AddressingMode::Immediate8bits,                   2}, // 80
+			{&CPU::STA, 6, AddressingMode::DirectPageIndexedByX,             2}, // 81
+			{&CPU::BRL, 4, AddressingMode::Absolute,                         3}, // 82
+			{&CPU::STA, 4, AddressingMode::StackRelative,                    2}, // 83
+			{&CPU::STY, 3, AddressingMode::DirectPage,                       2}, // 84
+			{&CPU::STA, 3, AddressingMode::DirectPage,                       2}, // 85
+			{&CPU::STX, 3, AddressingMode::DirectPage,                       2}, // 86
+			{&CPU::STA, 6, AddressingMode::DirectPageIndirectLong,           2}, // 87
+			{&CPU::DEY, 2, AddressingMode::Implied,                          1}, // 88
+			{&CPU::BIT, 2, AddressingMode::ImmediateForA,                    2}, // 89
+			{&CPU::TXA, 2, AddressingMode::Implied,                          1}, // 8A
+			{&CPU::PHB, 3, AddressingMode::Implied,                          1}, // 8B
+			{&CPU::STY, 4, AddressingMode::Absolute,                         3}, // 8C
+			{&CPU::STA, 4, AddressingMode::Absolute,                         3}, // 8D
+			{&CPU::STX, 4, AddressingMode::Absolute,                         3}, // 8E
+			{&CPU::STA, 5, AddressingMode::AbsoluteLong,                     4}, // 8F
+			{&CPU::BCC, 2, AddressingMode::Immediate8bits,                   2}, // 90
+			{&CPU::STA, 6, AddressingMode::DirectPageIndirectIndexedByY,     2}, // 91
+			{&CPU::STA, 5, AddressingMode::DirectPageIndirect,               2}, // 92
+			{&CPU::STA, 7, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // 93
+			{&CPU::STY, 4, AddressingMode::DirectPageIndirectIndexedByX,     2}, // 94
+			{&CPU::STA, 4, AddressingMode::DirectPageIndexedByX,             2}, // 95
+			{&CPU::STX, 4, AddressingMode::DirectPageIndexedByY,             2}, // 96
+			{&CPU::STA, 6, AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // 97
+			{&CPU::TYA, 2, AddressingMode::Implied,                          1}, // 98
+			{&CPU::STA, 5, AddressingMode::AbsoluteIndexedByY,               3}, // 99
+			{&CPU::TXS, 2, AddressingMode::Implied,                          1}, // 9A
+			{&CPU::TXY, 2, AddressingMode::Implied,                          1}, // 9B
+			{&CPU::STZ, 4, AddressingMode::Absolute,                         3}, // 9C
+			{&CPU::STA, 5, AddressingMode::AbsoluteIndexedByX,               3}, // 9D
+			{&CPU::STZ, 5, AddressingMode::AbsoluteIndexedByX,               3}, // 9E
+			{&CPU::STA, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // 9F
+			{&CPU::LDY, 2, AddressingMode::ImmediateForX,                    2}, // A0
+			{&CPU::LDA, 6, AddressingMode::DirectPageIndirectIndexedByX,     2}, // A1
+			{&CPU::LDX, 2, AddressingMode::ImmediateForX,                    2}, // A2
+			{&CPU::LDA, 4, AddressingMode::StackRelative,                    2}, // A3
+			{&CPU::LDY, 3, AddressingMode::DirectPage,                       2}, // A4
+			{&CPU::LDA, 3, AddressingMode::DirectPage,                       2}, // A5
+			{&CPU::LDX, 3, AddressingMode::DirectPage,                       2}, // A6
+			{&CPU::LDA, 6, AddressingMode::DirectPageIndirectLong,           2}, // A7
+			{&CPU::TAY, 2, AddressingMode::Implied,                          1}, // A8
+			{&CPU::LDA, 2, AddressingMode::ImmediateForA,                    2}, // A9
+			{&CPU::TAX, 2, AddressingMode::Implied,                          1}, // AA
+			{&CPU::PLB, 4, AddressingMode::Implied,                          1}, // AB
+			{&CPU::LDY, 4, AddressingMode::Absolute,                         3}, // AC
+			{&CPU::LDA, 4, AddressingMode::Absolute,                         3}, // AD
+			{&CPU::LDX, 4, AddressingMode::Absolute,                         3}, // AE
+			{&CPU::LDA, 5, AddressingMode::AbsoluteLong,                     4}, // AF
+			{&CPU::BCS, 2, AddressingMode::Immediate8bits,                   2}, // B0
+			{&CPU::LDA, 5, AddressingMode::DirectPageIndirectIndexedByY,     2}, // B1
+			{&CPU::LDA, 5, AddressingMode::DirectPageIndirect,               2}, // B2
+			{&CPU::LDA, 7, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // B3
+			{&CPU::LDY, 4, AddressingMode::DirectPageIndexedByX,             2}, // B4
+			{&CPU::LDA, 4, AddressingMode::DirectPageIndexedByX,             2}, // B5
+			{&CPU::LDX, 4, AddressingMode::DirectPageIndexedByY,             2}, // B6
+			{&CPU::LDA, 6, AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // B7
+			{&CPU::CLV, 7, AddressingMode::Implied,                          1}, // B8
+			{&CPU::LDA, 4, AddressingMode::AbsoluteIndexedByY,               3}, // B9
+			{&CPU::TSX, 2, AddressingMode::Implied,                          1}, // BA
+			{&CPU::TYX, 2, AddressingMode::Implied,                          1}, // BB
+			{&CPU::LDY, 4, AddressingMode::AbsoluteIndexedByX,               3}, // BC
+			{&CPU::LDA, 4, AddressingMode::AbsoluteIndexedByX,               3}, // BD
+			{&CPU::LDX, 4, AddressingMode::AbsoluteIndexedByY,               3}, // BE
+			{&CPU::LDA, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // BF
+			{&CPU::CPY, 2, AddressingMode::ImmediateForX,                    2}, // C0
+			{&CPU::CMP, 6, AddressingMode::DirectPageIndirectIndexedByX,     2}, // C1
+			{&CPU::REP, 3, AddressingMode::Immediate8bits,                   2}, // C2
+			{&CPU::CMP, 4, AddressingMode::StackRelative,                    2}, // C3
+			{&CPU::CPY, 3, AddressingMode::DirectPage,                       2}, // C4
+			{&CPU::CMP, 3, AddressingMode::DirectPage,                       2}, // C5
+			{&CPU::DEC, 5, AddressingMode::DirectPage,                       2}, // C6
+			{&CPU::CMP, 6, AddressingMode::DirectPageIndirectLong,           2}, // C7
+			{&CPU::INY, 2, AddressingMode::Implied,                          1}, // C8
+			{&CPU::CMP, 2, AddressingMode::ImmediateForA,                    2}, // C9
+			{&CPU::DEX, 2, AddressingMode::Implied,                          1}, // CA
+			{&CPU::WAI, 3, AddressingMode::Implied,                          1}, // CB
+			{&CPU::CPY, 4, AddressingMode::Absolute,                         3}, // CC
+			{&CPU::CMP, 4, AddressingMode::Absolute,                         3}, // CD
+			{&CPU::DEC, 6, AddressingMode::Absolute,                         3}, // CE
+			{&CPU::CMP, 6, AddressingMode::AbsoluteLong,                     4}, // CF
+			{&CPU::BNE, 2, AddressingMode::Immediate8bits,                   2}, // D0
+			{&CPU::CMP, 5, AddressingMode::DirectPageIndirectIndexedByY,     2}, // D1
+			{&CPU::CMP, 5, AddressingMode::DirectPageIndirect,               2}, // D2
+			{&CPU::CMP, 7, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // D3
+			{&CPU::PEI, 6, AddressingMode::DirectPage,                       2}, // D4
+			{&CPU::CMP, 4, AddressingMode::DirectPageIndexedByX,             2}, // D5
+			{&CPU::DEC, 6, AddressingMode::DirectPageIndexedByX,             2}, // D6
+			{&CPU::CMP, 6, AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // D7
+			{&CPU::CLD, 2, AddressingMode::Implied,                          1}, // D8
+			{&CPU::CMP, 4, AddressingMode::AbsoluteIndexedByY,               3}, // D9
+			{&CPU::PHX, 3, AddressingMode::Implied,                          1}, // DA
+			{&CPU::STP, 3, AddressingMode::Implied,                          1}, // DB
+			{&CPU::JML, 7, AddressingMode::AbsoluteIndirectLong,             3}, // DC
+			{&CPU::CMP, 4, AddressingMode::AbsoluteIndexedByX,               3}, // DD
+			{&CPU::DEC, 7, AddressingMode::AbsoluteIndexedByX,               3}, // DE
+			{&CPU::CMP, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // DF
+			{&CPU::CPX, 2, AddressingMode::ImmediateForX,                    2}, // E0
+			{&CPU::SBC, 6, AddressingMode::DirectPageIndirectIndexedByX,     2}, // E1
+			{&CPU::SEP, 3, AddressingMode::Immediate8bits,                   2}, // E2
+			{&CPU::SBC, 4, AddressingMode::StackRelative,                    2}, // E3
+			{&CPU::CPX, 3, AddressingMode::DirectPage,                       2}, // E4
+			{&CPU::SBC, 3, AddressingMode::DirectPage,                       2}, // E5
+			{&CPU::INC, 5, AddressingMode::DirectPage,                       2}, // E6
+			{&CPU::SBC, 6, AddressingMode::DirectPageIndirectLong,           2}, // E7
+			{&CPU::INX, 2, AddressingMode::Implied,                          1}, // E8
+			{&CPU::SBC, 2, AddressingMode::ImmediateForA,                    2}, // E9
+			{&CPU::NOP, 2, AddressingMode::Implied,                          1}, // EA
+			{&CPU::XBA, 3, AddressingMode::Implied,                          1}, // EB
+			{&CPU::CPX, 4, AddressingMode::Absolute,                         3}, // EC
+			{&CPU::SBC, 4, AddressingMode::Absolute,                         3}, // ED
+			{&CPU::INC, 6, AddressingMode::Absolute,                         3}, // EE
+			{&CPU::SBC, 5, AddressingMode::AbsoluteLong,                     4}, // EF
+			{&CPU::BEQ, 2, AddressingMode::Immediate8bits,                   2}, // F0
+			{&CPU::SBC, 5, AddressingMode::DirectPageIndirectIndexedByY,     2}, // F1
+			{&CPU::SBC, 5, AddressingMode::DirectPageIndirect,               2}, // F2
+			{&CPU::SBC, 7, AddressingMode::StackRelativeIndirectIndexedByY,  2}, // F3
+			{&CPU::PEA, 5, AddressingMode::Immediate16bits,                  3}, // F4
+			{&CPU::SBC, 4, AddressingMode::DirectPageIndexedByX,             2}, // F5
+			{&CPU::INC, 6, AddressingMode::DirectPageIndexedByX,             2}, // F6
+			{&CPU::SBC, 6, AddressingMode::DirectPageIndirectIndexedByYLong, 2}, // F7
+			{&CPU::SED, 2, AddressingMode::Implied,                          1}, // F8
+			{&CPU::SBC, 4, AddressingMode::AbsoluteIndexedByY,               3}, // F9
+			{&CPU::PLX, 4, AddressingMode::Implied,                          1}, // FA
+			{&CPU::XCE, 2, AddressingMode::Implied,                          1}, // FB
+			{&CPU::JSR, 8, AddressingMode::AbsoluteIndirectIndexedByX,       3}, // FC
+			{&CPU::SBC, 4, AddressingMode::AbsoluteIndexedByX,               3}, // FD
+			{&CPU::INC, 7, AddressingMode::AbsoluteIndexedByX,               3}, // FE
+			{&CPU::SBC, 5, AddressingMode::AbsoluteIndexedByXLong,           4}, // FF
+		}};
+
+		//! @brief The mnemonic of every instructions (used by debuggers and tracers), indexed by opcode.
+		static constexpr std::array<std::string_view, 0x100> instructionNames = {
+			"brk", "ora", "cop", "ora", "tsb", "ora", "asl", "ora", "php", "ora", "asl", "phd", "tsb", "ora", "asl", "ora", // 00
+			"bpl", "ora", "ora", "ora", "trb", "ora", "asl", "ora", "clc", "ora", "inc", "tcs", "trb", "ora", "asl", "ora", // 10
+			"jsr", "and", "jsl", "and", "bit", "and", "rol", "and", "plp", "and", "rol", "pld", "bit", "and", "rol", "and", // 20
+			"bmi", "and", "and", "and", "bit", "and", "rol", "and", "sec", "and", "dec", "tsc", "bit", "and", "rol", "and", // 30
+			"rti", "eor", "wdm", "eor", "mvp", "eor", "lsr", "eor", "pha", "eor", "lsr", "phk", "jmp", "eor", "lsr", "eor", // 40
+			"bvc", "eor", "eor", "eor", "mvn", "eor", "lsr", "eor", "cli", "eor", "phy", "tcd", "jml", "eor", "lsr", "eor", // 50
+			"rts", "adc", "per", "adc", "stz", "adc", "ror", "adc", "pla", "adc", "ror", "rtl", "jmp", "adc", "ror", "adc", // 60
+			"bvs", "adc", "adc", "adc", "stz", "adc", "ror", "adc", "sei", "adc", "ply", "tdc", "jmp", "adc", "ror", "adc", // 70
+			"bra", "sta", "brl", "sta", "sty", "sta", "stx", "sta", "dey", "bit", "txa", "phb", "sty", "sta", "stx", "sta", // 80
+			"bcc", "sta", "sta", "sta", "sty", "sta", "stx", "sta", "tya", "sta", "txs", "txy", "stz", "sta", "stz", "sta", // 90
+			"ldy", "lda", "ldx", "lda", "ldy", "lda", "ldx", "lda", "tay", "lda", "tax", "plb", "ldy", "lda", "ldx", "lda", // A0
+			"bcs", "lda", "lda", "lda", "ldy", "lda", "ldx", "lda", "clv", "lda", "tsx", "tyx", "ldy", "lda", "ldx", "lda", // B0
+			"cpy", "cmp", "rep", "cmp", "cpy", "cmp", "dec", "cmp", "iny", "cmp", "dex", "wai", "cpy", "cmp", "dec", "cmp", // C0
+			"bne", "cmp", "cmp", "cmp", "pei", "cmp", "dec", "cmp", "cld", "cmp", "phx", "stp", "jml", "cmp", "dec", "cmp", // D0
+			"cpx", "sbc", "sep", "sbc", "cpx", "sbc", "inc", "sbc", "inx", "sbc", "nop", "xba", "cpx", "sbc", "inc", "sbc", // E0
+			"beq", "sbc", "sbc", "sbc", "pea", "sbc", "inc", "sbc", "sed", "sbc", "plx", "xce", "jsr", "sbc", "inc", "sbc", // F0
 		};
 
 		//! @brief Construct a new generic CPU.
 		//! @param bus The memory bus to use to transfer data.
 		//! @param cartridgeHeader The header used to know interrupts, main entry point etc...
-		CPU(Memory::IMemoryBus &bus, Cartridge::Header &cartridgeHeader);
+		//! @param scheduler The master clock used for the timers and the interrupts.
+		CPU(Memory::IMemoryBus &bus, Cartridge::Header &cartridgeHeader, Scheduler::Scheduler &scheduler);
 		//! @brief A default copy constructor
 		CPU(const CPU &) = default;
 		//! @brief A CPU is not assignable
@@ -603,6 +831,11 @@ namespace ComSquare::CPU
 		//! @return The number of CPU cycles that the instruction took.
 		unsigned executeInstruction();
 
+		//! @brief Set the buttons read from a controller port (the result of the automatic joypad read).
+		//! @param port The controller port (0 to 3).
+		//! @param buttons The state of the buttons, in the order of the JOY registers (B, Y, Select, Start, Up, Down, Left, Right, A, X, L, R from the high bit).
+		void setJoypad(unsigned port, uint16_t buttons);
+
 		//! @brief Run DMA's pending transfers.
 		//! @param maxCycles The maximum of cycle to run
 		//! @return The number of CPU cycles that elapsed
@@ -633,6 +866,11 @@ namespace ComSquare::CPU
 		//! @brief Get the component of this accessor (used for debug purpose)
 		[[nodiscard]] Component getComponent() const override;
 
+		//! @brief Write the registers, the DMA channels and the pending interrupts of this CPU to a save state.
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Restore a state written by saveState. The block cache and the idle loop detection start over.
+		void loadState(SaveState::SaveState &state);
+
 		//! @brief Reset interrupt - Called on boot and when the reset button is pressed.
 		//! @note This also triggers the callback onReset;
 		int RESB();
@@ -650,6 +888,22 @@ namespace ComSquare::CPU
 		//! @brief True if you want to disable updates of this CPU.
 		bool isDisabled = false;
 
+		//! @brief How this CPU runs instructions. This can be changed at any time.
+		ExecutionMode executionMode = ExecutionMode::Interpreter;
+		//! @brief The callback triggered before a block runs, when the executionMode is Differential.
+		Callback<> onBlockStart;
+		//! @brief The callback triggered after a block ran, when the executionMode is Differential.
+		//! @info Its arguments are the number of cycles and the number of instructions of the block.
+		Callback<unsigned, uint64_t> onBlockEnd;
+
+		//! @brief Set to false to run idle loops instead of skipping to the end of the update.
+		bool isIdleLoopSkippingEnabled = true;
+		//! @brief Statistics about the idle loops skipped since the creation of this CPU.
+		IdleLoopStatistics idleLoopStatistics;
+		//! @brief The number of instructions executed since the creation of this CPU.
+		uint64_t instructionCount = 0;
+
+		friend Differential::Differential;
 #ifdef DEBUGGER_ENABLED
 		friend Debugger::CPU::CPUDebug;
 		friend Debugger::RegisterViewer;
@@ -109,6 +109,24 @@ namespace ComSquare::CPU
 		return cycles;
 	}
 
+	void DMA::saveState(SaveState::SaveState &state) const
+	{
+		state.write(this->_controlRegister);
+		state.write(this->_port);
+		state.write(this->_aAddress);
+		state.write(this->_count);
+		state.write(this->enabled);
+	}
+
+	void DMA::loadState(SaveState::SaveState &state)
+	{
+		state.read(this->_controlRegister);
+		state.read(this->_port);
+		state.read(this->_aAddress);
+		state.read(this->_count);
+		state.read(this->enabled);
+	}
+
 	int DMA::_getModeOffset(int index) const
 	{
 		switch (this->_controlRegister.mode) {
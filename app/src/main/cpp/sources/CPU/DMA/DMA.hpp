@@ -6,6 +6,7 @@
 
 #include "Memory/MemoryBus.hpp"
 #include "Models/Ints.hpp"
+#include "SaveState/SaveState.hpp"
 #include <cstdint>
 #include <memory>
 
@@ -123,6 +124,11 @@ namespace ComSquare::CPU
 		//! @return the number of cycles taken
 		unsigned run(unsigned cycles);
 
+		//! @brief Write the registers of this channel to a save state.
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Restore the registers of this channel from a save state.
+		void loadState(SaveState::SaveState &state);
+
 		//! @brief Create a DMA channel with a given bus
 		//! @param bus The memory bus to use.
 		explicit DMA(Memory::IMemoryBus &bus);
@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <string>
+#include <cstdint>
 #include "Models/Ints.hpp"
 
 namespace ComSquare::CPU
@@ -12,7 +12,7 @@ namespace ComSquare::CPU
 	class CPU;
 
 	//! @brief Different addressing modes that instructions can use for the main CPU.
-	enum AddressingMode {
+	enum AddressingMode : uint8_t {
 		Implied,
 
 		Immediate8bits,
@@ -44,15 +44,21 @@ namespace ComSquare::CPU
 		AbsoluteIndirect,
 		AbsoluteIndirectIndexedByX,
 
-		AbsoluteIndirectLong
+		AbsoluteIndirectLong,
+
+		BlockMove
 	};
 
-	//! @brief Struct containing basic information about instructions.
+	//! @brief The signature of an instruction handler of the main CPU.
+	//! @return The number of cycles taken by the instruction on top of it's base cycle count.
+	using InstructionHandler = int (CPU::*)(uint24_t valueAddr, AddressingMode mode);
+
+	//! @brief Struct containing the information needed to run an instruction.
+	//! @info The mnemonic is not stored here to keep the instruction table small (see CPU::instructionNames).
 	struct Instruction {
-		int (CPU::*call)(uint24_t valueAddr, AddressingMode mode) = nullptr;
-		int cycleCount = 0;
-		std::string name;
+		InstructionHandler call = nullptr;
+		uint8_t cycleCount = 0;
 		AddressingMode addressingMode = Implied;
-		int size = 0;
+		uint8_t size = 0;
 	};
 }
\ No newline at end of file
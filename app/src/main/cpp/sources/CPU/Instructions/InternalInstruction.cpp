@@ -51,6 +51,7 @@ namespace ComSquare::CPU
 	int CPU::SEP(uint24_t valueAddr, AddressingMode)
 	{
 		this->_registers.p.flags |= this->getBus().read(valueAddr);
+		this->_updateDispatchTable();
 		return 0;
 	}
 
@@ -61,6 +62,7 @@ namespace ComSquare::CPU
 			this->_registers.p.x_b = true;
 			this->_registers.p.m = true;
 		}
+		this->_updateDispatchTable();
 		return 0;
 	}
 
@@ -80,13 +82,21 @@ namespace ComSquare::CPU
 		return 0;
 	}
 
-	int CPU::PHA(uint24_t, AddressingMode)
+	int CPU::PHA(uint24_t valueAddr, AddressingMode mode)
 	{
 		if (this->_registers.p.m)
+			return this->PHA<true>(valueAddr, mode);
+		return this->PHA<false>(valueAddr, mode);
+	}
+
+	template<bool is8Bits>
+	int CPU::PHA(uint24_t, AddressingMode)
+	{
+		if constexpr (is8Bits)
 			this->_push(this->_registers.al);
 		else
 			this->_push(this->_registers.a);
-		return !this->_registers.p.m;
+		return !is8Bits;
 	}
 
 	int CPU::PHB(uint24_t, AddressingMode)
@@ -113,28 +123,53 @@ namespace ComSquare::CPU
 		return 0;
 	}
 
+	int CPU::PHX(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_registers.p.x_b)
+			return this->PHX<true>(valueAddr, mode);
+		return this->PHX<false>(valueAddr, mode);
+	}
+
+	template<bool is8Bits>
 	int CPU::PHX(uint24_t, AddressingMode)
 	{
 		this->_push(this->_registers.x);
-		return !this->_registers.p.x_b;
+		return !is8Bits;
+	}
+
+	int CPU::PHY(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_registers.p.x_b)
+			return this->PHY<true>(valueAddr, mode);
+		return this->PHY<false>(valueAddr, mode);
 	}
 
+	template<bool is8Bits>
 	int CPU::PHY(uint24_t, AddressingMode)
 	{
 		this->_push(this->_registers.y);
-		return !this->_registers.p.x_b;
+		return !is8Bits;
+	}
+
+	int CPU::PLA(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.m
+			? this->PLA<true>(valueAddr, mode)
+			: this->PLA<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
 	}
 
+	template<bool is8Bits>
 	int CPU::PLA(uint24_t, AddressingMode)
 	{
-		if (this->_registers.p.m) {
+		if constexpr (is8Bits) {
 			this->_registers.a = this->_pop();
 			this->_registers.ah = 0;
 		} else
 			this->_registers.a = this->_pop16();
-		this->_registers.p.z = this->_registers.a == 0;
-		this->_registers.p.n = this->_registers.a & 0x8000u;
-		return !this->_registers.p.m;
+		this->_setLazyNZ(this->_registers.a, 0x8000u);
+		return !is8Bits;
 	}
 
 	int CPU::PLB(uint24_t, AddressingMode)
@@ -160,31 +195,50 @@ namespace ComSquare::CPU
 			this->_registers.p.m = true;
 			this->_registers.p.x_b = true;
 		}
+		this->_updateDispatchTable();
 		return 0;
 	}
 
+	int CPU::PLX(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->PLX<true>(valueAddr, mode)
+			: this->PLX<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
 	int CPU::PLX(uint24_t, AddressingMode)
 	{
-		if (this->_registers.p.x_b) {
+		if constexpr (is8Bits) {
 			this->_registers.x = this->_pop();
 			this->_registers.xh = 0;
 		} else
 			this->_registers.x = this->_pop16();
-		this->_registers.p.z = this->_registers.x == 0;
-		this->_registers.p.n = this->_registers.x & 0x8000u;
-		return !this->_registers.p.x_b;
+		this->_setLazyNZ(this->_registers.x, 0x8000u);
+		return !is8Bits;
+	}
+
+	int CPU::PLY(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->PLY<true>(valueAddr, mode)
+			: this->PLY<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
 	}
 
+	template<bool is8Bits>
 	int CPU::PLY(uint24_t, AddressingMode)
 	{
-		if (this->_registers.p.x_b) {
+		if constexpr (is8Bits) {
 			this->_registers.y = this->_pop();
 			this->_registers.yh = 0;
 		} else
 			this->_registers.y = this->_pop16();
-		this->_registers.p.z = this->_registers.y == 0;
-		this->_registers.p.n = this->_registers.y & 0x8000u;
-		return !this->_registers.p.x_b;
+		this->_setLazyNZ(this->_registers.y, 0x8000u);
+		return !is8Bits;
 	}
 
 	int CPU::PER(uint24_t valueAddr, AddressingMode)
@@ -220,55 +274,112 @@ namespace ComSquare::CPU
 			this->_registers.xh = 0;
 			this->_registers.yh = 0;
 		}
+		this->_updateDispatchTable();
 		return 0;
 	}
 
+	int CPU::BCC(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BCC<true>(valueAddr, mode);
+		return this->BCC<false>(valueAddr, mode);
+	}
+
+	template<bool isEmulationMode>
 	int CPU::BCC(uint24_t valueAddr, AddressingMode)
 	{
 		if (!this->_registers.p.c)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return !this->_registers.p.c + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return !this->_registers.p.c + isEmulationMode;
+	}
+
+	int CPU::BCS(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BCS<true>(valueAddr, mode);
+		return this->BCS<false>(valueAddr, mode);
 	}
 
+	template<bool isEmulationMode>
 	int CPU::BCS(uint24_t valueAddr, AddressingMode)
 	{
 		if (this->_registers.p.c)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return this->_registers.p.c + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return this->_registers.p.c + isEmulationMode;
+	}
+
+	int CPU::BEQ(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BEQ<true>(valueAddr, mode);
+		return this->BEQ<false>(valueAddr, mode);
 	}
 
+	template<bool isEmulationMode>
 	int CPU::BEQ(uint24_t valueAddr, AddressingMode)
 	{
 		if (this->_registers.p.z)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return this->_registers.p.z + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return this->_registers.p.z + isEmulationMode;
+	}
+
+	int CPU::BNE(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BNE<true>(valueAddr, mode);
+		return this->BNE<false>(valueAddr, mode);
 	}
 
+	template<bool isEmulationMode>
 	int CPU::BNE(uint24_t valueAddr, AddressingMode)
 	{
 		if (!this->_registers.p.z)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return !this->_registers.p.z + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return !this->_registers.p.z + isEmulationMode;
+	}
+
+	int CPU::BMI(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BMI<true>(valueAddr, mode);
+		return this->BMI<false>(valueAddr, mode);
 	}
 
+	template<bool isEmulationMode>
 	int CPU::BMI(uint24_t valueAddr, AddressingMode)
 	{
 		if (this->_registers.p.n)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return this->_registers.p.n + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return this->_registers.p.n + isEmulationMode;
+	}
+
+	int CPU::BPL(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BPL<true>(valueAddr, mode);
+		return this->BPL<false>(valueAddr, mode);
 	}
 
+	template<bool isEmulationMode>
 	int CPU::BPL(uint24_t valueAddr, AddressingMode)
 	{
 		if (!this->_registers.p.n)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return !this->_registers.p.n + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return !this->_registers.p.n + isEmulationMode;
+	}
+
+	int CPU::BRA(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BRA<true>(valueAddr, mode);
+		return this->BRA<false>(valueAddr, mode);
 	}
 
+	template<bool isEmulationMode>
 	int CPU::BRA(uint24_t valueAddr, AddressingMode)
 	{
-		this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return this->_isEmulationMode;
+		this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return isEmulationMode;
 	}
 
 	int CPU::BRL(uint24_t valueAddr, AddressingMode)
@@ -280,23 +391,42 @@ namespace ComSquare::CPU
 		return 0;
 	}
 
+	int CPU::BVC(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BVC<true>(valueAddr, mode);
+		return this->BVC<false>(valueAddr, mode);
+	}
+
+	template<bool isEmulationMode>
 	int CPU::BVC(uint24_t valueAddr, AddressingMode)
 	{
 		if (!this->_registers.p.v)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return !this->_registers.p.v + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return !this->_registers.p.v + isEmulationMode;
+	}
+
+	int CPU::BVS(uint24_t valueAddr, AddressingMode mode)
+	{
+		if (this->_isEmulationMode)
+			return this->BVS<true>(valueAddr, mode);
+		return this->BVS<false>(valueAddr, mode);
 	}
 
+	template<bool isEmulationMode>
 	int CPU::BVS(uint24_t valueAddr, AddressingMode)
 	{
 		if (this->_registers.p.v)
-			this->_registers.pc += static_cast<int8_t>(this->getBus().read(valueAddr));
-		return this->_registers.p.v + this->_isEmulationMode;
+			this->_branch(static_cast<int8_t>(this->getBus().read(valueAddr)));
+		return this->_registers.p.v + isEmulationMode;
 	}
 
 	int CPU::JMP(uint24_t value, AddressingMode)
 	{
+		uint16_t loopEnd = this->_registers.pc;
 		this->_registers.pc = value;
+		if (this->_registers.pc < loopEnd)
+			this->_detectIdleLoop(loopEnd);
 		return 0;
 	}
 
@@ -334,4 +464,35 @@ namespace ComSquare::CPU
 	{
 		return 0;
 	}
-}
\ No newline at end of file
+
+	template int CPU::PHA<true>(uint24_t, AddressingMode);
+	template int CPU::PHA<false>(uint24_t, AddressingMode);
+	template int CPU::PLA<true>(uint24_t, AddressingMode);
+	template int CPU::PLA<false>(uint24_t, AddressingMode);
+	template int CPU::PHX<true>(uint24_t, AddressingMode);
+	template int CPU::PHX<false>(uint24_t, AddressingMode);
+	template int CPU::PHY<true>(uint24_t, AddressingMode);
+	template int CPU::PHY<false>(uint24_t, AddressingMode);
+	template int CPU::PLX<true>(uint24_t, AddressingMode);
+	template int CPU::PLX<false>(uint24_t, AddressingMode);
+	template int CPU::PLY<true>(uint24_t, AddressingMode);
+	template int CPU::PLY<false>(uint24_t, AddressingMode);
+	template int CPU::BCC<true>(uint24_t, AddressingMode);
+	template int CPU::BCC<false>(uint24_t, AddressingMode);
+	template int CPU::BCS<true>(uint24_t, AddressingMode);
+	template int CPU::BCS<false>(uint24_t, AddressingMode);
+	template int CPU::BEQ<true>(uint24_t, AddressingMode);
+	template int CPU::BEQ<false>(uint24_t, AddressingMode);
+	template int CPU::BNE<true>(uint24_t, AddressingMode);
+	template int CPU::BNE<false>(uint24_t, AddressingMode);
+	template int CPU::BMI<true>(uint24_t, AddressingMode);
+	template int CPU::BMI<false>(uint24_t, AddressingMode);
+	template int CPU::BPL<true>(uint24_t, AddressingMode);
+	template int CPU::BPL<false>(uint24_t, AddressingMode);
+	template int CPU::BRA<true>(uint24_t, AddressingMode);
+	template int CPU::BRA<false>(uint24_t, AddressingMode);
+	template int CPU::BVC<true>(uint24_t, AddressingMode);
+	template int CPU::BVC<false>(uint24_t, AddressingMode);
+	template int CPU::BVS<true>(uint24_t, AddressingMode);
+	template int CPU::BVS<false>(uint24_t, AddressingMode);
+}
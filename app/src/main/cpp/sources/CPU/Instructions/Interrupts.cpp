@@ -19,12 +19,20 @@ namespace ComSquare::CPU
 		this->_registers.sh = 0x01; // the low bit of the stack pointer is undefined on reset.
 		this->_registers.pc = this->_cartridgeHeader.emulationInterrupts.reset;
 		this->_isStopped = false;
+		this->_hasLazyNZ = false;
+		this->_blockCache.clear();
+		this->_internalRegisters.nmitimen = 0;
+		this->_scheduleTimerIRQ(this->_scheduler.getTimestamp());
+		this->_scheduleVBlank(this->_scheduler.getTimestamp());
+		this->_updateDispatchTable();
 		this->onReset();
 		return 0;
 	}
 
 	void CPU::_runInterrupt(uint24_t nativeHandler, uint24_t emulationHandler)
 	{
+		this->_idleLoopStart = -1;
+		this->_materializeNZ();
 		if (this->_isEmulationMode) {
 			this->_push(this->_registers.pc);
 			this->_push(this->_registers.p.flags);
@@ -62,6 +70,7 @@ namespace ComSquare::CPU
 	int CPU::RTI(uint24_t, AddressingMode)
 	{
 		this->_registers.p.flags = this->_pop();
+		this->_updateDispatchTable();
 		this->_registers.pc = this->_pop16();
 
 		if (!this->_isEmulationMode)
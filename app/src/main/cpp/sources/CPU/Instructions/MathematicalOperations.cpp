@@ -7,13 +7,23 @@
 
 namespace ComSquare::CPU
 {
+	int CPU::ADC(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.m
+			? this->ADC<true>(valueAddr, mode)
+			: this->ADC<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
 	int CPU::ADC(uint24_t valueAddr, AddressingMode mode)
 	{
 		unsigned value = this->getBus().read(valueAddr) + this->_registers.p.c;
-		if (!this->_registers.p.m)
+		if constexpr (!is8Bits)
 			value += this->getBus().read(valueAddr + 1) << 8u;
-		unsigned negativeMask = this->_registers.p.m ? 0x80u : 0x8000u;
-		unsigned maxValue = this->_registers.p.m ? UINT8_MAX : UINT16_MAX;
+		constexpr unsigned negativeMask = is8Bits ? 0x80u : 0x8000u;
+		constexpr unsigned maxValue = is8Bits ? UINT8_MAX : UINT16_MAX;
 
 		this->_registers.p.c = static_cast<unsigned>(this->_registers.a) + value > maxValue;
 		if ((this->_registers.a & negativeMask) == (value & negativeMask))
@@ -21,12 +31,11 @@ namespace ComSquare::CPU
 		else
 			this->_registers.p.v = false;
 		this->_registers.a += value;
-		if (this->_registers.p.m)
+		if constexpr (is8Bits)
 			this->_registers.a %= 0x100;
-		this->_registers.p.z = this->_registers.a == 0;
-		this->_registers.p.n = this->_registers.a & negativeMask;
+		this->_setLazyNZ(this->_registers.a, negativeMask);
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -51,9 +60,19 @@ namespace ComSquare::CPU
 
 	int CPU::SBC(uint24_t valueAddr, AddressingMode mode)
 	{
-		unsigned negativeMask = this->_registers.p.m ? 0x80u : 0x8000u;
+		int cycles = this->_registers.p.m
+			? this->SBC<true>(valueAddr, mode)
+			: this->SBC<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::SBC(uint24_t valueAddr, AddressingMode mode)
+	{
+		constexpr unsigned negativeMask = is8Bits ? 0x80u : 0x8000u;
 		unsigned value = this->getBus().read(valueAddr);
-		if (!this->_registers.p.m)
+		if constexpr (!is8Bits)
 			value += this->getBus().read(valueAddr + 1) << 8u;
 		bool oldCarry = this->_registers.p.c;
 
@@ -63,12 +82,11 @@ namespace ComSquare::CPU
 		else
 			this->_registers.p.v = false;
 		this->_registers.a += ~value + oldCarry;
-		if (this->_registers.p.m)
+		if constexpr (is8Bits)
 			this->_registers.a %= 0x100;
-		this->_registers.p.z = this->_registers.a == 0;
-		this->_registers.p.n = this->_registers.a & negativeMask;
+		this->_setLazyNZ(this->_registers.a, negativeMask);
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -93,15 +111,24 @@ namespace ComSquare::CPU
 
 	int CPU::ORA(uint24_t valueAddr, AddressingMode mode)
 	{
-		unsigned negativeMask = this->_registers.p.m ? 0x80u : 0x8000u;
+		int cycles = this->_registers.p.m
+			? this->ORA<true>(valueAddr, mode)
+			: this->ORA<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::ORA(uint24_t valueAddr, AddressingMode mode)
+	{
+		constexpr unsigned negativeMask = is8Bits ? 0x80u : 0x8000u;
 		unsigned value = this->getBus().read(valueAddr);
-		if (!this->_registers.p.m)
+		if constexpr (!is8Bits)
 			value += this->getBus().read(valueAddr + 1) << 8u;
 		this->_registers.a |= value;
-		this->_registers.p.z = this->_registers.a == 0;
-		this->_registers.p.n = this->_registers.a & negativeMask;
+		this->_setLazyNZ(this->_registers.a, negativeMask);
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -124,45 +151,72 @@ namespace ComSquare::CPU
 		return cycles;
 	}
 
+	int CPU::DEX(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->DEX<true>(valueAddr, mode)
+			: this->DEX<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
 	int CPU::DEX(uint24_t, AddressingMode)
 	{
-		unsigned negativeMask = this->_registers.p.x_b ? 0x80 : 0x8000;
+		constexpr unsigned negativeMask = is8Bits ? 0x80 : 0x8000;
 
 		this->_registers.x--;
-		if (this->_registers.p.x_b)
+		if constexpr (is8Bits)
 			this->_registers.xh = 0;
-		this->_registers.p.z = this->_registers.x == 0;
-		this->_registers.p.n = this->_registers.x & negativeMask;
+		this->_setLazyNZ(this->_registers.x, negativeMask);
 		return 0;
 	}
 
+	int CPU::DEY(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->DEY<true>(valueAddr, mode)
+			: this->DEY<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
 	int CPU::DEY(uint24_t, AddressingMode)
 	{
-		unsigned negativeMask = this->_registers.p.x_b ? 0x80 : 0x8000;
+		constexpr unsigned negativeMask = is8Bits ? 0x80 : 0x8000;
 
 		this->_registers.y--;
-		if (this->_registers.p.x_b)
+		if constexpr (is8Bits)
 			this->_registers.yh = 0;
-		this->_registers.p.z = this->_registers.y == 0;
-		this->_registers.p.n = this->_registers.y & negativeMask;
+		this->_setLazyNZ(this->_registers.y, negativeMask);
 		return 0;
 	}
 
 	int CPU::CMP(uint24_t valueAddr, AddressingMode mode)
 	{
-		unsigned negativeMask = this->_registers.p.m ? 0x80u : 0x8000u;
+		int cycles = this->_registers.p.m
+			? this->CMP<true>(valueAddr, mode)
+			: this->CMP<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::CMP(uint24_t valueAddr, AddressingMode mode)
+	{
+		constexpr unsigned negativeMask = is8Bits ? 0x80u : 0x8000u;
 		unsigned value = this->getBus().read(valueAddr);
-		if (!this->_registers.p.m)
+		if constexpr (!is8Bits)
 			value += this->getBus().read(valueAddr + 1) << 8u;
 		unsigned result = this->_registers.a - value;
-		if (this->_registers.p.m)
+		if constexpr (is8Bits)
 			result %= 0x100;
 
-		this->_registers.p.n = result & negativeMask;
-		this->_registers.p.z = result == 0;
+		this->_setLazyNZ(result, negativeMask);
 		this->_registers.p.c = this->_registers.a >= result;
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -186,84 +240,127 @@ namespace ComSquare::CPU
 	}
 
 
+	int CPU::INX(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->INX<true>(valueAddr, mode)
+			: this->INX<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
 	int CPU::INX(uint24_t, AddressingMode)
 	{
 		this->_registers.x++;
 
-		if (this->_registers.p.x_b)
+		if constexpr (is8Bits)
 			this->_registers.x %= 0x100;
 
-		unsigned negativeFlag = this->_registers.p.x_b ? 0x80u : 0x8000u;
-		this->_registers.p.z = this->_registers.x == 0;
-		this->_registers.p.n = this->_registers.x & negativeFlag;
+		constexpr unsigned negativeFlag = is8Bits ? 0x80u : 0x8000u;
+		this->_setLazyNZ(this->_registers.x, negativeFlag);
 		return 0;
 	}
 
+	int CPU::INY(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->INY<true>(valueAddr, mode)
+			: this->INY<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
 	int CPU::INY(uint24_t, AddressingMode)
 	{
 		this->_registers.y++;
 
-		if (this->_registers.p.x_b)
+		if constexpr (is8Bits)
 			this->_registers.y %= 0x100;
 
-		unsigned negativeFlag = this->_registers.p.x_b ? 0x80u : 0x8000u;
-		this->_registers.p.z = this->_registers.y == 0;
-		this->_registers.p.n = this->_registers.y & negativeFlag;
+		constexpr unsigned negativeFlag = is8Bits ? 0x80u : 0x8000u;
+		this->_setLazyNZ(this->_registers.y, negativeFlag);
 		return 0;
 	}
 
+	int CPU::CPX(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->CPX<true>(valueAddr, mode)
+			: this->CPX<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
 	int CPU::CPX(uint24_t valueAddr, AddressingMode mode)
 	{
 		unsigned value = this->getBus().read(valueAddr++);
 
-		if (this->_registers.p.x_b) {
+		if constexpr (is8Bits) {
 			uint8_t x = this->_registers.x;
 			x -= value;
-			this->_registers.p.z = x == 0;
-			this->_registers.p.n = x & 0x80u;
+			this->_setLazyNZ(x, 0x80u);
 		} else {
 			value += this->getBus().read(valueAddr) << 8u;
 			uint16_t x = this->_registers.x;
 			x -= value;
-			this->_registers.p.z = x == 0;
-			this->_registers.p.n = x & 0x8000u;
+			this->_setLazyNZ(x, 0x8000u);
 		}
 		this->_registers.p.c = this->_registers.x >= value;
-		return !this->_registers.p.x_b + (mode == DirectPage && this->_registers.dl != 0);
+		return !is8Bits + (mode == DirectPage && this->_registers.dl != 0);
+	}
+
+	int CPU::CPY(uint24_t valueAddr, AddressingMode mode)
+	{
+		int cycles = this->_registers.p.x_b
+			? this->CPY<true>(valueAddr, mode)
+			: this->CPY<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
 	}
 
+	template<bool is8Bits>
 	int CPU::CPY(uint24_t valueAddr, AddressingMode mode)
 	{
 		unsigned value = this->getBus().read(valueAddr++);
 
 		this->_registers.p.c = this->_registers.y >= value;
-		if (this->_registers.p.x_b) {
+		if constexpr (is8Bits) {
 			uint8_t y = this->_registers.y;
 			y -= value;
-			this->_registers.p.z = y == 0;
-			this->_registers.p.n = y & 0x80u;
+			this->_setLazyNZ(y, 0x80u);
 		} else {
 			value += this->getBus().read(valueAddr) << 8u;
 			uint16_t y = this->_registers.y;
 			y -= value;
-			this->_registers.p.z = y == 0;
-			this->_registers.p.n = y & 0x8000u;
+			this->_setLazyNZ(y, 0x8000u);
 		}
-		return !this->_registers.p.x_b + (mode == DirectPage && this->_registers.dl != 0);
+		return !is8Bits + (mode == DirectPage && this->_registers.dl != 0);
 	}
 
 	int CPU::AND(uint24_t valueAddr, AddressingMode mode)
 	{
-		unsigned negativeMask = this->_registers.p.m ? 0x80u : 0x8000u;
+		int cycles = this->_registers.p.m
+			? this->AND<true>(valueAddr, mode)
+			: this->AND<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::AND(uint24_t valueAddr, AddressingMode mode)
+	{
+		constexpr unsigned negativeMask = is8Bits ? 0x80u : 0x8000u;
 		unsigned value = this->getBus().read(valueAddr);
-		if (!this->_registers.p.m)
+		if constexpr (!is8Bits)
 			value += this->getBus().read(valueAddr + 1) << 8u;
 
 		this->_registers.a &= value;
-		this->_registers.p.n = this->_registers.a & negativeMask;
-		this->_registers.p.z = this->_registers.a == 0;
+		this->_setLazyNZ(this->_registers.a, negativeMask);
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -368,15 +465,24 @@ namespace ComSquare::CPU
 
 	int CPU::EOR(uint24_t valueAddr, AddressingMode mode)
 	{
-		unsigned negativeMask = this->_registers.p.m ? 0x80u : 0x8000u;
+		int cycles = this->_registers.p.m
+			? this->EOR<true>(valueAddr, mode)
+			: this->EOR<false>(valueAddr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::EOR(uint24_t valueAddr, AddressingMode mode)
+	{
+		constexpr unsigned negativeMask = is8Bits ? 0x80u : 0x8000u;
 		unsigned value = this->getBus().read(valueAddr);
-		if (!this->_registers.p.m)
+		if constexpr (!is8Bits)
 			value += this->getBus().read(valueAddr + 1) << 8u;
 		this->_registers.a ^= value;
-		this->_registers.p.z = this->_registers.a == 0;
-		this->_registers.p.n = this->_registers.a & negativeMask;
+		this->_setLazyNZ(this->_registers.a, negativeMask);
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -408,4 +514,29 @@ namespace ComSquare::CPU
 		this->_registers.p.z = this->_registers.al == 0;
 		return 0;
 	}
-}
\ No newline at end of file
+
+	template int CPU::ADC<true>(uint24_t, AddressingMode);
+	template int CPU::ADC<false>(uint24_t, AddressingMode);
+	template int CPU::SBC<true>(uint24_t, AddressingMode);
+	template int CPU::SBC<false>(uint24_t, AddressingMode);
+	template int CPU::ORA<true>(uint24_t, AddressingMode);
+	template int CPU::ORA<false>(uint24_t, AddressingMode);
+	template int CPU::CMP<true>(uint24_t, AddressingMode);
+	template int CPU::CMP<false>(uint24_t, AddressingMode);
+	template int CPU::AND<true>(uint24_t, AddressingMode);
+	template int CPU::AND<false>(uint24_t, AddressingMode);
+	template int CPU::EOR<true>(uint24_t, AddressingMode);
+	template int CPU::EOR<false>(uint24_t, AddressingMode);
+	template int CPU::DEX<true>(uint24_t, AddressingMode);
+	template int CPU::DEX<false>(uint24_t, AddressingMode);
+	template int CPU::DEY<true>(uint24_t, AddressingMode);
+	template int CPU::DEY<false>(uint24_t, AddressingMode);
+	template int CPU::INX<true>(uint24_t, AddressingMode);
+	template int CPU::INX<false>(uint24_t, AddressingMode);
+	template int CPU::INY<true>(uint24_t, AddressingMode);
+	template int CPU::INY<false>(uint24_t, AddressingMode);
+	template int CPU::CPX<true>(uint24_t, AddressingMode);
+	template int CPU::CPX<false>(uint24_t, AddressingMode);
+	template int CPU::CPY<true>(uint24_t, AddressingMode);
+	template int CPU::CPY<false>(uint24_t, AddressingMode);
+}
@@ -9,13 +9,21 @@ namespace ComSquare::CPU
 	int CPU::STA(uint24_t addr, AddressingMode mode)
 	{
 		if (this->_registers.p.m)
+			return this->STA<true>(addr, mode);
+		return this->STA<false>(addr, mode);
+	}
+
+	template<bool is8Bits>
+	int CPU::STA(uint24_t addr, AddressingMode mode)
+	{
+		if constexpr (is8Bits)
 			this->getBus().write(addr, this->_registers.al);
 		else {
 			this->getBus().write(addr, this->_registers.al);
 			this->getBus().write(addr + 1, this->_registers.ah);
 		}
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -34,48 +42,81 @@ namespace ComSquare::CPU
 	int CPU::STX(uint24_t addr, AddressingMode mode)
 	{
 		if (this->_registers.p.x_b)
+			return this->STX<true>(addr, mode);
+		return this->STX<false>(addr, mode);
+	}
+
+	template<bool is8Bits>
+	int CPU::STX(uint24_t addr, AddressingMode mode)
+	{
+		if constexpr (is8Bits)
 			this->getBus().write(addr, this->_registers.xl);
 		else {
 			this->getBus().write(addr, this->_registers.xl);
 			this->getBus().write(addr + 1, this->_registers.xh);
 		}
-		return !this->_registers.p.x_b + (mode != Absolute && this->_registers.dl != 0);
+		return !is8Bits + (mode != Absolute && this->_registers.dl != 0);
 	}
 
 	int CPU::STY(uint24_t addr, AddressingMode mode)
 	{
 		if (this->_registers.p.x_b)
+			return this->STY<true>(addr, mode);
+		return this->STY<false>(addr, mode);
+	}
+
+	template<bool is8Bits>
+	int CPU::STY(uint24_t addr, AddressingMode mode)
+	{
+		if constexpr (is8Bits)
 			this->getBus().write(addr, this->_registers.yl);
 		else {
 			this->getBus().write(addr, this->_registers.yl);
 			this->getBus().write(addr + 1, this->_registers.yh);
 		}
-		return !this->_registers.p.x_b + (mode != Absolute && this->_registers.dl != 0);
+		return !is8Bits + (mode != Absolute && this->_registers.dl != 0);
+	}
+
+	int CPU::STZ(uint24_t addr, AddressingMode mode)
+	{
+		if (this->_registers.p.m)
+			return this->STZ<true>(addr, mode);
+		return this->STZ<false>(addr, mode);
 	}
 
+	template<bool is8Bits>
 	int CPU::STZ(uint24_t addr, AddressingMode mode)
 	{
 		this->getBus().write(addr, 0x00);
-		if (!this->_registers.p.m)
+		if constexpr (!is8Bits)
 			this->getBus().write(addr + 1, 0x00);
 		if (mode == Absolute || mode == AbsoluteIndexedByX)
-			return !this->_registers.p.m;
-		return !this->_registers.p.m + this->_registers.dl != 0;
+			return !is8Bits;
+		return !is8Bits + this->_registers.dl != 0;
 	}
 
 	int CPU::LDA(uint24_t addr, AddressingMode mode)
 	{
-		if (this->_registers.p.m) {
+		int cycles = this->_registers.p.m
+			? this->LDA<true>(addr, mode)
+			: this->LDA<false>(addr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::LDA(uint24_t addr, AddressingMode mode)
+	{
+		if constexpr (is8Bits) {
 			this->_registers.a = this->getBus().read(addr);
-			this->_registers.p.n = this->_registers.al & 0xF0u;
 		} else {
 			this->_registers.al = this->getBus().read(addr);
 			this->_registers.ah = this->getBus().read(addr + 1);
-			this->_registers.p.n = this->_registers.a & 0xF000u;
 		}
-		this->_registers.p.z = this->_registers.a == 0x0;
+		// The 8 bits load clears the high byte so the whole register can be tested.
+		this->_setLazyNZ(this->_registers.a, is8Bits ? 0xF0u : 0xF000u);
 
-		int cycles = !this->_registers.p.m;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndirect:
@@ -100,17 +141,26 @@ namespace ComSquare::CPU
 
 	int CPU::LDX(uint24_t addr, AddressingMode mode)
 	{
-		if (this->_registers.p.x_b) {
+		int cycles = this->_registers.p.x_b
+			? this->LDX<true>(addr, mode)
+			: this->LDX<false>(addr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::LDX(uint24_t addr, AddressingMode mode)
+	{
+		if constexpr (is8Bits) {
 			this->_registers.x = this->getBus().read(addr);
-			this->_registers.p.n = this->_registers.xl & 0xF0u;
 		} else {
 			this->_registers.xl = this->getBus().read(addr);
 			this->_registers.xh = this->getBus().read(addr + 1);
-			this->_registers.p.n = this->_registers.x & 0xF000u;
 		}
-		this->_registers.p.z = this->_registers.x == 0x0;
+		// The 8 bits load clears the high byte so the whole register can be tested.
+		this->_setLazyNZ(this->_registers.x, is8Bits ? 0xF0u : 0xF000u);
 
-		int cycles = !this->_registers.p.x_b;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndexedByY:
@@ -127,17 +177,26 @@ namespace ComSquare::CPU
 
 	int CPU::LDY(uint24_t addr, AddressingMode mode)
 	{
-		if (this->_registers.p.x_b) {
+		int cycles = this->_registers.p.x_b
+			? this->LDY<true>(addr, mode)
+			: this->LDY<false>(addr, mode);
+		this->_materializeNZ();
+		return cycles;
+	}
+
+	template<bool is8Bits>
+	int CPU::LDY(uint24_t addr, AddressingMode mode)
+	{
+		if constexpr (is8Bits) {
 			this->_registers.y = this->getBus().read(addr);
-			this->_registers.p.n = this->_registers.yl & 0xF0u;
 		} else {
 			this->_registers.yl = this->getBus().read(addr);
 			this->_registers.yh = this->getBus().read(addr + 1);
-			this->_registers.p.n = this->_registers.y & 0xF000u;
 		}
-		this->_registers.p.z = this->_registers.y == 0x0;
+		// The 8 bits load clears the high byte so the whole register can be tested.
+		this->_setLazyNZ(this->_registers.y, is8Bits ? 0xF0u : 0xF000u);
 
-		int cycles = !this->_registers.p.x_b;
+		int cycles = !is8Bits;
 		switch (mode) {
 		case DirectPage:
 		case DirectPageIndexedByY:
@@ -151,4 +210,19 @@ namespace ComSquare::CPU
 		}
 		return cycles;
 	}
-}
\ No newline at end of file
+
+	template int CPU::STA<true>(uint24_t, AddressingMode);
+	template int CPU::STA<false>(uint24_t, AddressingMode);
+	template int CPU::STZ<true>(uint24_t, AddressingMode);
+	template int CPU::STZ<false>(uint24_t, AddressingMode);
+	template int CPU::LDA<true>(uint24_t, AddressingMode);
+	template int CPU::LDA<false>(uint24_t, AddressingMode);
+	template int CPU::STX<true>(uint24_t, AddressingMode);
+	template int CPU::STX<false>(uint24_t, AddressingMode);
+	template int CPU::STY<true>(uint24_t, AddressingMode);
+	template int CPU::STY<false>(uint24_t, AddressingMode);
+	template int CPU::LDX<true>(uint24_t, AddressingMode);
+	template int CPU::LDX<false>(uint24_t, AddressingMode);
+	template int CPU::LDY<true>(uint24_t, AddressingMode);
+	template int CPU::LDY<false>(uint24_t, AddressingMode);
+}
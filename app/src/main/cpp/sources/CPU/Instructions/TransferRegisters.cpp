@@ -160,8 +160,8 @@ namespace ComSquare::CPU
 
 		this->_registers.dbr = destBank;
 		while (this->_registers.a != 0xFFFF) {
-			uint8_t data = this->getBus().read(srcBank << 24u  | this->_registers.x);
-			this->getBus().write(destBank << 24u | this->_registers.y, data);
+			uint8_t data = this->getBus().read(srcBank << 16u | this->_registers.x);
+			this->getBus().write(destBank << 16u | this->_registers.y, data);
 			this->_registers.x++;
 			this->_registers.y++;
 			this->_registers.a--;
@@ -177,8 +177,8 @@ namespace ComSquare::CPU
 
 		this->_registers.dbr = destBank;
 		while (this->_registers.a != 0xFFFF) {
-			uint8_t data = this->getBus().read(srcBank << 24u  | this->_registers.x);
-			this->getBus().write(destBank << 24u | this->_registers.y, data);
+			uint8_t data = this->getBus().read(srcBank << 16u | this->_registers.x);
+			this->getBus().write(destBank << 16u | this->_registers.y, data);
 			this->_registers.x--;
 			this->_registers.y--;
 			this->_registers.a--;
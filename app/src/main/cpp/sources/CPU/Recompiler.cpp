@@ -0,0 +1,460 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include "CPU/Recompiler.hpp"
+#include "CPU/CPU.hpp"
+
+#ifdef RECOMPILER_ENABLED
+	#include <sys/mman.h>
+
+// Provided by the unwinder of libgcc, they make the unwind entries of generated code known to the exceptions.
+extern "C" void __register_frame(void *begin);
+extern "C" void __deregister_frame(void *begin);
+#endif
+
+namespace ComSquare::CPU
+{
+	Recompiler::~Recompiler()
+	{
+#ifdef RECOMPILER_ENABLED
+		if (!this->_code)
+			return;
+		__deregister_frame(this->_unwindInfo.data());
+		munmap(this->_code, codeSize);
+#endif
+	}
+
+	bool Recompiler::isAvailable()
+	{
+#ifdef RECOMPILER_ENABLED
+		if (this->_code)
+			return true;
+		if (this->_hasFailed)
+			return false;
+		void *code = mmap(nullptr, codeSize, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (code == MAP_FAILED) {
+			this->_hasFailed = true;
+			return false;
+		}
+		this->_code = static_cast<uint8_t *>(code);
+		this->_registerUnwindInfo();
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void Recompiler::_registerUnwindInfo()
+	{
+#ifdef RECOMPILER_ENABLED
+		auto push32 = [this](uint32_t value) {
+			for (int i = 0; i < 4; i++)
+				this->_unwindInfo.push_back(value >> (i * 8u));
+		};
+		auto push64 = [this](uint64_t value) {
+			for (int i = 0; i < 8; i++)
+				this->_unwindInfo.push_back(value >> (i * 8u));
+		};
+
+		// The CIE: the frame built by beginFunction (return address, rbx and rbp pushed, then 8 bytes of padding).
+		push32(28);
+		push32(0);
+		this->_unwindInfo.insert(this->_unwindInfo.end(), {
+			1, 'z', 'R', 0, // The version and the augmentation (the FDE pointer encoding is given).
+			1, 0x78, 16,    // The code alignment (1), the data alignment (-8) and the return address register (rip).
+			1, 0x00,        // The augmentation data: the pointers of the FDE are absolute.
+			0x0C, 7, 32,    // The frame starts at rsp + 32.
+			0x90, 1,        // rip is saved at cfa - 8.
+			0x83, 2,        // rbx is saved at cfa - 16.
+			0x86, 3,        // rbp is saved at cfa - 24.
+			0, 0, 0, 0, 0, 0
+		});
+		// The FDE: the whole buffer. The rules of the CIE are wrong in the prologue and the epilogue
+		// but the code only calls functions (that could throw) from the body.
+		push32(28);
+		push32(this->_unwindInfo.size());
+		push64(reinterpret_cast<uintptr_t>(this->_code));
+		push64(codeSize);
+		this->_unwindInfo.insert(this->_unwindInfo.end(), {0, 0, 0, 0, 0, 0, 0, 0});
+		// The end of the section.
+		push32(0);
+		__register_frame(this->_unwindInfo.data());
+#endif
+	}
+
+	void Recompiler::clear()
+	{
+		this->_used = 0;
+		this->_function = 0;
+	}
+
+	bool Recompiler::beginFunction()
+	{
+		if (!this->isAvailable())
+			return false;
+		this->_function = this->_used;
+		this->_isFull = false;
+		this->_exitJumps.clear();
+		// push rbx; push rbp; sub rsp, 8; mov rbx, rdi; xor ebp, ebp
+		this->_emit({0x53, 0x55, 0x48, 0x83, 0xEC, 0x08, 0x48, 0x89, 0xFB, 0x31, 0xED});
+		return true;
+	}
+
+	NativeBlock Recompiler::endFunction()
+	{
+		for (size_t jump : this->_exitJumps)
+			this->bind(jump);
+		// mov eax, ebp; add rsp, 8; pop rbp; pop rbx; ret
+		this->_emit({0x89, 0xE8, 0x48, 0x83, 0xC4, 0x08, 0x5D, 0x5B, 0xC3});
+		if (this->_isFull) {
+			this->_used = this->_function;
+			return nullptr;
+		}
+		NativeBlock function = reinterpret_cast<NativeBlock>(this->_code + this->_function);
+		this->_used = std::min((this->_used + 15u) & ~size_t(15u), codeSize);
+		return function;
+	}
+
+	void Recompiler::_emit(std::initializer_list<uint8_t> bytes)
+	{
+		if (this->_used + bytes.size() > codeSize) {
+			this->_isFull = true;
+			return;
+		}
+		std::memcpy(this->_code + this->_used, bytes.begin(), bytes.size());
+		this->_used += bytes.size();
+	}
+
+	void Recompiler::_emitCPUOperand(std::initializer_list<uint8_t> prefix, uint8_t reg, int32_t offset)
+	{
+		this->_emit(prefix);
+		// ModRM: [rbx + disp32]
+		this->_emit({static_cast<uint8_t>(0x83u | reg << 3u)});
+		this->_emitValue(offset);
+	}
+
+	void Recompiler::storeWord(int32_t offset, uint16_t value)
+	{
+		this->_emitCPUOperand({0x66, 0xC7}, 0, offset);
+		this->_emitValue(value);
+	}
+
+	void Recompiler::storeByte(int32_t offset, uint8_t value)
+	{
+		this->_emitCPUOperand({0xC6}, 0, offset);
+		this->_emitValue(value);
+	}
+
+	void Recompiler::orByte(int32_t offset, uint8_t mask)
+	{
+		this->_emitCPUOperand({0x80}, 1, offset);
+		this->_emitValue(mask);
+	}
+
+	void Recompiler::andByte(int32_t offset, uint8_t mask)
+	{
+		this->_emitCPUOperand({0x80}, 4, offset);
+		this->_emitValue(mask);
+	}
+
+	void Recompiler::addQword(int32_t offset, uint32_t value)
+	{
+		this->_emitCPUOperand({0x48, 0x81}, 0, offset);
+		this->_emitValue(value);
+	}
+
+	void Recompiler::loadWord(int32_t offset)
+	{
+		this->_emitCPUOperand({0x0F, 0xB7}, 0, offset);
+	}
+
+	void Recompiler::storeWordFromEax(int32_t offset)
+	{
+		this->_emitCPUOperand({0x66, 0x89}, 0, offset);
+	}
+
+	void Recompiler::addEax(int8_t value)
+	{
+		this->_emit({0x83, 0xC0, static_cast<uint8_t>(value)});
+	}
+
+	void Recompiler::zeroExtendAl()
+	{
+		this->_emit({0x0F, 0xB6, 0xC0});
+	}
+
+	void Recompiler::addCycles(uint32_t cycles)
+	{
+		this->_emit({0x81, 0xC5});
+		this->_emitValue(cycles);
+	}
+
+	void Recompiler::addCyclesFromEax()
+	{
+		this->_emit({0x01, 0xC5});
+	}
+
+	// The registers of the arguments in the ModRM bytes and the opcodes: rdi, rsi, rdx and rcx.
+	static constexpr uint8_t argumentRegisters[] = {7, 6, 2, 1};
+
+	void Recompiler::moveCPU(Argument argument)
+	{
+		// mov argument, rbx
+		this->_emit({0x48, 0x89, static_cast<uint8_t>(0xD8u | argumentRegisters[argument])});
+	}
+
+	void Recompiler::moveEax(Argument argument)
+	{
+		// mov argument, eax
+		this->_emit({0x89, static_cast<uint8_t>(0xC0u | argumentRegisters[argument])});
+	}
+
+	void Recompiler::moveConstant(Argument argument, uint64_t value)
+	{
+		auto opcode = static_cast<uint8_t>(0xB8u | argumentRegisters[argument]);
+		if (value > UINT32_MAX) {
+			this->_emit({0x48, opcode});
+			this->_emitValue(value);
+		} else {
+			this->_emit({opcode});
+			this->_emitValue(static_cast<uint32_t>(value));
+		}
+	}
+
+	void Recompiler::call(uintptr_t function)
+	{
+		auto relative = static_cast<int64_t>(function - reinterpret_cast<uintptr_t>(this->_code + this->_used + 5));
+		if (relative >= INT32_MIN && relative <= INT32_MAX) {
+			this->_emit({0xE8});
+			this->_emitValue(static_cast<int32_t>(relative));
+			return;
+		}
+		// mov rax, function; call rax
+		this->_emit({0x48, 0xB8});
+		this->_emitValue(static_cast<uint64_t>(function));
+		this->_emit({0xFF, 0xD0});
+	}
+
+	size_t Recompiler::jumpIfByteEquals(int32_t offset, uint8_t value)
+	{
+		// cmp byte [rbx + offset], value; je
+		this->_emitCPUOperand({0x80}, 7, offset);
+		this->_emitValue(value);
+		this->_emit({0x0F, 0x84});
+		size_t jump = this->_used;
+		this->_emitValue<int32_t>(0);
+		return jump;
+	}
+
+	void Recompiler::bind(size_t jump)
+	{
+		if (this->_isFull)
+			return;
+		auto relative = static_cast<int32_t>(this->_used - (jump + sizeof(int32_t)));
+		std::memcpy(this->_code + jump, &relative, sizeof(relative));
+	}
+
+	void Recompiler::exitIfAl()
+	{
+		// test al, al; jne
+		this->_emit({0x84, 0xC0, 0x0F, 0x85});
+		this->_exitJumps.push_back(this->_used);
+		this->_emitValue<int32_t>(0);
+	}
+
+	NativeBlock CPU::_compileBlock(const Block &block, uint32_t key)
+	{
+		Recompiler &code = this->_recompiler;
+		if (!code.beginFunction())
+			return nullptr;
+
+		auto offsetOf = [this](const void *field) {
+			return static_cast<int32_t>(static_cast<const uint8_t *>(field) - reinterpret_cast<const uint8_t *>(this));
+		};
+		const int32_t pcOffset = offsetOf(&this->_registers.pc);
+		const int32_t flagsOffset = offsetOf(&this->_registers.p.flags);
+		const int32_t xOffset = offsetOf(&this->_registers.x);
+		const int32_t yOffset = offsetOf(&this->_registers.y);
+		const int32_t crossedOffset = offsetOf(&this->_hasIndexCrossedPageBoundary);
+		const int32_t lazyResultOffset = offsetOf(&this->_lazyResult);
+		const int32_t lazyMaskOffset = offsetOf(&this->_lazyNegativeMask);
+		const int32_t hasLazyNZOffset = offsetOf(&this->_hasLazyNZ);
+		const int32_t instructionCountOffset = offsetOf(&this->instructionCount);
+		static_assert(sizeof(this->_hasIndexCrossedPageBoundary) == 1 && sizeof(this->_hasLazyNZ) == 1);
+
+		// The bits of the status register, as laid out by the compiler.
+		auto flagMask = [](void (*set)(Registers &)) {
+			Registers registers {};
+			set(registers);
+			return registers.p.flags;
+		};
+		const uint8_t carry = flagMask([](Registers &r) { r.p.c = true; });
+		const uint8_t interrupt = flagMask([](Registers &r) { r.p.i = true; });
+		const uint8_t decimal = flagMask([](Registers &r) { r.p.d = true; });
+		const uint8_t overflow = flagMask([](Registers &r) { r.p.v = true; });
+
+		// The native code calls those for what is not emitted inline.
+		auto materializeNZ = +[](CPU *cpu) { cpu->_materializeNZ(); };
+		auto getValueAddr = +[](CPU *cpu, AddressingMode mode) { return cpu->_getValueAddr(mode); };
+		auto runHandler = +[](CPU *cpu, uint24_t valueAddr, AddressingMode mode, const DecodedInstruction *instruction) {
+			return (cpu->*instruction->call)(valueAddr, mode);
+		};
+		auto isOutdated = +[](const Block *compiled) { return compiled->isOutdated(); };
+
+		auto getAddressGetter = [](AddressingMode mode) -> uint24_t (CPU::*)() {
+			switch (mode) {
+			case BlockMove: return &CPU::_getBlockMoveBanks;
+			case Absolute: return &CPU::_getAbsoluteAddr;
+			case AbsoluteLong: return &CPU::_getAbsoluteLongAddr;
+			case AbsoluteIndirect: return &CPU::_getAbsoluteIndirectAddr;
+			case AbsoluteIndirectLong: return &CPU::_getAbsoluteIndirectLongAddr;
+			case DirectPage: return &CPU::_getDirectAddr;
+			case DirectPageIndirect: return &CPU::_getDirectIndirectAddr;
+			case DirectPageIndirectLong: return &CPU::_getDirectIndirectLongAddr;
+			case DirectPageIndexedByX: return &CPU::_getDirectIndexedByXAddr;
+			case DirectPageIndexedByY: return &CPU::_getDirectIndexedByYAddr;
+			case DirectPageIndirectIndexedByX: return &CPU::_getDirectIndirectIndexedXAddr;
+			case DirectPageIndirectIndexedByY: return &CPU::_getDirectIndirectIndexedYAddr;
+			case DirectPageIndirectIndexedByYLong: return &CPU::_getDirectIndirectIndexedYLongAddr;
+			case AbsoluteIndexedByX: return &CPU::_getAbsoluteIndexedByXAddr;
+			case AbsoluteIndexedByXLong: return &CPU::_getAbsoluteIndexedByXLongAddr;
+			case AbsoluteIndexedByY: return &CPU::_getAbsoluteIndexedByYAddr;
+			case StackRelative: return &CPU::_getStackRelativeAddr;
+			case StackRelativeIndirectIndexedByY: return &CPU::_getStackRelativeIndirectIndexedYAddr;
+			case AbsoluteIndirectIndexedByX: return &CPU::_getAbsoluteIndirectIndexedByXAddr;
+			default: return nullptr;
+			}
+		};
+
+		uint24_t pbr = key >> 16u & 0xFFu;
+		auto pc = static_cast<uint16_t>(key);
+		// The cycles and the instructions of the inline instructions, added to the CPU only when needed.
+		unsigned pendingCycles = 0;
+		unsigned pendingInstructions = 0;
+		bool isPcStored = true;
+		auto flush = [&] {
+			if (pendingCycles)
+				code.addCycles(pendingCycles);
+			if (pendingInstructions)
+				code.addQword(instructionCountOffset, pendingInstructions);
+			pendingCycles = 0;
+			pendingInstructions = 0;
+		};
+		// INX, INY, DEX and DEY: the index is updated in place and the n and z flags are left lazy.
+		auto emitIndexStep = [&](int32_t offset, int8_t step, bool is8Bits) {
+			code.loadWord(offset);
+			code.addEax(step);
+			if (is8Bits)
+				code.zeroExtendAl();
+			code.storeWordFromEax(offset);
+			code.storeWordFromEax(lazyResultOffset);
+			code.storeWord(lazyMaskOffset, is8Bits ? 0x80 : 0x8000);
+			code.storeByte(hasLazyNZOffset, 1);
+		};
+
+		for (const DecodedInstruction &instruction : block.instructions) {
+			if (_needsNZ[instruction.opcode]) {
+				size_t skip = code.jumpIfByteEquals(hasLazyNZOffset, 0);
+				code.moveCPU(Recompiler::FirstArgument);
+				code.call(reinterpret_cast<uintptr_t>(materializeNZ));
+				code.bind(skip);
+			}
+
+			InstructionHandler call = instruction.call;
+			bool isInline = true;
+			if (call == &CPU::CLC)
+				code.andByte(flagsOffset, ~carry);
+			else if (call == &CPU::SEC)
+				code.orByte(flagsOffset, carry);
+			else if (call == &CPU::CLI)
+				code.andByte(flagsOffset, ~interrupt);
+			else if (call == &CPU::SEI)
+				code.orByte(flagsOffset, interrupt);
+			else if (call == &CPU::CLD)
+				code.andByte(flagsOffset, ~decimal);
+			else if (call == &CPU::SED)
+				code.orByte(flagsOffset, decimal);
+			else if (call == &CPU::CLV)
+				code.andByte(flagsOffset, ~overflow);
+			else if (call == &CPU::NOP)
+				;
+			else if (call == &CPU::INX<true> || call == &CPU::INX<false>)
+				emitIndexStep(xOffset, 1, call == &CPU::INX<true>);
+			else if (call == &CPU::INY<true> || call == &CPU::INY<false>)
+				emitIndexStep(yOffset, 1, call == &CPU::INY<true>);
+			else if (call == &CPU::DEX<true> || call == &CPU::DEX<false>)
+				emitIndexStep(xOffset, -1, call == &CPU::DEX<true>);
+			else if (call == &CPU::DEY<true> || call == &CPU::DEY<false>)
+				emitIndexStep(yOffset, -1, call == &CPU::DEY<true>);
+			else
+				isInline = false;
+
+			if (isInline) {
+				pendingCycles += instruction.cycleCount;
+				pendingInstructions++;
+				isPcStored = false;
+				pc += instruction.size;
+				continue;
+			}
+
+			// The handler can read the cycles and the instruction count (or throw), they have to be up to date.
+			flush();
+			code.storeByte(crossedOffset, 0);
+			AddressingMode mode = instruction.addressingMode;
+			switch (mode) {
+			case Implied:
+				code.storeWord(pcOffset, pc + 1);
+				code.moveConstant(Recompiler::SecondArgument, 0);
+				break;
+			case Immediate8bits:
+			case Immediate16bits:
+			case ImmediateForA:
+			case ImmediateForX:
+				// The operand is right after the opcode and its size is known for the flags of the block.
+				code.storeWord(pcOffset, pc + instruction.size);
+				code.moveConstant(Recompiler::SecondArgument, pbr << 16u | static_cast<uint16_t>(pc + 1));
+				break;
+			default:
+				code.storeWord(pcOffset, pc + 1);
+				code.moveCPU(Recompiler::FirstArgument);
+				if (uintptr_t getter = Recompiler::getFunctionAddress(getAddressGetter(mode))) {
+					code.call(getter);
+				} else {
+					code.moveConstant(Recompiler::SecondArgument, mode);
+					code.call(reinterpret_cast<uintptr_t>(getValueAddr));
+				}
+				code.moveEax(Recompiler::SecondArgument);
+				break;
+			}
+
+			code.moveCPU(Recompiler::FirstArgument);
+			code.moveConstant(Recompiler::ThirdArgument, mode);
+			if (uintptr_t handler = Recompiler::getFunctionAddress(call)) {
+				code.call(handler);
+			} else {
+				code.moveConstant(Recompiler::FourthArgument, reinterpret_cast<uintptr_t>(&instruction));
+				code.call(reinterpret_cast<uintptr_t>(runHandler));
+			}
+			code.addCyclesFromEax();
+			code.addCycles(instruction.cycleCount);
+			code.addQword(instructionCountOffset, 1);
+			isPcStored = true;
+			pc += instruction.size;
+
+			if (block.memory) {
+				// The block wrote over its own code, the next instructions have to be decoded again.
+				code.moveConstant(Recompiler::FirstArgument, reinterpret_cast<uintptr_t>(&block));
+				code.call(reinterpret_cast<uintptr_t>(isOutdated));
+				code.exitIfAl();
+			}
+		}
+		flush();
+		if (!isPcStored) {
+			code.storeWord(pcOffset, pc);
+			code.storeByte(crossedOffset, 0);
+		}
+		return code.endFunction();
+	}
+}
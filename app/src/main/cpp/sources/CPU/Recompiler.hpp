@@ -0,0 +1,159 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__) && !defined(__ANDROID__)
+	//! @brief Defined when the host can run the code emitted by the recompiler.
+	#define RECOMPILER_ENABLED
+#endif
+
+namespace ComSquare::CPU
+{
+	class CPU;
+
+	//! @brief The native code of a block. It runs the whole block and returns the number of CPU cycles it took.
+	using NativeBlock = unsigned (*)(CPU *cpu);
+
+	//! @brief Emit x86-64 code in an executable buffer (used by the CPU to compile its blocks).
+	//! @info Every function has the same frame: the CPU is kept in rbx and the cycles are summed in ebp.
+	//! A single unwind entry describes all of them, so the exceptions thrown by the functions they call go through them.
+	class Recompiler
+	{
+	private:
+		//! @brief The executable buffer or nullptr if it has not been allocated yet.
+		uint8_t *_code = nullptr;
+		//! @brief The number of bytes of the buffer already used.
+		size_t _used = 0;
+		//! @brief The start of the function being emitted.
+		size_t _function = 0;
+		//! @brief True if the function being emitted did not fit in the buffer.
+		bool _isFull = false;
+		//! @brief True if the buffer could not be allocated (native code is not allowed on this host).
+		bool _hasFailed = false;
+		//! @brief The jumps to the end of the function being emitted.
+		std::vector<size_t> _exitJumps;
+		//! @brief The CIE and FDE describing the frame of the functions, as found in an .eh_frame section.
+		std::vector<uint8_t> _unwindInfo;
+
+		//! @brief Write some bytes of code.
+		void _emit(std::initializer_list<uint8_t> bytes);
+		//! @brief Write a value of code in little endian.
+		template<typename T>
+		void _emitValue(T value)
+		{
+			if (this->_used + sizeof(value) > codeSize) {
+				this->_isFull = true;
+				return;
+			}
+			std::memcpy(this->_code + this->_used, &value, sizeof(value));
+			this->_used += sizeof(value);
+		}
+		//! @brief Write an instruction whose operand is a byte, word or qword at an offset of the CPU ([rbx + offset]).
+		//! @param prefix The prefixes and the opcode of the instruction.
+		//! @param reg The register or the opcode extension of the ModRM byte.
+		void _emitCPUOperand(std::initializer_list<uint8_t> prefix, uint8_t reg, int32_t offset);
+		//! @brief Build the unwind entry of the buffer and register it.
+		void _registerUnwindInfo();
+	public:
+		//! @brief True if native code can be generated for this host (x86-64 Linux).
+		static constexpr bool isSupported =
+#ifdef RECOMPILER_ENABLED
+			true;
+#else
+			false;
+#endif
+		//! @brief The size of the executable buffer. When it is full, every function is discarded (see clear).
+		static constexpr size_t codeSize = 16 * 1024 * 1024;
+
+		//! @brief The arguments of the functions called by the native code (System V calling convention).
+		enum Argument : uint8_t {
+			FirstArgument,
+			SecondArgument,
+			ThirdArgument,
+			FourthArgument
+		};
+
+		Recompiler() = default;
+		Recompiler(const Recompiler &) = delete;
+		Recompiler &operator=(const Recompiler &) = delete;
+		~Recompiler();
+
+		//! @brief Allocate the executable buffer if needed.
+		//! @return False if native code can't run on this host.
+		bool isAvailable();
+		//! @brief Discard every function emitted so far. The native blocks using them must not be called anymore.
+		void clear();
+
+		//! @brief Start a function taking the CPU as its only argument.
+		//! @return False if the buffer is not available.
+		bool beginFunction();
+		//! @brief Finish the function: it returns the cycles summed in ebp.
+		//! @return The function or nullptr if it did not fit in the buffer.
+		NativeBlock endFunction();
+
+		//! @brief Get the address of a non virtual member function, to call it with the object as its first argument.
+		//! @return The address or 0 if the member function can't be called directly.
+		template<typename Method>
+		static uintptr_t getFunctionAddress(Method method)
+		{
+			// A pointer to member function is a function address and a this adjustment (Itanium C++ ABI).
+			struct {
+				uintptr_t address;
+				ptrdiff_t adjustment;
+			} pointer {};
+			static_assert(sizeof(method) == sizeof(pointer));
+			std::memcpy(&pointer, &method, sizeof(pointer));
+			if (pointer.address & 1u || pointer.adjustment)
+				return 0;
+			return pointer.address;
+		}
+
+		//! @brief mov word [rbx + offset], value
+		void storeWord(int32_t offset, uint16_t value);
+		//! @brief mov byte [rbx + offset], value
+		void storeByte(int32_t offset, uint8_t value);
+		//! @brief or byte [rbx + offset], mask
+		void orByte(int32_t offset, uint8_t mask);
+		//! @brief and byte [rbx + offset], mask
+		void andByte(int32_t offset, uint8_t mask);
+		//! @brief add qword [rbx + offset], value
+		void addQword(int32_t offset, uint32_t value);
+		//! @brief movzx eax, word [rbx + offset]
+		void loadWord(int32_t offset);
+		//! @brief mov word [rbx + offset], ax
+		void storeWordFromEax(int32_t offset);
+		//! @brief add eax, value
+		void addEax(int8_t value);
+		//! @brief movzx eax, al
+		void zeroExtendAl();
+		//! @brief add ebp, cycles
+		void addCycles(uint32_t cycles);
+		//! @brief add ebp, eax
+		void addCyclesFromEax();
+
+		//! @brief Pass the CPU as an argument of the next call.
+		void moveCPU(Argument argument);
+		//! @brief Pass eax (the result of the last call) as an argument of the next call.
+		void moveEax(Argument argument);
+		//! @brief Pass a constant as an argument of the next call.
+		void moveConstant(Argument argument, uint64_t value);
+		//! @brief Call a function. Its result is in eax (or al for a boolean).
+		void call(uintptr_t function);
+
+		//! @brief Jump forward if the byte at [rbx + offset] is equal to value.
+		//! @return The jump, to give to bind.
+		size_t jumpIfByteEquals(int32_t offset, uint8_t value);
+		//! @brief Make a forward jump land on the next instruction.
+		void bind(size_t jump);
+		//! @brief Leave the function if al is not 0 (if the last call returned true).
+		void exitIfAl();
+	};
+}
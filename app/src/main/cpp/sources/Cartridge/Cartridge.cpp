@@ -5,6 +5,7 @@
 #include "Cartridge.hpp"
 #include "Exceptions/InvalidAction.hpp"
 #include "Exceptions/InvalidRom.hpp"
+#include <array>
 #include <cstring>
 #include <sys/stat.h>
 #include <fstream>
@@ -32,10 +33,23 @@ namespace ComSquare::Cartridge
 		if (!rom)
 			throw InvalidRomException("Could not open the rom file at " + path + ". " + strerror(errno));
 		this->_data.resize(size);
-		rom.read(reinterpret_cast<char *>(this->_data.data()), size);
+		for (size_t i = 0; i < this->_data.getPageCount(); i++) {
+			std::span<uint8_t> page = this->_data.getPage(i);
+			rom.read(reinterpret_cast<char *>(page.data()), page.size());
+		}
 		this->_loadHeader();
 	}
 
+	void Cartridge::shareRom(const Cartridge &other)
+	{
+		this->_data = other._data;
+		this->_pageVersions.resize(other._pageVersions.size());
+		this->_romPath = other._romPath;
+		this->_romStart = other._romStart;
+		this->_type = other._type;
+		this->header = other.header;
+	}
+
 	size_t Cartridge::getRomSize(const std::string &romPath)
 	{
 		struct stat info;
@@ -174,7 +188,9 @@ namespace ComSquare::Cartridge
 	{
 		if (this->getSize() < 0x25)
 			return false;
-		std::string str = std::string(reinterpret_cast<char *>(this->getData().data()), 0x21);
+		std::array<uint8_t, 0x21> magic;
+		this->copyTo(0, magic);
+		std::string str = std::string(magic.begin(), magic.end());
 
 		if (str != Cartridge::_magicSPC)
 			return false;
@@ -145,5 +145,9 @@ namespace ComSquare::Cartridge
 		//! @param rom The path of the rom.
 		//! @throws InvalidRomException If the rom is invalid, this exception is thrown.
 		void loadRom(const std::string& path);
+
+		//! @brief Use the rom of another cartridge. The data is shared between both cartridges, not copied.
+		//! @param other The cartridge to share the rom with.
+		void shareRom(const Cartridge &other);
 	};
 }// namespace ComSquare::Cartridge
\ No newline at end of file
@@ -0,0 +1,77 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "Differential.hpp"
+#include <algorithm>
+#include <sstream>
+#include "Exceptions/InvalidAction.hpp"
+
+namespace ComSquare::Differential
+{
+	Differential::Differential(SNES &snes)
+		: _snes(snes),
+		  _renderer(0, 0, 0),
+		  _previousMode(snes.cpu.executionMode)
+	{
+		this->_snes.apu.sync();
+		this->_reference = this->_snes.clone(this->_renderer);
+		this->_reference->apu.setMuted(true);
+		this->_state.setSharingMemories(true);
+		this->_result.setSharingMemories(true);
+		this->_expected.setSharingMemories(true);
+		this->_blockStartID = this->_snes.cpu.onBlockStart.addCallback([this] {
+			this->_beforeBlock();
+		});
+		this->_blockEndID = this->_snes.cpu.onBlockEnd.addCallback([this](unsigned cycles, uint64_t instructions) {
+			this->_afterBlock(cycles, instructions);
+		});
+		this->_snes.cpu.executionMode = CPU::ExecutionMode::Differential;
+	}
+
+	Differential::~Differential()
+	{
+		this->_snes.cpu.executionMode = this->_previousMode;
+		this->_snes.cpu.onBlockStart.removeCallback(this->_blockStartID);
+		this->_snes.cpu.onBlockEnd.removeCallback(this->_blockEndID);
+	}
+
+	void Differential::_beforeBlock()
+	{
+		this->_blockStart = this->_snes.cpu._registers.pac;
+		this->_snes.apu.sync();
+		this->_snes.saveState(this->_state);
+		this->_reference->loadState(this->_state);
+	}
+
+	void Differential::_afterBlock(unsigned cycles, uint64_t instructions)
+	{
+		CPU::CPU &cpu = this->_snes.cpu;
+		CPU::CPU &reference = this->_reference->cpu;
+		unsigned expectedCycles = 0;
+		for (uint64_t i = 0; i < instructions; i++)
+			expectedCycles += reference.executeInstruction();
+		if (cycles != expectedCycles)
+			this->_fail("it took " + std::to_string(cycles) + " cycles instead of " + std::to_string(expectedCycles));
+
+		// The deferred n and z flags are written to the status register, both consoles can be compared byte for byte.
+		cpu._materializeNZ();
+		reference._materializeNZ();
+		this->_snes.apu.sync();
+		this->_reference->apu.sync();
+		this->_snes.saveState(this->_result);
+		this->_reference->saveState(this->_expected);
+		if (!std::ranges::equal(this->_result.getData(), this->_expected.getData()))
+			this->_fail("the registers or the components are not in the same state");
+		if (!std::ranges::equal(this->_result.getSharedMemories(), this->_expected.getSharedMemories()))
+			this->_fail("the memories are not the same");
+	}
+
+	void Differential::_fail(const std::string &difference) const
+	{
+		std::stringstream stream;
+		stream << "The block at $" << std::hex << this->_blockStart << " does not match the interpreter: " << difference
+		       << " (the interpreter stopped at $" << this->_reference->cpu._registers.pac << ").";
+		throw InvalidAction(stream.str());
+	}
+}
@@ -0,0 +1,62 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "SNES.hpp"
+#include "Renderer/NoRenderer.hpp"
+#include "SaveState/SaveState.hpp"
+
+namespace ComSquare::Differential
+{
+	//! @brief Check every block run by a console against the interpreter.
+	//! @info Before each block, the state of the console is copied to a reference console. After it, the reference runs
+	//! the same number of instructions with the interpreter and both consoles must be in the same state.
+	class Differential
+	{
+	private:
+		//! @brief The console whose blocks are checked.
+		SNES &_snes;
+		//! @brief The renderer of the reference console (nothing is rendered between two blocks).
+		Renderer::NoRenderer _renderer;
+		//! @brief The console running the interpreter.
+		std::unique_ptr<SNES> _reference;
+		//! @brief The state copied to the reference before each block (the memories are shared).
+		SaveState::SaveState _state;
+		//! @brief The state of the checked console after the block.
+		SaveState::SaveState _result;
+		//! @brief The state of the reference after the block.
+		SaveState::SaveState _expected;
+		//! @brief The address of the block being checked.
+		uint24_t _blockStart = 0;
+		//! @brief The execution mode of the console before the checks started.
+		CPU::ExecutionMode _previousMode;
+		//! @brief The ID of the callback on the start of the blocks.
+		int _blockStartID;
+		//! @brief The ID of the callback on the end of the blocks.
+		int _blockEndID;
+
+		//! @brief Copy the state of the console to the reference.
+		void _beforeBlock();
+		//! @brief Run the block with the reference and compare the two consoles.
+		//! @param cycles The number of cycles the block took.
+		//! @param instructions The number of instructions run by the block.
+		//! @throw InvalidAction if the consoles are not in the same state.
+		void _afterBlock(unsigned cycles, uint64_t instructions);
+		//! @brief Throw an InvalidAction describing the difference.
+		[[noreturn]] void _fail(const std::string &difference) const;
+	public:
+		//! @brief Start checking the blocks run by a console. Its execution mode is set to Differential.
+		//! @param snes The console to check.
+		explicit Differential(SNES &snes);
+		//! @brief A differential checker is not copyable (it is registered in the callbacks of the CPU).
+		Differential(const Differential &) = delete;
+		//! @brief A differential checker is not assignable.
+		Differential &operator=(const Differential &) = delete;
+		//! @brief Stop the checks and restore the previous execution mode.
+		~Differential();
+	};
+}
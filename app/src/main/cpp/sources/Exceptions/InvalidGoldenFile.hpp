@@ -0,0 +1,23 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#ifndef COMSQUARE_INVALIDGOLDENFILE_HPP
+#define COMSQUARE_INVALIDGOLDENFILE_HPP
+
+#include <exception>
+#include <string>
+#include "DebuggableError.hpp"
+
+namespace ComSquare
+{
+	//! @brief Exception thrown when a golden file or an input script can't be read or written.
+	class InvalidGoldenFile : public DebuggableError {
+	private:
+		std::string _msg;
+	public:
+		explicit InvalidGoldenFile(const std::string &msg) : _msg(msg) {}
+		const char *what() const noexcept override { return this->_msg.c_str(); }
+	};
+}
+#endif //COMSQUARE_INVALIDGOLDENFILE_HPP
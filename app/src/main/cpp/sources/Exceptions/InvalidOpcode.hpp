@@ -2,8 +2,8 @@
 // Created by anonymus-raccoon on 1/30/20.
 //
 
-#ifndef COMSQUARE_INVALIDACTION_HPP
-#define COMSQUARE_INVALIDACTION_HPP
+#ifndef COMSQUARE_INVALIDOPCODE_HPP
+#define COMSQUARE_INVALIDOPCODE_HPP
 
 #include <exception>
 #include <string>
@@ -31,4 +31,4 @@ namespace ComSquare
 		const char *what() const noexcept override { return this->_msg.c_str(); }
 	};
 }
-#endif //COMSQUARE_INVALIDACTION_HPP
+#endif //COMSQUARE_INVALIDOPCODE_HPP
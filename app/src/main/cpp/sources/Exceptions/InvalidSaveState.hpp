@@ -0,0 +1,23 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#ifndef COMSQUARE_INVALIDSAVESTATE_HPP
+#define COMSQUARE_INVALIDSAVESTATE_HPP
+
+#include <exception>
+#include <string>
+#include "DebuggableError.hpp"
+
+namespace ComSquare
+{
+	//! @brief Exception thrown when someone tries to load a state that is corrupted or made with another rom or version.
+	class InvalidSaveState : public DebuggableError {
+	private:
+		std::string _msg;
+	public:
+		explicit InvalidSaveState(const std::string &msg) : _msg(msg) {}
+		const char *what() const noexcept override { return this->_msg.c_str(); }
+	};
+}
+#endif //COMSQUARE_INVALIDSAVESTATE_HPP
@@ -0,0 +1,127 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "BatchRunner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include "Renderer/HashRenderer.hpp"
+#include "SNES.hpp"
+
+namespace ComSquare::Headless
+{
+	double RomResult::getFramesPerSecond() const
+	{
+		return this->wallTime.count() > 0 ? this->frames / this->wallTime.count() : 0;
+	}
+
+	double RomResult::getInstructionsPerSecond() const
+	{
+		return this->wallTime.count() > 0 ? this->instructions / this->wallTime.count() : 0;
+	}
+
+	double RomResult::getSilentVoiceRatio() const
+	{
+		return this->voiceSamples > 0 ? static_cast<double>(this->silentVoiceSamples) / this->voiceSamples : 0;
+	}
+
+	double RomResult::getBRRCacheHitRate() const
+	{
+		uint64_t decodes = this->brrCacheHits + this->brrCacheMisses;
+		return decodes > 0 ? static_cast<double>(this->brrCacheHits) / decodes : 0;
+	}
+
+	BatchRunner::BatchRunner(uint64_t frameCount, unsigned threadCount)
+		: _frameCount(frameCount),
+		  _threadCount(threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u))
+	{}
+
+	//! @brief Hash the samples written to the sound buffer between two of its offsets.
+	static uint64_t hashSamples(std::span<const int16_t> buffer, uint32_t start, uint32_t end)
+	{
+		uint64_t hash = Renderer::HashRenderer::emptyHash;
+		if (end < start) {
+			hash = Renderer::HashRenderer::hash(hash, buffer.data() + start, (buffer.size() - start) * sizeof(int16_t));
+			start = 0;
+		}
+		return Renderer::HashRenderer::hash(hash, buffer.data() + start, (end - start) * sizeof(int16_t));
+	}
+
+	RomResult BatchRunner::_runRom(const std::string &path) const
+	{
+		RomResult result;
+		result.path = path;
+
+		Renderer::HashRenderer renderer;
+		std::unique_ptr<SNES> snes;
+		auto start = std::chrono::steady_clock::now();
+		try {
+			snes = std::make_unique<SNES>(path, renderer);
+			snes->apu.setMuted(true);
+			const APU::DSP::DSP &dsp = snes->apu.getDSP();
+			uint32_t sampleOffset = dsp.getSamplesCount();
+			start = std::chrono::steady_clock::now();
+			for (; result.frames < this->_frameCount; result.frames++) {
+				this->_inputs.apply(*snes, result.frames);
+				snes->runFrame(this->_isHashing);
+				if (!this->_isHashing)
+					continue;
+				uint32_t newOffset = dsp.getSamplesCount();
+				result.hashes.push_back({
+					renderer.takeVideoHash(),
+					hashSamples(dsp.getSoundBuffer(), sampleOffset, newOffset)
+				});
+				sampleOffset = newOffset;
+			}
+		} catch (const std::exception &exception) {
+			result.error = exception.what();
+		}
+		result.wallTime = std::chrono::steady_clock::now() - start;
+		if (snes) {
+			result.instructions = snes->cpu.instructionCount;
+			result.apuSkippedCycles = snes->apu.idleLoopStatistics.skippedCycles;
+			const APU::DSP::VoiceStatistics &voices = snes->apu.getDSP().voiceStatistics;
+			result.voiceSamples = voices.voiceSamples;
+			result.silentVoiceSamples = voices.silentVoiceSamples;
+			const APU::DSP::BRRCacheStatistics &brrCache = snes->apu.getDSP().brrCacheStatistics;
+			result.brrCacheHits = brrCache.hits;
+			result.brrCacheMisses = brrCache.misses;
+		}
+		return result;
+	}
+
+	std::vector<RomResult> BatchRunner::run(const std::vector<std::string> &roms) const
+	{
+		std::vector<RomResult> results(roms.size());
+		std::atomic<size_t> next = 0;
+		std::vector<std::thread> workers;
+		unsigned workerCount = std::min<size_t>(this->_threadCount, roms.size());
+
+		workers.reserve(workerCount);
+		for (unsigned i = 0; i < workerCount; i++) {
+			workers.emplace_back([&] {
+				for (size_t rom = next++; rom < roms.size(); rom = next++)
+					results[rom] = this->_runRom(roms[rom]);
+			});
+		}
+		for (std::thread &worker : workers)
+			worker.join();
+		return results;
+	}
+
+	unsigned BatchRunner::getThreadCount() const
+	{
+		return this->_threadCount;
+	}
+
+	void BatchRunner::setHashing(bool hashing)
+	{
+		this->_isHashing = hashing;
+	}
+
+	void BatchRunner::setInputScript(InputScript inputs)
+	{
+		this->_inputs = std::move(inputs);
+	}
+}
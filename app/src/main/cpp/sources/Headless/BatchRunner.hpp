@@ -0,0 +1,90 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Headless/GoldenFile.hpp"
+#include "Headless/InputScript.hpp"
+
+namespace ComSquare::Headless
+{
+	//! @brief The result of a rom run by the batch runner.
+	struct RomResult
+	{
+		//! @brief The path of the rom.
+		std::string path;
+		//! @brief The number of frames emulated.
+		uint64_t frames = 0;
+		//! @brief The number of CPU instructions executed.
+		uint64_t instructions = 0;
+		//! @brief The number of SPC700 cycles skipped because the APU was waiting in an idle loop.
+		uint64_t apuSkippedCycles = 0;
+		//! @brief The number of samples computed by the voices of the DSP.
+		uint64_t voiceSamples = 0;
+		//! @brief The number of voice samples skipped because the voice was silent.
+		uint64_t silentVoiceSamples = 0;
+		//! @brief The number of BRR decodes found in the cache of the DSP.
+		uint64_t brrCacheHits = 0;
+		//! @brief The number of BRR decodes that were not in the cache of the DSP.
+		uint64_t brrCacheMisses = 0;
+		//! @brief The wall time taken to emulate the frames (the loading of the rom is not counted).
+		std::chrono::duration<double> wallTime {0};
+		//! @brief The message of the exception that stopped the rom, empty if it ran every frame.
+		std::string error;
+		//! @brief The hashes of each frame emulated (empty if the runner does not hash the frames).
+		std::vector<FrameHash> hashes;
+
+		//! @brief Get the number of frames emulated per second of wall time.
+		[[nodiscard]] double getFramesPerSecond() const;
+		//! @brief Get the number of instructions executed per second of wall time.
+		[[nodiscard]] double getInstructionsPerSecond() const;
+		//! @brief Get the fraction of the voice samples that were skipped because the voice was silent.
+		[[nodiscard]] double getSilentVoiceRatio() const;
+		//! @brief Get the fraction of the BRR decodes that were found in the cache of the DSP.
+		[[nodiscard]] double getBRRCacheHitRate() const;
+	};
+
+	//! @brief Run roms without rendering anything, concurrently on a pool of threads (one console per rom).
+	class BatchRunner
+	{
+	private:
+		//! @brief The number of frames to emulate for each rom.
+		uint64_t _frameCount;
+		//! @brief The number of threads of the pool.
+		unsigned _threadCount;
+		//! @brief True to render each frame and hash its picture and its sound.
+		bool _isHashing = false;
+		//! @brief The inputs given to every rom.
+		InputScript _inputs;
+
+		//! @brief Load a rom and emulate it on the calling thread.
+		[[nodiscard]] RomResult _runRom(const std::string &path) const;
+	public:
+		//! @brief Create a runner.
+		//! @param frameCount The number of frames to emulate for each rom.
+		//! @param threadCount The number of roms run at the same time (0 to use one thread per core).
+		explicit BatchRunner(uint64_t frameCount, unsigned threadCount = 0);
+		BatchRunner(const BatchRunner &) = default;
+		BatchRunner &operator=(const BatchRunner &) = default;
+		~BatchRunner() = default;
+
+		//! @brief Run every rom and wait for all of them.
+		//! @param roms The paths of the roms.
+		//! @return The result of each rom, in the same order as roms. A rom that fails does not stop the others.
+		[[nodiscard]] std::vector<RomResult> run(const std::vector<std::string> &roms) const;
+
+		//! @brief Get the number of threads of the pool.
+		[[nodiscard]] unsigned getThreadCount() const;
+		//! @brief Render each frame and hash its picture and its sound in RomResult::hashes.
+		//! @info Rendering makes the run slower, the emulation itself does not change.
+		void setHashing(bool hashing);
+		//! @brief Set the inputs given to every rom.
+		void setInputScript(InputScript inputs);
+	};
+}
@@ -0,0 +1,72 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "GoldenFile.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "Exceptions/InvalidGoldenFile.hpp"
+
+namespace ComSquare::Headless
+{
+	GoldenFile::GoldenFile(std::vector<FrameHash> frames)
+		: _frames(std::move(frames))
+	{}
+
+	GoldenFile GoldenFile::load(const std::string &path)
+	{
+		std::ifstream file(path);
+		if (!file)
+			throw InvalidGoldenFile("Could not open the golden file " + path + ".");
+		std::string line;
+		if (!std::getline(file, line) || line != magic)
+			throw InvalidGoldenFile(path + " is not a golden file.");
+
+		std::vector<FrameHash> frames;
+		while (std::getline(file, line)) {
+			std::istringstream stream(line);
+			uint64_t frame;
+			FrameHash hash;
+			if (!(stream >> frame >> std::hex >> hash.video >> hash.audio) || frame != frames.size())
+				throw InvalidGoldenFile(path + ":" + std::to_string(frames.size() + 2) + ": invalid frame hash.");
+			frames.push_back(hash);
+		}
+		return GoldenFile(std::move(frames));
+	}
+
+	void GoldenFile::save(const std::string &path) const
+	{
+		std::ofstream file(path);
+		if (!file)
+			throw InvalidGoldenFile("Could not write the golden file " + path + ".");
+		file << magic << '\n' << std::setfill('0');
+		for (size_t i = 0; i < this->_frames.size(); i++) {
+			file << std::dec << i << std::hex
+			     << ' ' << std::setw(16) << this->_frames[i].video
+			     << ' ' << std::setw(16) << this->_frames[i].audio << '\n';
+		}
+		if (!file)
+			throw InvalidGoldenFile("Could not write the golden file " + path + ".");
+	}
+
+	std::optional<Divergence> GoldenFile::compare(const std::vector<FrameHash> &frames) const
+	{
+		size_t count = std::min(frames.size(), this->_frames.size());
+		for (size_t i = 0; i < count; i++) {
+			if (frames[i].video != this->_frames[i].video)
+				return Divergence{i, "video"};
+			if (frames[i].audio != this->_frames[i].audio)
+				return Divergence{i, "audio"};
+		}
+		if (frames.size() != this->_frames.size())
+			return Divergence{count, "length"};
+		return std::nullopt;
+	}
+
+	const std::vector<FrameHash> &GoldenFile::getFrames() const
+	{
+		return this->_frames;
+	}
+}
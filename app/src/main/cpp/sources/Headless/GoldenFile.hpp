@@ -0,0 +1,64 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ComSquare::Headless
+{
+	//! @brief The hashes of the picture and the sound of a frame.
+	struct FrameHash
+	{
+		//! @brief The hash of the pixels drawn during the frame.
+		uint64_t video = 0;
+		//! @brief The hash of the audio samples mixed during the frame.
+		uint64_t audio = 0;
+
+		bool operator==(const FrameHash &) const = default;
+	};
+
+	//! @brief The first difference between a run and its golden file.
+	struct Divergence
+	{
+		//! @brief The first frame that differs.
+		uint64_t frame;
+		//! @brief What differs: "video", "audio" or "length" if the run does not have the same number of frames.
+		std::string component;
+	};
+
+	//! @brief The expected hashes of each frame of a run, used to prove that a change did not modify the output of the emulator.
+	class GoldenFile
+	{
+	private:
+		//! @brief The hashes of each frame.
+		std::vector<FrameHash> _frames;
+	public:
+		//! @brief The first line of a golden file.
+		static constexpr const char *magic = "ComSquare golden 1";
+
+		//! @brief Create a golden file with the hashes of a run.
+		explicit GoldenFile(std::vector<FrameHash> frames = {});
+		GoldenFile(const GoldenFile &) = default;
+		GoldenFile &operator=(const GoldenFile &) = default;
+		~GoldenFile() = default;
+
+		//! @brief Read a golden file written by save.
+		//! @throw InvalidGoldenFile if the file can't be opened or is not a golden file.
+		static GoldenFile load(const std::string &path);
+		//! @brief Write the hashes to a file: a line per frame with its number, its video hash and its audio hash.
+		//! @throw InvalidGoldenFile if the file can't be written.
+		void save(const std::string &path) const;
+
+		//! @brief Find the first frame where a run differs from the golden file.
+		//! @param frames The hashes of each frame of the run.
+		//! @return The first divergence, nothing if the run has the same output.
+		[[nodiscard]] std::optional<Divergence> compare(const std::vector<FrameHash> &frames) const;
+		//! @brief Get the hashes of each frame.
+		[[nodiscard]] const std::vector<FrameHash> &getFrames() const;
+	};
+}
@@ -0,0 +1,64 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "InputScript.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "Exceptions/InvalidGoldenFile.hpp"
+#include "SNES.hpp"
+
+namespace ComSquare::Headless
+{
+	InputScript InputScript::load(const std::string &path)
+	{
+		std::ifstream file(path);
+		if (!file)
+			throw InvalidGoldenFile("Could not open the input script " + path + ".");
+
+		InputScript script;
+		std::string line;
+		for (unsigned lineNumber = 1; std::getline(file, line); lineNumber++) {
+			std::istringstream stream(line.substr(0, line.find('#')));
+			uint64_t frame;
+			unsigned port;
+			std::string buttons;
+			if (!(stream >> frame)) {
+				if (stream.eof())
+					continue;
+				throw InvalidGoldenFile(path + ":" + std::to_string(lineNumber) + ": expected a frame number.");
+			}
+			try {
+				if (!(stream >> port >> buttons) || port > 3)
+					throw std::invalid_argument(buttons);
+				script.add(frame, port, std::stoul(buttons, nullptr, 0));
+			} catch (const std::logic_error &) {
+				throw InvalidGoldenFile(path + ":" + std::to_string(lineNumber) + ": expected \"frame port buttons\".");
+			}
+		}
+		return script;
+	}
+
+	void InputScript::add(uint64_t frame, unsigned port, uint16_t buttons)
+	{
+		auto position = std::upper_bound(this->_events.begin(), this->_events.end(), frame, [](uint64_t value, const Event &event) {
+			return value < event.frame;
+		});
+		this->_events.insert(position, Event{frame, port, buttons});
+	}
+
+	void InputScript::apply(SNES &snes, uint64_t frame) const
+	{
+		auto first = std::lower_bound(this->_events.begin(), this->_events.end(), frame, [](const Event &event, uint64_t value) {
+			return event.frame < value;
+		});
+		for (auto it = first; it != this->_events.end() && it->frame == frame; it++)
+			snes.cpu.setJoypad(it->port, it->buttons);
+	}
+
+	size_t InputScript::size() const
+	{
+		return this->_events.size();
+	}
+}
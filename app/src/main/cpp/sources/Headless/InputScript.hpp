@@ -0,0 +1,57 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ComSquare
+{
+	class SNES;
+
+	namespace Headless
+	{
+		//! @brief Inputs given to a console at fixed frames, so a run can be replayed exactly.
+		//! @info In a file, each line is "frame port buttons": the buttons (see CPU::setJoypad, in decimal or 0x hexadecimal)
+		//! are pressed on the port from the start of the frame until another line changes them. Text after a # is ignored.
+		class InputScript
+		{
+		private:
+			//! @brief A change of the buttons of a port.
+			struct Event
+			{
+				//! @brief The frame from which the buttons are held.
+				uint64_t frame;
+				//! @brief The controller port (0 to 3).
+				unsigned port;
+				//! @brief The buttons held.
+				uint16_t buttons;
+			};
+
+			//! @brief The changes, sorted by frame.
+			std::vector<Event> _events;
+		public:
+			InputScript() = default;
+			InputScript(const InputScript &) = default;
+			InputScript &operator=(const InputScript &) = default;
+			~InputScript() = default;
+
+			//! @brief Read a script from a file.
+			//! @throw InvalidGoldenFile if the file can't be opened or a line is invalid.
+			static InputScript load(const std::string &path);
+
+			//! @brief Hold buttons on a port from a frame.
+			//! @param frame The first frame where the buttons are held.
+			//! @param port The controller port (0 to 3).
+			//! @param buttons The state of the buttons, see CPU::setJoypad.
+			void add(uint64_t frame, unsigned port, uint16_t buttons);
+			//! @brief Give the inputs that change at a frame to a console. Call it before running the frame.
+			void apply(SNES &snes, uint64_t frame) const;
+			//! @brief Get the number of changes of the script.
+			[[nodiscard]] size_t size() const;
+		};
+	}
+}
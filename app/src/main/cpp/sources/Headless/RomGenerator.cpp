@@ -0,0 +1,316 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "RomGenerator.hpp"
+#include <algorithm>
+#include <fstream>
+#include <initializer_list>
+#include "Exceptions/InvalidAction.hpp"
+
+namespace ComSquare::Headless
+{
+	namespace
+	{
+		//! @brief The direct page address of the counter of the loop of the current workload.
+		constexpr uint8_t counterAddress = 0xF0;
+		//! @brief The offset of the header of a LoRom image.
+		constexpr size_t headerOffset = 0x7FC0;
+
+		//! @brief Write 65816 code at the start of a LoRom bank and resolve the addresses of labels.
+		class Assembler
+		{
+		private:
+			//! @brief The image being written.
+			std::vector<uint8_t> &_rom;
+			//! @brief The offset of the next byte written.
+			size_t _offset = 0;
+			//! @brief The address of the labels already placed.
+			std::map<std::string, uint16_t> _labels;
+			//! @brief The offsets where the address of a label should be written, and the label.
+			std::vector<std::pair<size_t, std::string>> _fixups;
+		public:
+			explicit Assembler(std::vector<uint8_t> &rom) : _rom(rom) {}
+
+			//! @brief Write bytes.
+			void emit(std::initializer_list<uint8_t> bytes)
+			{
+				if (this->_offset + bytes.size() > headerOffset)
+					throw InvalidAction("The workload mix does not fit in the synthetic rom.");
+				for (uint8_t byte : bytes)
+					this->_rom[this->_offset++] = byte;
+			}
+
+			//! @brief Write an instruction with the absolute address of a label as operand.
+			void emitWithLabel(uint8_t opcode, const std::string &label)
+			{
+				this->emit({opcode});
+				this->_fixups.emplace_back(this->_offset, label);
+				this->emit({0x00, 0x00});
+			}
+
+			//! @brief Place a label at the current address.
+			void label(const std::string &name)
+			{
+				this->_labels[name] = this->getAddress();
+			}
+
+			//! @brief Get the address of a label already placed.
+			[[nodiscard]] uint16_t getLabel(const std::string &name) const
+			{
+				return this->_labels.at(name);
+			}
+
+			//! @brief Get the address (in the bank $00) of the next byte written.
+			[[nodiscard]] uint16_t getAddress() const
+			{
+				return 0x8000 + this->_offset;
+			}
+
+			//! @brief Write the address of the labels where they are used.
+			void resolve()
+			{
+				for (const auto &[offset, label] : this->_fixups) {
+					uint16_t address = this->_labels.at(label);
+					this->_rom[offset] = address;
+					this->_rom[offset + 1] = address >> 8u;
+				}
+			}
+		};
+
+		//! @brief Write the subroutines called by the Subroutines workload.
+		void emitSubroutines(Assembler &code)
+		{
+			code.label("subroutine1");
+			code.emit({0x48, 0xDA, 0x5A});        // PHA; PHX; PHY
+			code.emitWithLabel(0x20, "subroutine2"); // JSR subroutine2
+			code.emit({0x7A, 0xFA, 0x68, 0x60});  // PLY; PLX; PLA; RTS
+			code.label("subroutine2");
+			code.emit({0xF4, 0x34, 0x12});        // PEA $1234
+			code.emitWithLabel(0x20, "subroutine3"); // JSR subroutine3
+			code.emit({0x68, 0x60});              // PLA; RTS
+			code.label("subroutine3");
+			code.emit({0x08, 0x0B, 0x2B, 0x28});  // PHP; PHD; PLD; PLP
+			code.emit({0xA3, 0x01, 0x60});        // LDA $01,S; RTS
+		}
+
+		//! @brief Write the body of the loop of a workload.
+		void emitWorkload(Assembler &code, Workload workload)
+		{
+			switch (workload) {
+			case Workload::AddressingModes:
+				code.emit({
+					0xA2, 0x10, 0x00,       // LDX #$0010
+					0xA0, 0x20, 0x00,       // LDY #$0020
+					0xA5, 0x10,             // LDA $10
+					0xB5, 0x10,             // LDA $10,X
+					0xAD, 0x00, 0x02,       // LDA $0200
+					0xBD, 0x00, 0x02,       // LDA $0200,X
+					0xB9, 0x00, 0x02,       // LDA $0200,Y
+					0xAF, 0x00, 0x03, 0x7E, // LDA $7E0300
+					0xBF, 0x00, 0x03, 0x7E, // LDA $7E0300,X
+					0xB2, 0x20,             // LDA ($20)
+					0xB1, 0x20,             // LDA ($20),Y
+					0xA1, 0x20,             // LDA ($20,X)
+					0xA7, 0x24,             // LDA [$24]
+					0xB7, 0x24,             // LDA [$24],Y
+					0xA3, 0x01,             // LDA $01,S
+					0x85, 0x12,             // STA $12
+					0x95, 0x12,             // STA $12,X
+					0x8D, 0x10, 0x02,       // STA $0210
+					0x9D, 0x10, 0x02,       // STA $0210,X
+					0x99, 0x10, 0x02,       // STA $0210,Y
+					0x8F, 0x10, 0x03, 0x7E, // STA $7E0310
+					0x92, 0x20,             // STA ($20)
+					0x91, 0x20,             // STA ($20),Y
+				});
+				break;
+			case Workload::Arithmetic16:
+				code.emit({
+					0x18,             // CLC
+					0xA9, 0x34, 0x12, // LDA #$1234
+					0x69, 0x21, 0x43, // ADC #$4321
+					0x6D, 0x00, 0x02, // ADC $0200
+					0x38,             // SEC
+					0xE9, 0x11, 0x11, // SBC #$1111
+					0xED, 0x02, 0x02, // SBC $0202
+					0x0A, 0x4A,       // ASL A; LSR A
+					0x2A, 0x6A,       // ROL A; ROR A
+					0x29, 0xFF, 0x0F, // AND #$0FFF
+					0x09, 0x00, 0x10, // ORA #$1000
+					0x49, 0x55, 0x55, // EOR #$5555
+					0xC9, 0x00, 0x80, // CMP #$8000
+					0x1A, 0x3A,       // INC A; DEC A
+					0xEE, 0x00, 0x02, // INC $0200
+					0xCE, 0x02, 0x02, // DEC $0202
+					0x8D, 0x04, 0x02, // STA $0204
+				});
+				break;
+			case Workload::BlockMoves:
+				code.emit({
+					0xA9, 0xFF, 0x00, // LDA #$00FF
+					0xA2, 0x00, 0x10, // LDX #$1000
+					0xA0, 0x00, 0x11, // LDY #$1100
+					0x54, 0x00, 0x00, // MVN $00,$00
+					0xA9, 0xFF, 0x00, // LDA #$00FF
+					0xA2, 0xFF, 0x11, // LDX #$11FF
+					0xA0, 0xFF, 0x12, // LDY #$12FF
+					0x44, 0x00, 0x00, // MVP $00,$00
+				});
+				break;
+			case Workload::Subroutines:
+				for (int i = 0; i < 4; i++)
+					code.emitWithLabel(0x20, "subroutine1"); // JSR subroutine1
+				break;
+			case Workload::DmaBursts:
+				code.emit({
+					0xE2, 0x20,       // SEP #$20
+					0xA9, 0x80,       // LDA #$80
+					0x8D, 0x15, 0x21, // STA VMAIN
+					0x9C, 0x16, 0x21, // STZ VMADDL
+					0x9C, 0x17, 0x21, // STZ VMADDH
+					0xA9, 0x01,       // LDA #$01 (two registers written once)
+					0x8D, 0x00, 0x43, // STA DMAP0
+					0xA9, 0x18,       // LDA #$18
+					0x8D, 0x01, 0x43, // STA BBAD0 (VMDATAL)
+					0x9C, 0x02, 0x43, // STZ A1T0L
+					0xA9, 0x10,       // LDA #$10
+					0x8D, 0x03, 0x43, // STA A1T0H
+					0xA9, 0x7E,       // LDA #$7E
+					0x8D, 0x04, 0x43, // STA A1B0 (from $7E1000)
+					0x9C, 0x05, 0x43, // STZ DAS0L
+					0xA9, 0x08,       // LDA #$08
+					0x8D, 0x06, 0x43, // STA DAS0H (2KB)
+					0xA9, 0x01,       // LDA #$01
+					0x8D, 0x0B, 0x42, // STA MDMAEN
+					0xC2, 0x20,       // REP #$20
+				});
+				break;
+			}
+		}
+	}
+
+	RomGenerator::RomGenerator(std::string title)
+		: _title(std::move(title))
+	{}
+
+	RomGenerator &RomGenerator::add(Workload workload, unsigned iterations)
+	{
+		if (iterations == 0 || iterations > 0xFFFF)
+			throw InvalidAction("A workload should run between 1 and 65535 times.");
+		this->_mix.push_back({workload, iterations});
+		return *this;
+	}
+
+	std::vector<uint8_t> RomGenerator::generate() const
+	{
+		std::vector<uint8_t> rom(romSize);
+		Assembler code(rom);
+
+		code.emit({
+			0x78,             // SEI
+			0x18, 0xFB,       // CLC; XCE
+			0xC2, 0x30,       // REP #$30
+			0xA2, 0xFF, 0x1E, // LDX #$1EFF
+			0x9A,             // TXS (below the end of the WRAM mirror, so stack relative reads stay in it)
+			0xA9, 0x00, 0x00, // LDA #$0000
+			0x5B,             // TCD
+			0x4B, 0xAB,       // PHK; PLB
+			// The pointers used by the indirect addressing modes.
+			0xA9, 0x00, 0x04, // LDA #$0400
+			0x85, 0x20,       // STA $20
+			0x85, 0x30,       // STA $30
+			0xA9, 0x00, 0x05, // LDA #$0500
+			0x85, 0x24,       // STA $24
+			0x64, 0x26,       // STZ $26
+		});
+		code.emitWithLabel(0x4C, "main"); // JMP main
+		code.label("interrupt");
+		code.emit({0x40});                // RTI
+		emitSubroutines(code);
+
+		code.label("main");
+		for (size_t i = 0; i < this->_mix.size(); i++) {
+			const Entry &entry = this->_mix[i];
+			std::string loop = "loop" + std::to_string(i);
+			code.emit({0xA9, static_cast<uint8_t>(entry.iterations), static_cast<uint8_t>(entry.iterations >> 8u)}); // LDA #iterations
+			code.emit({0x85, counterAddress});  // STA counter
+			code.label(loop);
+			emitWorkload(code, entry.workload);
+			code.emit({0xC6, counterAddress});  // DEC counter
+			code.emit({0xF0, 0x03});            // BEQ +3
+			code.emitWithLabel(0x4C, loop);     // JMP loop
+		}
+		code.emitWithLabel(0x4C, "main");   // JMP main
+		code.resolve();
+
+		std::string title = this->_title.substr(0, 21);
+		title.resize(21, ' ');
+		std::copy(title.begin(), title.end(), rom.begin() + headerOffset);
+		rom[headerOffset + 0x15] = 0x20; // LoRom, SlowRom
+		rom[headerOffset + 0x16] = 0x00; // Rom only
+		rom[headerOffset + 0x17] = 0x05; // 32KB
+		rom[headerOffset + 0x18] = 0x00; // No SRAM
+		rom[headerOffset + 0x19] = 0x01; // North America
+		rom[headerOffset + 0x1A] = 0x33;
+		rom[headerOffset + 0x1B] = 0x00; // Version
+		// Every interrupt vector points to the RTI, the reset vector to the start of the code.
+		uint16_t interrupt = code.getLabel("interrupt");
+		for (size_t vector = 0x24; vector < 0x40; vector += 2) {
+			rom[headerOffset + vector] = interrupt;
+			rom[headerOffset + vector + 1] = interrupt >> 8u;
+		}
+		rom[headerOffset + 0x3C] = 0x00;
+		rom[headerOffset + 0x3D] = 0x80;
+
+		// The checksum is computed with a complement of $FFFF and a checksum of $0000, which sum to the same bytes as the real ones.
+		rom[headerOffset + 0x1C] = 0xFF;
+		rom[headerOffset + 0x1D] = 0xFF;
+		rom[headerOffset + 0x1E] = 0x00;
+		rom[headerOffset + 0x1F] = 0x00;
+		uint16_t checksum = 0;
+		for (uint8_t byte : rom)
+			checksum += byte;
+		rom[headerOffset + 0x1C] = ~checksum;
+		rom[headerOffset + 0x1D] = ~checksum >> 8u;
+		rom[headerOffset + 0x1E] = checksum;
+		rom[headerOffset + 0x1F] = checksum >> 8u;
+		return rom;
+	}
+
+	void RomGenerator::write(const std::string &path) const
+	{
+		std::vector<uint8_t> rom = this->generate();
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char *>(rom.data()), rom.size());
+		if (!file)
+			throw InvalidAction("Could not write the synthetic rom " + path + ".");
+	}
+
+	Workload RomGenerator::parseWorkload(const std::string &name)
+	{
+		for (Workload workload : {Workload::AddressingModes, Workload::Arithmetic16, Workload::BlockMoves,
+		                          Workload::Subroutines, Workload::DmaBursts}) {
+			if (getName(workload) == name)
+				return workload;
+		}
+		throw InvalidAction("Unknown workload " + name + ".");
+	}
+
+	std::string RomGenerator::getName(Workload workload)
+	{
+		switch (workload) {
+		case Workload::AddressingModes:
+			return "addressing";
+		case Workload::Arithmetic16:
+			return "arithmetic";
+		case Workload::BlockMoves:
+			return "blockmove";
+		case Workload::Subroutines:
+			return "subroutines";
+		case Workload::DmaBursts:
+			return "dma";
+		}
+		throw InvalidAction("Unknown workload.");
+	}
+}
@@ -0,0 +1,75 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ComSquare::Headless
+{
+	//! @brief A kind of code run by a synthetic rom.
+	enum class Workload
+	{
+		//! @brief Loads and stores through every data addressing mode (direct page, absolute, long, indexed, indirect, stack relative).
+		AddressingModes,
+		//! @brief 16 bits additions, subtractions, shifts, logical operations and read-modify-write instructions.
+		Arithmetic16,
+		//! @brief 256 bytes block moves with MVN and MVP.
+		BlockMoves,
+		//! @brief Chains of JSR/RTS pushing and pulling registers on the stack.
+		Subroutines,
+		//! @brief DMA transfers of 2KB from the WRAM to the VRAM.
+		DmaBursts
+	};
+
+	//! @brief Build small LoRom images running a configurable mix of workloads, to benchmark the CPU and the bus without a commercial rom.
+	//! @info The rom switches to the native mode with 16 bits registers, then runs each workload of the mix in a loop, in order, forever.
+	class RomGenerator
+	{
+	private:
+		//! @brief A workload of the mix and the number of times it runs before the next one.
+		struct Entry
+		{
+			Workload workload;
+			unsigned iterations;
+		};
+
+		//! @brief The name written in the header.
+		std::string _title;
+		//! @brief The workloads run by the rom, in order.
+		std::vector<Entry> _mix;
+	public:
+		//! @brief The size of the images (a single LoRom bank).
+		static constexpr size_t romSize = 0x8000;
+
+		//! @brief Create a generator with an empty mix (the rom only loops).
+		//! @param title The name of the game written in the header (truncated to 21 characters).
+		explicit RomGenerator(std::string title = "COMSQUARE SYNTHETIC");
+		RomGenerator(const RomGenerator &) = default;
+		RomGenerator &operator=(const RomGenerator &) = default;
+		~RomGenerator() = default;
+
+		//! @brief Add a workload at the end of the mix.
+		//! @param workload The code to run.
+		//! @param iterations The number of times the code runs in a row (1 to 65535).
+		//! @throw InvalidAction if iterations is out of range.
+		//! @return This generator, to chain the calls.
+		RomGenerator &add(Workload workload, unsigned iterations = 16);
+		//! @brief Build the image: the code, a valid LoRom header with its checksum and the interrupt vectors.
+		//! @throw InvalidAction if the mix does not fit in the rom.
+		[[nodiscard]] std::vector<uint8_t> generate() const;
+		//! @brief Build the image and write it to a file.
+		//! @throw InvalidAction if the file can't be written.
+		void write(const std::string &path) const;
+
+		//! @brief Get a workload from its name (see getName).
+		//! @throw InvalidAction if there is no workload with this name.
+		static Workload parseWorkload(const std::string &name);
+		//! @brief Get the name of a workload: "addressing", "arithmetic", "blockmove", "subroutines" or "dma".
+		static std::string getName(Workload workload);
+	};
+}
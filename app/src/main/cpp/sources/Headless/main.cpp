@@ -0,0 +1,185 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Headless/BatchRunner.hpp"
+#include "Headless/RomGenerator.hpp"
+#include "Exceptions/InvalidAction.hpp"
+#include "Exceptions/InvalidGoldenFile.hpp"
+
+using namespace ComSquare;
+
+//! @brief Print how to use the headless runner.
+static void usage(const char *name)
+{
+	std::cerr << "Usage: " << name << " [-f frames] [-j threads] [-i inputs] [--record | --check] [-g directory] [-s workloads] rom..." << std::endl
+	          << "Run each rom without rendering for the given number of frames (600 by default)," << std::endl
+	          << "on a pool of threads (one per core by default), and report the emulation speed." << std::endl
+	          << "  -i inputs     Give the inputs of a script (\"frame port buttons\" lines) to each rom." << std::endl
+	          << "  --record      Render the frames and write the hashes of their picture and sound to golden files." << std::endl
+	          << "  --check       Render the frames and compare their hashes to the golden files." << std::endl
+	          << "  -g directory  Where the golden files (named after the roms) are, next to the roms by default." << std::endl
+	          << "  -s workloads  Also run a synthetic rom made of comma separated workloads, each optionally followed by" << std::endl
+	          << "                :iterations (addressing, arithmetic, blockmove, subroutines, dma)." << std::endl;
+}
+
+//! @brief Write a synthetic rom in the temporary directory.
+//! @param mix The workloads, separated by commas, for example "arithmetic:4,dma".
+//! @return The path of the rom.
+static std::string generateRom(const std::string &mix)
+{
+	Headless::RomGenerator generator(mix);
+	std::istringstream stream(mix);
+	std::string workload;
+	while (std::getline(stream, workload, ',')) {
+		size_t separator = workload.find(':');
+		if (separator == std::string::npos)
+			generator.add(Headless::RomGenerator::parseWorkload(workload));
+		else
+			generator.add(Headless::RomGenerator::parseWorkload(workload.substr(0, separator)),
+			              std::stoul(workload.substr(separator + 1)));
+	}
+	std::string name = mix;
+	std::replace_if(name.begin(), name.end(), [](char c) { return !std::isalnum(c); }, '_');
+	std::string path = (std::filesystem::temp_directory_path() / ("comsquare_synthetic_" + name + ".sfc")).string();
+	generator.write(path);
+	return path;
+}
+
+//! @brief The mode of the golden files.
+enum class GoldenMode
+{
+	//! @brief The frames are not hashed.
+	None,
+	//! @brief The hashes are written to the golden files.
+	Record,
+	//! @brief The hashes are compared to the golden files.
+	Check
+};
+
+//! @brief Get the path of the golden file of a rom.
+static std::string getGoldenPath(const std::string &rom, const std::string &directory)
+{
+	std::filesystem::path path(rom);
+	std::filesystem::path parent = directory.empty() ? path.parent_path() : std::filesystem::path(directory);
+	return (parent / (path.filename().string() + ".golden")).string();
+}
+
+//! @brief Record or check the golden file of a rom and print the outcome.
+//! @return False if the rom does not match its golden file.
+static bool handleGolden(const Headless::RomResult &result, GoldenMode mode, const std::string &directory)
+{
+	std::string path = getGoldenPath(result.path, directory);
+	try {
+		if (mode == GoldenMode::Record) {
+			Headless::GoldenFile(result.hashes).save(path);
+			std::cout << "  recorded " << result.hashes.size() << " frames to " << path << std::endl;
+			return true;
+		}
+		std::optional<Headless::Divergence> divergence = Headless::GoldenFile::load(path).compare(result.hashes);
+		if (!divergence) {
+			std::cout << "  matches " << path << std::endl;
+			return true;
+		}
+		std::cout << "  diverges from " << path << " at frame " << divergence->frame
+		          << " (" << divergence->component << ")" << std::endl;
+	} catch (const InvalidGoldenFile &exception) {
+		std::cout << "  " << exception.what() << std::endl;
+	}
+	return false;
+}
+
+int main(int argc, char **argv)
+{
+	uint64_t frames = 600;
+	unsigned threads = 0;
+	GoldenMode mode = GoldenMode::None;
+	std::string goldenDirectory;
+	Headless::InputScript inputs;
+	std::vector<std::string> roms;
+
+	try {
+		for (int i = 1; i < argc; i++) {
+			std::string arg = argv[i];
+			if ((arg == "-f" || arg == "-j") && i + 1 < argc) {
+				unsigned long value = std::stoul(argv[++i]);
+				if (arg == "-f")
+					frames = value;
+				else
+					threads = value;
+			} else if (arg == "-i" && i + 1 < argc) {
+				inputs = Headless::InputScript::load(argv[++i]);
+			} else if (arg == "-s" && i + 1 < argc) {
+				roms.push_back(generateRom(argv[++i]));
+			} else if (arg == "-g" && i + 1 < argc) {
+				goldenDirectory = argv[++i];
+			} else if (arg == "--record") {
+				mode = GoldenMode::Record;
+			} else if (arg == "--check") {
+				mode = GoldenMode::Check;
+			} else if (arg == "-h" || arg == "--help") {
+				usage(argv[0]);
+				return 0;
+			} else if (arg[0] == '-') {
+				usage(argv[0]);
+				return 1;
+			} else
+				roms.push_back(arg);
+		}
+	} catch (const std::logic_error &) {
+		usage(argv[0]);
+		return 1;
+	} catch (const InvalidGoldenFile &exception) {
+		std::cerr << exception.what() << std::endl;
+		return 1;
+	} catch (const InvalidAction &exception) {
+		std::cerr << exception.what() << std::endl;
+		return 1;
+	}
+	if (roms.empty()) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	Headless::BatchRunner runner(frames, threads);
+	runner.setHashing(mode != GoldenMode::None);
+	runner.setInputScript(std::move(inputs));
+	auto start = std::chrono::steady_clock::now();
+	std::vector<Headless::RomResult> results = runner.run(roms);
+	std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - start;
+
+	uint64_t totalFrames = 0;
+	uint64_t totalInstructions = 0;
+	int status = 0;
+	std::cout << std::fixed << std::setprecision(2);
+	for (const Headless::RomResult &result : results) {
+		std::cout << result.path << ": " << result.frames << " frames in " << result.wallTime.count() << "s, "
+		          << result.getFramesPerSecond() << " fps, "
+		          << static_cast<uint64_t>(result.getInstructionsPerSecond()) << " instructions/s, "
+		          << result.apuSkippedCycles << " idle APU cycles skipped, "
+		          << result.getSilentVoiceRatio() * 100 << "% silent voice samples skipped, "
+		          << result.getBRRCacheHitRate() * 100 << "% BRR cache hits";
+		if (!result.error.empty()) {
+			std::cout << " (stopped: " << result.error << ")";
+			status = 1;
+		}
+		std::cout << std::endl;
+		if (mode != GoldenMode::None && !handleGolden(result, mode, goldenDirectory))
+			status = 1;
+		totalFrames += result.frames;
+		totalInstructions += result.instructions;
+	}
+	std::cout << "Total: " << results.size() << " roms on " << runner.getThreadCount() << " threads, "
+	          << totalFrames << " frames in " << wallTime.count() << "s, "
+	          << totalFrames / wallTime.count() << " fps, "
+	          << static_cast<uint64_t>(totalInstructions / wallTime.count()) << " instructions/s" << std::endl;
+	return status;
+}
@@ -15,11 +15,12 @@ namespace ComSquare::PPU::Utils::Debug {
 
 namespace ComSquare::PPU
 {
-	PPU::PPU(Renderer::IRenderer &renderer):
+	PPU::PPU(Renderer::IRenderer &renderer, const Scheduler::Scheduler &scheduler):
 		vram(VramSize, ComSquare::VRam, "VRAM"),
 		oamram(OAMRamSize, ComSquare::OAMRam, "OAMRAM"),
 		cgram(CGRamSize, ComSquare::CGRam, "CGRAM"),
 		_renderer(renderer),
+		_scheduler(scheduler),
 		_backgrounds{
 			Background(*this, 1),
 			Background(*this, 2),
@@ -27,7 +28,8 @@ namespace ComSquare::PPU
 			Background(*this, 4),
 		},
 		_mainScreen({{{0}}}),
-		_subScreen({{{0}}})
+		_subScreen({{{0}}}),
+		_screen({{{0}}})
 	{
 		this->_registers._isLowByte = true;
 
@@ -45,6 +47,7 @@ namespace ComSquare::PPU
 		case PpuRegisters::mpyh:
 			return this->_registers._mpy.mpyh;
 		case PpuRegisters::slhv:
+			this->latchCounters();
 			return this->_registers._slhv;
 		case PpuRegisters::oamdataread:
 			return 0;
@@ -69,11 +72,30 @@ namespace ComSquare::PPU
 		case PpuRegisters::cgdataread: {
 			return this->cgram.read(this->_registers._cgadd++);
 		}
-		case PpuRegisters::ophct:
-		case PpuRegisters::opvct:
+		case PpuRegisters::ophct: {
+			auto returnValue = this->_registers._isOphctHighByte
+				? static_cast<uint8_t>(this->_registers._ophct.opct >> 8)
+				: static_cast<uint8_t>(this->_registers._ophct.opct);
+			this->_registers._isOphctHighByte = !this->_registers._isOphctHighByte;
+			return returnValue;
+		}
+		case PpuRegisters::opvct: {
+			auto returnValue = this->_registers._isOpvctHighByte
+				? static_cast<uint8_t>(this->_registers._opvct.opct >> 8)
+				: static_cast<uint8_t>(this->_registers._opvct.opct);
+			this->_registers._isOpvctHighByte = !this->_registers._isOpvctHighByte;
+			return returnValue;
+		}
 		case PpuRegisters::stat77:
-		case PpuRegisters::stat78:
 			return 0;
+		case PpuRegisters::stat78: {
+			this->_registers._stat78.interlaceField = this->_scheduler.getFrame() & 1u;
+			auto returnValue = this->_registers._stat78.raw;
+			this->_registers._stat78.externalLatchFlag = false;
+			this->_registers._isOphctHighByte = false;
+			this->_registers._isOpvctHighByte = false;
+			return returnValue;
+		}
 		default:
 			throw InvalidAddress("PPU Internal Registers read ", addr + this->_start);
  		}
@@ -664,6 +686,33 @@ namespace ComSquare::PPU
 		return this->_registers._bgmode.bgMode;
 	}
 
+	void PPU::saveState(SaveState::SaveState &state) const
+	{
+		state.write(this->_registers);
+		state.write(this->_vramReadBuffer);
+		state.write(this->_ppuState);
+		this->vram.saveState(state);
+		this->oamram.saveState(state);
+		this->cgram.saveState(state);
+	}
+
+	void PPU::loadState(SaveState::SaveState &state)
+	{
+		state.read(this->_registers);
+		state.read(this->_vramReadBuffer);
+		state.read(this->_ppuState);
+		this->vram.loadState(state);
+		this->oamram.loadState(state);
+		this->cgram.loadState(state);
+	}
+
+	void PPU::latchCounters()
+	{
+		this->_registers._ophct.opct = this->_scheduler.getHCounter();
+		this->_registers._opvct.opct = this->_scheduler.getVCounter();
+		this->_registers._stat78.externalLatchFlag = true;
+	}
+
 	void PPU::updateVramReadBuffer()
 	{
 		this->_vramReadBuffer = this->vram.read(this->getVramAddress());
@@ -14,6 +14,7 @@
 #include "Background.hpp"
 #include "PPU/PPUUtils.hpp"
 #include "PPU/PPURegisters.hpp"
+#include "Scheduler/Scheduler.hpp"
 
 #ifdef DEBUGGER_ENABLED
 #include "Debugger/TileViewer/RAMTileRenderer.hpp"
@@ -53,6 +54,8 @@ namespace ComSquare::PPU
 		//! @brief Init ppuRegisters
 		Registers _registers{};
 		Renderer::IRenderer &_renderer;
+		//! @brief The master clock, used to compute the H/V counters when they are latched.
+		const Scheduler::Scheduler &_scheduler;
 		//! @brief Backgrounds buffers
 		Background _backgrounds[4];
 		//! @brief Main Screen buffer
@@ -70,7 +73,7 @@ namespace ComSquare::PPU
 
 	public:
 
-		explicit PPU(Renderer::IRenderer &renderer);
+		PPU(Renderer::IRenderer &renderer, const Scheduler::Scheduler &scheduler);
 		PPU(const PPU &) = delete;
 		~PPU() override = default;
 		PPU &operator=(const PPU &) = delete;
@@ -129,6 +132,13 @@ namespace ComSquare::PPU
 		[[nodiscard]] int getBgMode() const;
 		//! @brief update the Vram buffer
 		void updateVramReadBuffer();
+		//! @brief Latch the current H/V counters to OPHCT and OPVCT.
+		void latchCounters();
+		//! @brief Write the registers and the memories of the PPU to a save state.
+		//! @info The screen buffers are not saved, they are rendered again on the next update.
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Restore the registers and the memories of the PPU from a save state.
+		void loadState(SaveState::SaveState &state);
 		//! @brief update the Vram buffer
 		[[nodiscard]] Vector2<int> getBgScroll(int bgNumber) const;
 		//! @brief Allow to look the value of each write register (used by Register debugger)
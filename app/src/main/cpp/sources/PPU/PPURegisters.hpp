@@ -485,14 +485,28 @@ namespace ComSquare::PPU
 			};
 			uint16_t raw = 0;
 		} _cgdataread;
-		//! @brief OPHCT/OPVCT - Horizontal/Vertical Scanline Location
+		//! @brief OPHCT - Horizontal Scanline Location (latched by a read of SLHV)
 		union {
 			struct {
 				uint16_t opct: 9;
 				uint16_t _: 7;
 			};
 			uint16_t raw = 0;
-		} _opct;
+		} _ophct;
+		//! @brief OPVCT - Vertical Scanline Location (latched by a read of SLHV)
+		union {
+			struct {
+				uint16_t opct: 9;
+				uint16_t _: 7;
+			};
+			uint16_t raw = 0;
+		} _opvct;
+		//! @brief This bool is used for reading either the low byte of OPHCT (first call) or the high byte (second call)
+		//! @info This bool is reset by a read of STAT78
+		bool _isOphctHighByte = false;
+		//! @brief This bool is used for reading either the low byte of OPVCT (first call) or the high byte (second call)
+		//! @info This bool is reset by a read of STAT78
+		bool _isOpvctHighByte = false;
 		//! @brief STAT77 - PPU Status Flag and Version
 		union {
 			struct {
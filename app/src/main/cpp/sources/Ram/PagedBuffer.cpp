@@ -0,0 +1,106 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "PagedBuffer.hpp"
+
+namespace ComSquare::Ram
+{
+	PagedBuffer::PagedBuffer(size_t size)
+	{
+		this->resize(size);
+	}
+
+	PagedBuffer::Iterator PagedBuffer::begin()
+	{
+		return Iterator(*this, 0);
+	}
+
+	PagedBuffer::Iterator PagedBuffer::end()
+	{
+		return Iterator(*this, this->_size);
+	}
+
+	size_t PagedBuffer::size() const
+	{
+		return this->_size;
+	}
+
+	void PagedBuffer::resize(size_t size)
+	{
+		if (size < this->_size && size % pageSize) {
+			// Clear the end of the last page so the bytes are zero if the buffer grows again.
+			Page &last = this->_ownPage(size / pageSize);
+			std::fill(last.begin() + size % pageSize, last.end(), 0);
+		}
+		size_t pageCount = (size + pageSize - 1) / pageSize;
+		size_t oldCount = this->_pages.size();
+		this->_pages.resize(pageCount);
+		for (size_t i = oldCount; i < pageCount; i++)
+			this->_pages[i] = std::make_shared<Page>();
+		this->_size = size;
+	}
+
+	size_t PagedBuffer::getPageCount() const
+	{
+		return this->_pages.size();
+	}
+
+	std::span<const uint8_t> PagedBuffer::getPage(size_t page) const
+	{
+		return std::span(this->_pages[page]->data(), std::min(pageSize, this->_size - page * pageSize));
+	}
+
+	std::span<uint8_t> PagedBuffer::getPage(size_t page)
+	{
+		return std::span(this->_ownPage(page).data(), std::min(pageSize, this->_size - page * pageSize));
+	}
+
+	void PagedBuffer::copyTo(size_t addr, std::span<uint8_t> output) const
+	{
+		size_t copied = 0;
+		while (copied < output.size()) {
+			size_t offset = (addr + copied) % pageSize;
+			size_t count = std::min(pageSize - offset, output.size() - copied);
+			std::memcpy(output.data() + copied, this->_pages[(addr + copied) / pageSize]->data() + offset, count);
+			copied += count;
+		}
+	}
+
+	void PagedBuffer::copyFrom(size_t addr, std::span<const uint8_t> data)
+	{
+		size_t copied = 0;
+		while (copied < data.size()) {
+			size_t offset = (addr + copied) % pageSize;
+			size_t count = std::min(pageSize - offset, data.size() - copied);
+			Page &page = this->_ownPage((addr + copied) / pageSize);
+			std::memcpy(page.data() + offset, data.data() + copied, count);
+			copied += count;
+		}
+	}
+
+	bool PagedBuffer::operator==(const PagedBuffer &other) const
+	{
+		if (this->_size != other._size)
+			return false;
+		for (size_t i = 0; i < this->_pages.size(); i++) {
+			if (this->_pages[i] != other._pages[i] && !std::ranges::equal(this->getPage(i), other.getPage(i)))
+				return false;
+		}
+		return true;
+	}
+
+	size_t PagedBuffer::getSharedPageCount() const
+	{
+		return std::count_if(this->_pages.begin(), this->_pages.end(), [](const std::shared_ptr<Page> &page) {
+			return page.use_count() > 1;
+		});
+	}
+
+	size_t PagedBuffer::getOwnedBytes() const
+	{
+		return (this->_pages.size() - this->getSharedPageCount()) * pageSize;
+	}
+}
@@ -0,0 +1,133 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace ComSquare::Ram
+{
+	//! @brief A byte buffer split in pages that are shared between copies until one of them writes to it (copy on write).
+	//! @info Copying a buffer only copies the page table, so cloning a memory costs a few pointers per page.
+	//! The pages are released when the last buffer using them is destroyed.
+	class PagedBuffer
+	{
+	public:
+		//! @brief The number of bytes of a page.
+		static constexpr size_t pageSize = 0x1000;
+	private:
+		//! @brief A page of the buffer.
+		using Page = std::array<uint8_t, pageSize>;
+
+		//! @brief The number of bytes of the buffer (the last page can be partially used).
+		size_t _size = 0;
+		//! @brief The pages of the buffer, possibly shared with other buffers.
+		std::vector<std::shared_ptr<Page>> _pages;
+
+		//! @brief Make sure the page is only used by this buffer, copying it if it is shared.
+		//! @return The page, which can be modified.
+		inline Page &_ownPage(size_t page)
+		{
+			std::shared_ptr<Page> &ptr = this->_pages[page];
+			if (ptr.use_count() > 1)
+				ptr = std::make_shared<Page>(*ptr);
+			return *ptr;
+		}
+	public:
+		//! @brief An iterator writing to the buffer (used to copy data into it with the standard algorithms).
+		class Iterator
+		{
+		private:
+			//! @brief The buffer iterated.
+			PagedBuffer *_buffer = nullptr;
+			//! @brief The current position.
+			size_t _index = 0;
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = uint8_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer = uint8_t *;
+			using reference = uint8_t &;
+
+			Iterator() = default;
+			Iterator(PagedBuffer &buffer, size_t index) : _buffer(&buffer), _index(index) {}
+
+			inline uint8_t &operator*() const { return (*this->_buffer)[this->_index]; }
+			inline Iterator &operator++() { this->_index++; return *this; }
+			inline Iterator operator++(int) { Iterator old = *this; this->_index++; return old; }
+			inline Iterator operator+(difference_type offset) const { return Iterator(*this->_buffer, this->_index + offset); }
+			inline bool operator==(const Iterator &other) const { return this->_index == other._index; }
+		};
+
+		//! @brief Create a buffer filled with zeros.
+		explicit PagedBuffer(size_t size = 0);
+		//! @brief Copying a buffer shares all of its pages.
+		PagedBuffer(const PagedBuffer &) = default;
+		//! @brief Assigning a buffer shares all of its pages.
+		PagedBuffer &operator=(const PagedBuffer &) = default;
+		~PagedBuffer() = default;
+
+		//! @brief Read a byte without copying the page.
+		[[nodiscard]] inline uint8_t read(size_t addr) const
+		{
+			return (*this->_pages[addr / pageSize])[addr % pageSize];
+		}
+		//! @brief Write a byte, copying the page first if it is shared.
+		inline void write(size_t addr, uint8_t data)
+		{
+			this->_ownPage(addr / pageSize)[addr % pageSize] = data;
+		}
+
+		//! @brief Get a byte that can be modified. The page is copied if it is shared, even if the byte is only read.
+		inline uint8_t &operator[](size_t addr)
+		{
+			return this->_ownPage(addr / pageSize)[addr % pageSize];
+		}
+		//! @brief Get a byte.
+		inline const uint8_t &operator[](size_t addr) const
+		{
+			return (*this->_pages[addr / pageSize])[addr % pageSize];
+		}
+
+		//! @brief Get an iterator writing from the first byte.
+		[[nodiscard]] Iterator begin();
+		//! @brief Get an iterator past the last byte.
+		[[nodiscard]] Iterator end();
+
+		//! @brief Get the number of bytes of the buffer.
+		[[nodiscard]] size_t size() const;
+		//! @brief Change the size of the buffer. New bytes are set to zero.
+		void resize(size_t size);
+
+		//! @brief Get the number of pages of the buffer.
+		[[nodiscard]] size_t getPageCount() const;
+		//! @brief Get the used part of a page.
+		[[nodiscard]] std::span<const uint8_t> getPage(size_t page) const;
+		//! @brief Get the used part of a page that can be modified. The page is copied if it is shared.
+		[[nodiscard]] std::span<uint8_t> getPage(size_t page);
+
+		//! @brief Copy bytes of the buffer to output.
+		//! @param addr The address of the first byte to copy.
+		//! @param output Where to copy the bytes. Its size is the number of bytes copied.
+		void copyTo(size_t addr, std::span<uint8_t> output) const;
+		//! @brief Copy data to the buffer.
+		//! @param addr The address of the first byte to overwrite.
+		//! @param data The bytes to copy.
+		void copyFrom(size_t addr, std::span<const uint8_t> data);
+
+		//! @brief Compare the content of two buffers (shared pages are not compared byte by byte).
+		bool operator==(const PagedBuffer &other) const;
+
+		//! @brief Get the number of pages of this buffer that are also used by another buffer.
+		[[nodiscard]] size_t getSharedPageCount() const;
+		//! @brief Get the number of bytes allocated for the pages only used by this buffer.
+		[[nodiscard]] size_t getOwnedBytes() const;
+	};
+}
@@ -12,7 +12,8 @@ namespace ComSquare::Ram
 	Ram::Ram(size_t size, Component type, std::string ramName)
 		: _data(size),
 		  _ramType(type),
-		  _ramName(std::move(ramName))
+		  _ramName(std::move(ramName)),
+		  _pageVersions((size + 0xFF) >> 8u)
 	{ }
 
 	uint8_t &Ram::operator[](uint24_t addr)
@@ -30,14 +31,18 @@ namespace ComSquare::Ram
 		// TODO read/write after the size of the rom should noop or behave like a mirror. I don't really know.
 		if (addr >= this->_data.size())
 			throw InvalidAddress(this->getName() + " read", addr);
-		return this->_data[addr];
+		return this->_data.read(addr);
 	}
 
 	void Ram::write(uint24_t addr, uint8_t data)
 	{
 		if (addr >= this->_data.size())
 			throw InvalidAddress(this->getName() + " write", addr);
-		this->_data[addr] = data;
+		this->_data.write(addr, data);
+		// Subclasses can resize the data without calling setSize so the versions are grown lazily.
+		if ((addr >> 8u) >= this->_pageVersions.size())
+			this->_pageVersions.resize((addr >> 8u) + 1);
+		this->_pageVersions[addr >> 8u]++;
 	}
 
 	uint24_t Ram::getSize() const
@@ -48,6 +53,46 @@ namespace ComSquare::Ram
 	void Ram::setSize(uint24_t size)
 	{
 		this->_data.resize(size);
+		this->_pageVersions.resize((size + 0xFF) >> 8u);
+	}
+
+	uint32_t Ram::getPageVersion(uint24_t addr) const
+	{
+		if ((addr >> 8u) >= this->_pageVersions.size())
+			return 0;
+		return this->_pageVersions[addr >> 8u];
+	}
+
+	void Ram::saveState(SaveState::SaveState &state) const
+	{
+		uint24_t size = this->_data.size();
+		state.write(size);
+		if (state.isSharingMemories()) {
+			state.shareMemory(this->_data);
+			return;
+		}
+		for (size_t i = 0; i < this->_data.getPageCount(); i++) {
+			std::span<const uint8_t> page = this->_data.getPage(i);
+			state.write(page.data(), page.size());
+		}
+	}
+
+	void Ram::loadState(SaveState::SaveState &state)
+	{
+		uint24_t size;
+		state.read(size);
+		if (size != this->_data.size())
+			throw InvalidSaveState("The " + this->getName() + " of the state does not have the same size.");
+		if (state.isSharingMemories()) {
+			this->_data = state.readSharedMemory(size);
+		} else {
+			for (size_t i = 0; i < this->_data.getPageCount(); i++) {
+				std::span<uint8_t> page = this->_data.getPage(i);
+				state.read(page.data(), page.size());
+			}
+		}
+		for (uint32_t &version : this->_pageVersions)
+			version++;
 	}
 
 	std::string Ram::getName() const
@@ -60,13 +105,18 @@ namespace ComSquare::Ram
 		return this->_ramType;
 	}
 
-	std::span<uint8_t> Ram::getData()
+	void Ram::copyTo(uint24_t addr, std::span<uint8_t> output) const
+	{
+		this->_data.copyTo(addr, output);
+	}
+
+	void Ram::copyFrom(uint24_t addr, std::span<const uint8_t> data)
 	{
-		return std::span(this->_data);
+		this->_data.copyFrom(addr, data);
 	}
 
-	std::span<const uint8_t> Ram::getData() const
+	const PagedBuffer &Ram::getPages() const
 	{
-		return std::span(this->_data);
+		return this->_data;
 	}
 }
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "Memory/ARectangleMemory.hpp"
+#include "Ram/PagedBuffer.hpp"
+#include "SaveState/SaveState.hpp"
 #include <string>
 #include <span>
 #include <vector>
@@ -15,11 +17,14 @@ namespace ComSquare::Ram
 	{
 	protected:
 		//! @brief The ram. (Can be used for WRam, SRam, VRam etc)
-		std::vector<uint8_t> _data;
+		//! @info The pages are shared with the clones of this ram until one of them writes to it.
+		PagedBuffer _data;
 		//! @brief An id identifying the type of memory this is (for the debugger)
 		Component _ramType;
 		//! @brief The name of this ram.
 		std::string _ramName;
+		//! @brief The number of writes made to each page (of 256 bytes) of this ram. Used to detect self modifying code.
+		std::vector<uint32_t> _pageVersions;
 	public:
 		//! @brief Create a ram of a given size in bytes.
 		explicit Ram(size_t size, Component, std::string ramName);
@@ -63,12 +68,28 @@ namespace ComSquare::Ram
 		//! @brief size The new size of this ram.
 		void setSize(uint24_t size);
 
-		//! @brief Get the raw data of the RAM
-		//! @return A raw accessor to the data.
-		[[nodiscard]] std::span<uint8_t> getData();
+		//! @brief Get the number of writes made to the page (of 256 bytes) containing the address.
+		//! @param addr The local address to check.
+		//! @info Writes made with operator[] or getData are not counted.
+		[[nodiscard]] uint32_t getPageVersion(uint24_t addr) const;
 
-		//! @brief Get the raw data of the RAM
-		//! @return A raw accessor to the data.
-		[[nodiscard]] std::span<const uint8_t> getData() const;
+		//! @brief Write the content of this ram to a save state.
+		//! @info If the state is sharing memories, the pages are shared with the state instead of being copied.
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Restore the content of this ram from a save state. Every page is considered modified.
+		//! @throw InvalidSaveState if the ram had another size when the state was saved.
+		void loadState(SaveState::SaveState &state);
+
+		//! @brief Copy bytes of the ram to output (writes are not counted).
+		//! @param addr The address of the first byte to copy.
+		//! @param output Where to copy the bytes. Its size is the number of bytes copied.
+		void copyTo(uint24_t addr, std::span<uint8_t> output) const;
+		//! @brief Copy data to the ram (writes are not counted).
+		//! @param addr The address of the first byte to overwrite.
+		//! @param data The bytes to copy.
+		void copyFrom(uint24_t addr, std::span<const uint8_t> data);
+
+		//! @brief Get the pages of this ram (shared with its clones until one of them writes to it).
+		[[nodiscard]] const PagedBuffer &getPages() const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "HashRenderer.hpp"
+
+namespace ComSquare::Renderer
+{
+	HashRenderer::HashRenderer()
+		: _video(emptyHash)
+	{}
+
+	uint64_t HashRenderer::hash(uint64_t seed, const void *data, size_t size)
+	{
+		const auto *bytes = static_cast<const uint8_t *>(data);
+		for (size_t i = 0; i < size; i++) {
+			seed ^= bytes[i];
+			seed *= 0x100000001B3;
+		}
+		return seed;
+	}
+
+	void HashRenderer::setWindowName(std::string &)
+	{}
+
+	void HashRenderer::drawScreen()
+	{}
+
+	void HashRenderer::putPixel(unsigned x, unsigned y, uint32_t rgba)
+	{
+		// The coordinates are hashed too, a pixel drawn at another place is a different picture.
+		const uint32_t pixel[3] = {x, y, rgba};
+		this->_video = hash(this->_video, pixel, sizeof(pixel));
+	}
+
+	void HashRenderer::playAudio(std::span<int16_t>)
+	{}
+
+	void HashRenderer::createWindow(SNES &, int)
+	{}
+
+	uint64_t HashRenderer::takeVideoHash()
+	{
+		uint64_t video = this->_video;
+		this->_video = emptyHash;
+		return video;
+	}
+}
@@ -0,0 +1,53 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include "IRenderer.hpp"
+
+namespace ComSquare::Renderer
+{
+	//! @brief A renderer that hashes the pixels it is given instead of showing them (used to check that the output of the emulator did not change).
+	//! @info The samples are not hashed here: they are given to the renderer while they are mixed, hash them from the sound buffer of the DSP instead.
+	class HashRenderer : public IRenderer
+	{
+	private:
+		//! @brief The hash of the pixels given since the last takeVideoHash.
+		uint64_t _video;
+	public:
+		//! @brief The initial value of a hash (the FNV-1a offset basis).
+		static constexpr uint64_t emptyHash = 0xCBF29CE484222325;
+
+		//! @brief Add bytes to a FNV-1a hash.
+		//! @param seed The current hash (emptyHash to start a new one).
+		//! @param data The bytes to add.
+		//! @param size The number of bytes.
+		//! @return The new hash.
+		static uint64_t hash(uint64_t seed, const void *data, size_t size);
+
+		//! @brief This renderer has no window.
+		void setWindowName(std::string &newWindowName) override;
+		//! @brief Nothing is shown, the pixels are only hashed.
+		void drawScreen() override;
+		//! @brief Add a pixel and its coordinates to the video hash.
+		//! @param x The x position of the pixel.
+		//! @param y The y position of the pixel.
+		//! @param rgba The color of the pixel.
+		void putPixel(unsigned x, unsigned y, uint32_t rgba) override;
+		//! @brief The samples are discarded.
+		//! @param samples Buffer containing samples
+		void playAudio(std::span<int16_t> samples) override;
+		//! @brief This renderer has no window.
+		void createWindow(SNES &snes, int maxFPS) override;
+
+		//! @brief Get the hash of the pixels given since the last call and start a new hash.
+		uint64_t takeVideoHash();
+
+		HashRenderer();
+		HashRenderer(const HashRenderer &) = default;
+		HashRenderer &operator=(const HashRenderer &) = default;
+		~HashRenderer() = default;
+	};
+}
@@ -0,0 +1,121 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "RunAhead.hpp"
+#include <utility>
+
+namespace ComSquare::RunAhead
+{
+	RunAhead::RunAhead(SNES &snes, unsigned frames)
+		: _snes(snes),
+		  _frames(frames)
+	{}
+
+	RunAhead::RunAhead(SNES &snes, unsigned frames, std::unique_ptr<SNES> ahead)
+		: _snes(snes),
+		  _frames(frames),
+		  _ahead(std::move(ahead))
+	{
+		this->_ahead->apu.setMuted(true);
+		this->_worker = std::thread(&RunAhead::_run, this);
+	}
+
+	RunAhead::~RunAhead()
+	{
+		if (!this->_worker.joinable())
+			return;
+		{
+			std::lock_guard lock(this->_mutex);
+			this->_isStopping = true;
+		}
+		this->_condition.notify_all();
+		this->_worker.join();
+	}
+
+	void RunAhead::setInput(unsigned port, uint16_t buttons)
+	{
+		this->_snes.cpu.setJoypad(port, buttons);
+		this->_inputs[port] = buttons;
+	}
+
+	void RunAhead::runFrame()
+	{
+		if (this->_frames == 0)
+			this->_snes.runFrame();
+		else if (this->_ahead)
+			this->_runSecondInstance();
+		else
+			this->_runSingleInstance();
+	}
+
+	void RunAhead::_runSingleInstance()
+	{
+		this->_snes.runFrame(false);
+		this->_snes.saveState(this->_state);
+		this->_snes.apu.setMuted(true);
+		for (unsigned i = 1; i <= this->_frames; i++)
+			this->_snes.runFrame(i == this->_frames);
+		this->_snes.apu.setMuted(false);
+		this->_snes.loadState(this->_state);
+	}
+
+	void RunAhead::_runSecondInstance()
+	{
+		if (!this->_hasState) {
+			// There is no previous state to start from yet.
+			this->_snes.runFrame();
+			this->_snes.saveState(this->_state);
+			this->_hasState = true;
+			return;
+		}
+
+		{
+			std::lock_guard lock(this->_mutex);
+			this->_hasJob = true;
+		}
+		this->_condition.notify_all();
+		this->_snes.runFrame(false);
+		{
+			std::unique_lock lock(this->_mutex);
+			this->_condition.wait(lock, [this] { return !this->_hasJob; });
+		}
+		if (this->_error)
+			std::rethrow_exception(std::exchange(this->_error, nullptr));
+		this->_snes.saveState(this->_state);
+	}
+
+	void RunAhead::_runAhead()
+	{
+		// The second instance starts one frame behind, its first frame is the one the main console is running.
+		this->_ahead->loadState(this->_state);
+		for (unsigned port = 0; port < this->_inputs.size(); port++)
+			this->_ahead->cpu.setJoypad(port, this->_inputs[port]);
+		for (unsigned i = 0; i <= this->_frames; i++)
+			this->_ahead->runFrame(i == this->_frames);
+	}
+
+	void RunAhead::_run()
+	{
+		std::unique_lock lock(this->_mutex);
+		while (true) {
+			this->_condition.wait(lock, [this] { return this->_hasJob || this->_isStopping; });
+			if (this->_isStopping)
+				return;
+			lock.unlock();
+			try {
+				this->_runAhead();
+			} catch (...) {
+				this->_error = std::current_exception();
+			}
+			lock.lock();
+			this->_hasJob = false;
+			this->_condition.notify_all();
+		}
+	}
+
+	unsigned RunAhead::getFrames() const
+	{
+		return this->_frames;
+	}
+}
@@ -0,0 +1,88 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "SNES.hpp"
+#include "SaveState/SaveState.hpp"
+
+namespace ComSquare::RunAhead
+{
+	//! @brief Hide the lag frames of a game by showing the picture of a few frames in the future.
+	//! @info Each frame, the console runs ahead with the current input without playing the sound, the picture of the
+	//! last frame is shown and the state before the speculative frames is restored.
+	//! With a second instance, the speculative frames are run on another thread, from the state of the previous frame, while the main frame runs.
+	class RunAhead
+	{
+	private:
+		//! @brief The console whose state is kept (it is the only one playing the sound).
+		SNES &_snes;
+		//! @brief The number of frames to run ahead.
+		unsigned _frames;
+		//! @brief The state restored after the speculative frames.
+		SaveState::SaveState _state;
+		//! @brief The buttons of each controller port.
+		std::array<uint16_t, 4> _inputs = {};
+
+		//! @brief The console running the speculative frames on the worker thread (null to run them on the main console).
+		std::unique_ptr<SNES> _ahead;
+		//! @brief True if _state contains the state of the main console after the previous frame.
+		bool _hasState = false;
+		//! @brief True if the worker has a job to run.
+		bool _hasJob = false;
+		//! @brief Set to stop the worker thread.
+		bool _isStopping = false;
+		//! @brief An exception thrown by the second instance, rethrown on the main thread.
+		std::exception_ptr _error;
+		//! @brief Protects the job flags.
+		std::mutex _mutex;
+		//! @brief Notified when a job is given to the worker or when it is done.
+		std::condition_variable _condition;
+		//! @brief The thread running the second instance.
+		std::thread _worker;
+
+		//! @brief Run the speculative frames on the main console and restore it.
+		void _runSingleInstance();
+		//! @brief Run the main frame while the second instance runs the speculative frames.
+		void _runSecondInstance();
+		//! @brief Load the previous state in the second instance and run the speculative frames.
+		void _runAhead();
+		//! @brief The loop of the worker thread.
+		void _run();
+	public:
+		//! @brief Run ahead on the same console.
+		//! @param snes The console to run.
+		//! @param frames The number of frames to run ahead (0 disables the run ahead).
+		RunAhead(SNES &snes, unsigned frames);
+		//! @brief Run ahead on a second instance, on another thread.
+		//! @param snes The console to run.
+		//! @param frames The number of frames to run ahead (0 disables the run ahead).
+		//! @param ahead A console with the same rom as snes. Its renderer is the one showing the picture and it is muted.
+		//! @info The renderer of the second instance draws on the worker thread while the main console plays the sound.
+		RunAhead(SNES &snes, unsigned frames, std::unique_ptr<SNES> ahead);
+		//! @brief A run ahead is not copyable (it owns a thread).
+		RunAhead(const RunAhead &) = delete;
+		//! @brief A run ahead is not assignable.
+		RunAhead &operator=(const RunAhead &) = delete;
+		//! @brief Stop the worker thread.
+		~RunAhead();
+
+		//! @brief Set the buttons of a controller port. They are used for the next frames.
+		//! @param port The controller port (0 to 3).
+		//! @param buttons The state of the buttons, see CPU::setJoypad.
+		void setInput(unsigned port, uint16_t buttons);
+		//! @brief Run a frame and show the picture of the frame run ahead.
+		//! @throw Any exception thrown by the second instance.
+		void runFrame();
+		//! @brief Get the number of frames run ahead.
+		[[nodiscard]] unsigned getFrames() const;
+	};
+}
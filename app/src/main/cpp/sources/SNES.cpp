@@ -8,23 +8,25 @@
 namespace ComSquare
 {
 	SNES::SNES(Renderer::IRenderer &renderer)
-	    : bus(),
+	    : scheduler(),
+	      bus(),
 	      cartridge(),
 	      wram(16384, WRam, "WRam"),
 	      sram(0, SRam, "SRam"),
-	      cpu(this->bus, cartridge.header),
-	      ppu(renderer),
-	      apu(renderer)
+	      cpu(this->bus, cartridge.header, this->scheduler),
+	      ppu(renderer, this->scheduler),
+	      apu(renderer, this->scheduler)
 	{}
 
 	SNES::SNES(const std::string &romPath, Renderer::IRenderer &renderer)
-	    : bus(),
+	    : scheduler(),
+	      bus(),
 	      cartridge(romPath),
 	      wram(16384, WRam, "WRam"),
 	      sram(this->cartridge.header.sramSize, SRam, "SRam"),
-	      cpu(this->bus, cartridge.header),
-	      ppu(renderer),
-	      apu(renderer)
+	      cpu(this->bus, cartridge.header, this->scheduler),
+	      ppu(renderer, this->scheduler),
+	      apu(renderer, this->scheduler)
 	{
 		this->bus.mapComponents(*this);
 		if (this->cartridge.getType() == Cartridge::Audio)
@@ -40,7 +42,97 @@ namespace ComSquare
 
 		unsigned cycleCount = this->cpu.update(0x0C);
 		this->ppu.update(cycleCount);
-		this->apu.update(cycleCount);
+		this->apu.sync();
+	}
+
+	void SNES::runFrame(bool render)
+	{
+		if (this->cartridge.getType() == Cartridge::Audio) {
+			// Nothing but the APU runs with a sound file, the clock skips the whole frame and the APU catches up.
+			this->scheduler.advance(Scheduler::Scheduler::masterCyclesPerFrame);
+			this->apu.sync();
+			return;
+		}
+
+		uint64_t frame = this->scheduler.getFrame();
+		unsigned cycleCount = 0;
+		// A disabled CPU (paused by the debugger) does not advance the clock.
+		while (!this->cpu.isDisabled && this->scheduler.getFrame() == frame)
+			cycleCount += this->cpu.update(0x0C);
+		// The APU only catches up when the CPU accesses its ports or at the end of the frame.
+		this->apu.sync();
+		if (render)
+			this->ppu.update(cycleCount);
+	}
+
+	uint32_t SNES::_getRomChecksum() const
+	{
+		return this->cartridge.header.checksum | this->cartridge.header.checksumComplement << 16u;
+	}
+
+	void SNES::saveState(SaveState::SaveState &state) const
+	{
+		SaveState::Header header {
+			SaveState::SaveState::magic,
+			SaveState::SaveState::version,
+			0,
+			this->_getRomChecksum(),
+			this->cartridge.header.romSize
+		};
+
+		state.beginWrite();
+		state.write(header);
+		state.write(this->scheduler);
+		this->cpu.saveState(state);
+		this->ppu.saveState(state);
+		this->apu.saveState(state);
+		this->wram.saveState(state);
+		this->sram.saveState(state);
+		header.size = state.getSize();
+		state.writeAt(0, header);
+	}
+
+	void SNES::loadState(SaveState::SaveState &state)
+	{
+		SaveState::Header header {};
+
+		state.beginRead();
+		state.read(header);
+		if (header.magic != SaveState::SaveState::magic)
+			throw InvalidSaveState("This is not a state image.");
+		if (header.version != SaveState::SaveState::version)
+			throw InvalidSaveState("The state has been made with another version.");
+		if (header.size != state.getSize())
+			throw InvalidSaveState("The state image is truncated.");
+		if (header.romChecksum != this->_getRomChecksum() || header.romSize != this->cartridge.header.romSize)
+			throw InvalidSaveState("The state has been made with another rom.");
+		state.read(this->scheduler);
+		this->cpu.loadState(state);
+		this->ppu.loadState(state);
+		this->apu.loadState(state);
+		this->wram.loadState(state);
+		this->sram.loadState(state);
+	}
+
+	std::unique_ptr<SNES> SNES::clone(Renderer::IRenderer &renderer) const
+	{
+		auto copy = std::make_unique<SNES>(renderer);
+		this->cloneTo(*copy);
+		return copy;
+	}
+
+	void SNES::cloneTo(SNES &target) const
+	{
+		SaveState::SaveState &state = this->_cloneState;
+
+		target.cartridge.shareRom(this->cartridge);
+		target.sram.setSize(this->sram.getSize());
+		target.bus.mapComponents(target);
+		state.setSharingMemories(true);
+		this->saveState(state);
+		target.loadState(state);
+		// Once the target is gone, the pages still held by the state would be copied on the next write.
+		state.releaseSharedMemories();
 	}
 
 	void SNES::loadRom(const std::string &path)
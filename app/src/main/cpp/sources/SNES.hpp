@@ -12,6 +12,9 @@
 #include "PPU/PPU.hpp"
 #include "Ram/Ram.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "SaveState/SaveState.hpp"
+#include "Scheduler/Scheduler.hpp"
+#include <memory>
 #include <optional>
 
 #ifdef DEBUGGER_ENABLED
@@ -51,7 +54,13 @@ namespace ComSquare
 		//! @brief The window that allow the user to view the CGRAM as tiles.
 		std::optional<Debugger::TileViewer> _tileViewer;
 #endif
+		//! @brief The state used by cloneTo, kept between the clones so its buffer is not allocated each time.
+		mutable SaveState::SaveState _cloneState;
+		//! @brief Get the checksum of the rom and its complement, used to check that a state belongs to this rom.
+		[[nodiscard]] uint32_t _getRomChecksum() const;
 	public:
+		//! @brief The master clock shared by all the components.
+		Scheduler::Scheduler scheduler;
 		//! @brief The memory bus that map addresses to components.
 		Memory::MemoryBus bus;
 
@@ -84,6 +93,25 @@ namespace ComSquare
 
 		//! @brief Call this function to update all the components
 		void update();
+		//! @brief Run the components until the start of the next frame.
+		//! @param render False to skip the rendering of the picture (the state of the console is the same either way).
+		void runFrame(bool render = true);
+
+		//! @brief Save the state of the whole console.
+		//! @param state The state to write to. Its buffer is reused so saving repeatedly in the same state does not allocate.
+		void saveState(SaveState::SaveState &state) const;
+		//! @brief Restore a state made by saveState.
+		//! @throw InvalidSaveState if the state has been made by another version or with another rom.
+		void loadState(SaveState::SaveState &state);
+
+		//! @brief Create a copy of this console sharing its rom. The memories are shared until one of the consoles writes to them.
+		//! @param renderer The renderer of the copy.
+		//! @return A console in the same state as this one.
+		[[nodiscard]] std::unique_ptr<SNES> clone(Renderer::IRenderer &renderer) const;
+		//! @brief Put another console in the same state as this one, sharing the rom and the memories like clone.
+		//! @info Creating a console is costly (the PPU buffers are large), reuse consoles with this to branch often.
+		//! @param target The console to overwrite.
+		void cloneTo(SNES &target) const;
 
 		//! @brief Load the rom at the given path
 		//! @param rom The path of the rom.
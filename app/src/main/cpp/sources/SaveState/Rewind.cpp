@@ -0,0 +1,237 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "Rewind.hpp"
+#include <algorithm>
+
+namespace ComSquare::SaveState
+{
+	Rewind::Rewind(size_t capacity, unsigned keyframeInterval)
+		: _capacity(capacity),
+		  _keyframeInterval(std::max(keyframeInterval, 1u)),
+		  _worker(&Rewind::_run, this)
+	{}
+
+	Rewind::~Rewind()
+	{
+		{
+			std::lock_guard lock(this->_mutex);
+			this->_isStopping = true;
+		}
+		this->_condition.notify_all();
+		this->_worker.join();
+	}
+
+	void Rewind::push(const SaveState &state)
+	{
+		auto start = std::chrono::steady_clock::now();
+		std::unique_lock lock(this->_mutex);
+		this->_condition.wait(lock, [this] { return !this->_hasPending; });
+		std::span<const uint8_t> image = state.getData();
+		this->_pending.assign(image.begin(), image.end());
+		this->_hasPending = true;
+		this->_pushTime += std::chrono::steady_clock::now() - start;
+		this->_pushCount++;
+		lock.unlock();
+		this->_condition.notify_all();
+	}
+
+	bool Rewind::pop(SaveState &state)
+	{
+		std::unique_lock lock(this->_mutex);
+		this->_waitIdle(lock);
+		if (this->_frames.empty())
+			return false;
+
+		state.beginWrite();
+		state.write(this->_lastImage.data(), this->_lastImage.size());
+
+		// Rebuild the image of the frame before the one removed.
+		Frame &newest = this->_frames.back();
+		if (!newest.isKeyframe) {
+			_decodeXor(newest.data, this->_lastImage);
+			this->_deltasSinceKeyframe--;
+		} else {
+			auto keyframe = std::find_if(std::next(this->_frames.rbegin()), this->_frames.rend(), [](const Frame &frame) {
+				return frame.isKeyframe;
+			});
+			if (keyframe == this->_frames.rend()) {
+				this->_lastImage.clear();
+			} else {
+				std::fill(this->_lastImage.begin(), this->_lastImage.end(), 0);
+				this->_deltasSinceKeyframe = std::distance(std::next(this->_frames.rbegin()), keyframe);
+				for (auto it = keyframe.base() - 1; it != this->_frames.end() - 1; it++)
+					_decodeXor(it->data, this->_lastImage);
+			}
+		}
+		this->_usedBytes -= newest.data.size();
+		this->_frames.pop_back();
+		return true;
+	}
+
+	void Rewind::clear()
+	{
+		std::unique_lock lock(this->_mutex);
+		this->_waitIdle(lock);
+		this->_frames.clear();
+		this->_usedBytes = 0;
+		this->_deltasSinceKeyframe = 0;
+		this->_lastImage.clear();
+	}
+
+	size_t Rewind::size() const
+	{
+		std::unique_lock lock(this->_mutex);
+		this->_waitIdle(lock);
+		return this->_frames.size();
+	}
+
+	RewindStatistics Rewind::getStatistics() const
+	{
+		std::unique_lock lock(this->_mutex);
+		this->_waitIdle(lock);
+		RewindStatistics statistics;
+		statistics.frames = this->_frames.size();
+		statistics.keyframes = std::count_if(this->_frames.begin(), this->_frames.end(), [](const Frame &frame) {
+			return frame.isKeyframe;
+		});
+		statistics.usedBytes = this->_usedBytes;
+		statistics.capacity = this->_capacity;
+		if (this->_pushCount)
+			statistics.averagePushTime = this->_pushTime / this->_pushCount;
+		if (this->_compressionCount)
+			statistics.averageCompressionTime = this->_compressionTime / this->_compressionCount;
+		return statistics;
+	}
+
+	void Rewind::_waitIdle(std::unique_lock<std::mutex> &lock) const
+	{
+		this->_condition.wait(lock, [this] { return !this->_hasPending && !this->_isBusy; });
+	}
+
+	void Rewind::_run()
+	{
+		std::unique_lock lock(this->_mutex);
+		while (true) {
+			this->_condition.wait(lock, [this] { return this->_hasPending || this->_isStopping; });
+			if (this->_isStopping)
+				return;
+			std::swap(this->_current, this->_pending);
+			this->_hasPending = false;
+			this->_isBusy = true;
+			lock.unlock();
+			// push can fill the pending image again while this one is compressed.
+			this->_condition.notify_all();
+
+			auto start = std::chrono::steady_clock::now();
+			this->_compressCurrent();
+			auto elapsed = std::chrono::steady_clock::now() - start;
+
+			lock.lock();
+			this->_compressionTime += elapsed;
+			this->_compressionCount++;
+			this->_evict();
+			this->_isBusy = false;
+			this->_condition.notify_all();
+		}
+	}
+
+	void Rewind::_compressCurrent()
+	{
+		// The other methods wait for the end of the compression before using the frames or the last image.
+		if (this->_lastImage.size() != this->_current.size()) {
+			// The older frames have been made with another rom.
+			this->_frames.clear();
+			this->_usedBytes = 0;
+		}
+		Frame frame;
+		frame.isKeyframe = this->_frames.empty() || this->_deltasSinceKeyframe + 1 >= this->_keyframeInterval;
+		if (frame.isKeyframe) {
+			_encode(this->_current, frame.data);
+			this->_deltasSinceKeyframe = 0;
+		} else {
+			this->_delta.resize(this->_current.size());
+			for (size_t i = 0; i < this->_current.size(); i++)
+				this->_delta[i] = this->_current[i] ^ this->_lastImage[i];
+			_encode(this->_delta, frame.data);
+			this->_deltasSinceKeyframe++;
+		}
+		frame.data.shrink_to_fit();
+		this->_usedBytes += frame.data.size();
+		this->_frames.push_back(std::move(frame));
+		std::swap(this->_lastImage, this->_current);
+	}
+
+	void Rewind::_evict()
+	{
+		while (this->_usedBytes > this->_capacity && this->_frames.size() > 1) {
+			do {
+				this->_usedBytes -= this->_frames.front().data.size();
+				this->_frames.pop_front();
+			} while (!this->_frames.empty() && !this->_frames.front().isKeyframe);
+		}
+	}
+
+	//! @brief Append a number using 7 bits per byte (the high bit is set if more bytes follow).
+	static void writeVarint(std::vector<uint8_t> &output, size_t value)
+	{
+		while (value >= 0x80) {
+			output.push_back(value | 0x80u);
+			value >>= 7u;
+		}
+		output.push_back(value);
+	}
+
+	//! @brief Read a number written by writeVarint.
+	static size_t readVarint(std::span<const uint8_t> data, size_t &offset)
+	{
+		size_t value = 0;
+		for (unsigned shift = 0; offset < data.size(); shift += 7) {
+			uint8_t byte = data[offset++];
+			value |= static_cast<size_t>(byte & 0x7Fu) << shift;
+			if (!(byte & 0x80u))
+				break;
+		}
+		return value;
+	}
+
+	void Rewind::_encode(std::span<const uint8_t> data, std::vector<uint8_t> &output)
+	{
+		output.clear();
+		size_t i = 0;
+		while (i < data.size()) {
+			size_t zeroStart = i;
+			uint64_t word;
+			while (i + sizeof(word) <= data.size()) {
+				std::memcpy(&word, data.data() + i, sizeof(word));
+				if (word)
+					break;
+				i += sizeof(word);
+			}
+			while (i < data.size() && !data[i])
+				i++;
+			size_t literalStart = i;
+			// A single zero is cheaper to keep in the literals than to start a new run.
+			while (i < data.size() && (data[i] || (i + 1 < data.size() && data[i + 1])))
+				i++;
+			writeVarint(output, literalStart - zeroStart);
+			writeVarint(output, i - literalStart);
+			output.insert(output.end(), data.begin() + literalStart, data.begin() + i);
+		}
+	}
+
+	void Rewind::_decodeXor(std::span<const uint8_t> data, std::span<uint8_t> image)
+	{
+		size_t offset = 0;
+		size_t position = 0;
+		while (offset < data.size()) {
+			position += readVarint(data, offset);
+			size_t count = readVarint(data, offset);
+			for (size_t i = 0; i < count; i++)
+				image[position + i] ^= data[offset + i];
+			position += count;
+			offset += count;
+		}
+	}
+}
@@ -0,0 +1,133 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "SaveState/SaveState.hpp"
+
+namespace ComSquare::SaveState
+{
+	//! @brief Memory and time used by a rewind buffer.
+	struct RewindStatistics
+	{
+		//! @brief The number of frames that can be rewound.
+		size_t frames = 0;
+		//! @brief The number of frames stored as keyframes (the others are deltas).
+		size_t keyframes = 0;
+		//! @brief The number of bytes used by the compressed frames.
+		size_t usedBytes = 0;
+		//! @brief The maximum number of bytes the compressed frames can use.
+		size_t capacity = 0;
+		//! @brief The average time taken by push on the emulation thread.
+		std::chrono::nanoseconds averagePushTime {0};
+		//! @brief The average time taken to compress a frame on the background thread.
+		std::chrono::nanoseconds averageCompressionTime {0};
+	};
+
+	//! @brief A history of states that can be rewound frame by frame.
+	//! @info Every keyframeInterval frames, a full image is kept. The other frames are stored as the XOR with the
+	//! previous frame, which is mostly zeros. Both are run length encoded by a background thread.
+	//! When the capacity is reached, the oldest keyframe and its deltas are dropped.
+	class Rewind
+	{
+	private:
+		//! @brief A compressed frame.
+		struct Frame
+		{
+			//! @brief True if data is the whole image, false if it is the XOR with the previous frame.
+			bool isKeyframe;
+			//! @brief The run length encoded image or delta.
+			std::vector<uint8_t> data;
+		};
+
+		//! @brief The maximum number of bytes used by the frames.
+		size_t _capacity;
+		//! @brief The maximum number of deltas between two keyframes.
+		unsigned _keyframeInterval;
+
+		//! @brief The frames, from the oldest to the newest.
+		std::deque<Frame> _frames;
+		//! @brief The sum of the size of the frames.
+		size_t _usedBytes = 0;
+		//! @brief The number of deltas pushed since the last keyframe.
+		unsigned _deltasSinceKeyframe = 0;
+		//! @brief The uncompressed image of the newest frame.
+		std::vector<uint8_t> _lastImage;
+
+		//! @brief The image given to push, waiting to be compressed.
+		std::vector<uint8_t> _pending;
+		//! @brief True if _pending contains an image to compress.
+		bool _hasPending = false;
+		//! @brief True while the background thread compresses a frame.
+		bool _isBusy = false;
+		//! @brief Set to stop the background thread.
+		bool _isStopping = false;
+		//! @brief The image being compressed by the background thread.
+		std::vector<uint8_t> _current;
+		//! @brief A buffer used to compute deltas.
+		std::vector<uint8_t> _delta;
+
+		//! @brief The total time spent in push and the number of calls.
+		std::chrono::nanoseconds _pushTime {0};
+		uint64_t _pushCount = 0;
+		//! @brief The total time spent compressing frames and the number of frames compressed.
+		std::chrono::nanoseconds _compressionTime {0};
+		uint64_t _compressionCount = 0;
+
+		//! @brief Protects every member used by both threads.
+		mutable std::mutex _mutex;
+		//! @brief Notified when a frame is pushed, compressed or when the thread should stop.
+		mutable std::condition_variable _condition;
+		//! @brief The background thread compressing the frames.
+		std::thread _worker;
+
+		//! @brief The loop of the background thread.
+		void _run();
+		//! @brief Compress the current image and add it to the frames.
+		void _compressCurrent();
+		//! @brief Drop the oldest keyframes (and their deltas) until the capacity is respected.
+		void _evict();
+		//! @brief Wait for the background thread to finish the pending frame.
+		void _waitIdle(std::unique_lock<std::mutex> &lock) const;
+
+		//! @brief Run length encode data: each run is a varint count of zeros, a varint count of literals and the literals.
+		static void _encode(std::span<const uint8_t> data, std::vector<uint8_t> &output);
+		//! @brief Decode data encoded with _encode and XOR it into the image.
+		static void _decodeXor(std::span<const uint8_t> data, std::span<uint8_t> image);
+	public:
+		//! @brief Create a rewind buffer.
+		//! @param capacity The maximum number of bytes used by the compressed frames.
+		//! @param keyframeInterval The number of frames between two keyframes.
+		explicit Rewind(size_t capacity, unsigned keyframeInterval = 60);
+		//! @brief A rewind buffer is not copyable (it owns a thread).
+		Rewind(const Rewind &) = delete;
+		//! @brief A rewind buffer is not assignable.
+		Rewind &operator=(const Rewind &) = delete;
+		//! @brief Stop the background thread.
+		~Rewind();
+
+		//! @brief Add the state of a frame to the history.
+		//! @info The image is copied and compressed later on the background thread. This only waits if the previous frame is still being compressed.
+		void push(const SaveState &state);
+		//! @brief Remove the newest frame of the history.
+		//! @param state The state to write the frame to.
+		//! @return False if the history is empty.
+		bool pop(SaveState &state);
+		//! @brief Remove every frame.
+		void clear();
+
+		//! @brief Get the number of frames that can be rewound.
+		[[nodiscard]] size_t size() const;
+		//! @brief Get the memory and time used by this rewind buffer.
+		[[nodiscard]] RewindStatistics getStatistics() const;
+	};
+}
@@ -0,0 +1,89 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "SaveState.hpp"
+
+namespace ComSquare::SaveState
+{
+	SaveState::SaveState(std::span<const uint8_t> image)
+		: _data(image.begin(), image.end()),
+		  _size(image.size())
+	{}
+
+	void SaveState::beginWrite()
+	{
+		this->_size = 0;
+		this->_offset = 0;
+		this->_sharedMemories.clear();
+	}
+
+	void SaveState::beginRead()
+	{
+		this->_offset = 0;
+		this->_sharedMemoryIndex = 0;
+	}
+
+	void SaveState::write(const void *data, size_t size)
+	{
+		if (this->_offset + size > this->_data.size())
+			this->_data.resize(this->_offset + size);
+		std::memcpy(this->_data.data() + this->_offset, data, size);
+		this->_offset += size;
+		this->_size = this->_offset;
+	}
+
+	void SaveState::read(void *data, size_t size)
+	{
+		if (this->_offset + size > this->_size)
+			throw InvalidSaveState("The state image is truncated.");
+		std::memcpy(data, this->_data.data() + this->_offset, size);
+		this->_offset += size;
+	}
+
+	void SaveState::setSharingMemories(bool isSharing)
+	{
+		this->_isSharingMemories = isSharing;
+	}
+
+	bool SaveState::isSharingMemories() const
+	{
+		return this->_isSharingMemories;
+	}
+
+	void SaveState::shareMemory(const Ram::PagedBuffer &memory)
+	{
+		this->_sharedMemories.push_back(memory);
+	}
+
+	const Ram::PagedBuffer &SaveState::readSharedMemory(size_t size)
+	{
+		if (this->_sharedMemoryIndex >= this->_sharedMemories.size())
+			throw InvalidSaveState("The state does not contain the shared memories.");
+		const Ram::PagedBuffer &memory = this->_sharedMemories[this->_sharedMemoryIndex++];
+		if (memory.size() != size)
+			throw InvalidSaveState("The shared memory does not have the expected size.");
+		return memory;
+	}
+
+	std::span<const Ram::PagedBuffer> SaveState::getSharedMemories() const
+	{
+		return this->_sharedMemories;
+	}
+
+	void SaveState::releaseSharedMemories()
+	{
+		this->_sharedMemories.clear();
+		this->_sharedMemoryIndex = 0;
+	}
+
+	size_t SaveState::getSize() const
+	{
+		return this->_size;
+	}
+
+	std::span<const uint8_t> SaveState::getData() const
+	{
+		return std::span(this->_data.data(), this->_size);
+	}
+}
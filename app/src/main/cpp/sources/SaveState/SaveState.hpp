@@ -0,0 +1,121 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "Exceptions/InvalidSaveState.hpp"
+#include "Ram/PagedBuffer.hpp"
+
+namespace ComSquare::SaveState
+{
+	//! @brief The block at the start of every state image.
+	struct Header
+	{
+		//! @brief Always "CSQS".
+		std::array<char, 4> magic;
+		//! @brief The version of the layout of the image.
+		uint32_t version;
+		//! @brief The size of the whole image (header included).
+		uint64_t size;
+		//! @brief The checksum (and its complement in the high bytes) of the rom this state has been made with.
+		uint32_t romChecksum;
+		//! @brief The size of the rom this state has been made with.
+		uint32_t romSize;
+	};
+
+	//! @brief A snapshot of the whole console. The state of each component is copied as contiguous plain data blocks.
+	//! @info The buffer is kept between saves so saving again in the same object does not allocate.
+	class SaveState
+	{
+	private:
+		//! @brief The image. Only the first _size bytes are meaningful.
+		std::vector<uint8_t> _data;
+		//! @brief The size of the image.
+		size_t _size = 0;
+		//! @brief The position of the next read or write.
+		size_t _offset = 0;
+
+		//! @brief True if the memories are shared with this state instead of being copied in the image.
+		bool _isSharingMemories = false;
+		//! @brief The memories shared with this state, in the order they have been saved.
+		std::vector<Ram::PagedBuffer> _sharedMemories;
+		//! @brief The index of the next shared memory to read.
+		size_t _sharedMemoryIndex = 0;
+	public:
+		//! @brief The magic number at the start of every image.
+		static constexpr std::array<char, 4> magic = {'C', 'S', 'Q', 'S'};
+		//! @brief The version of the layout. It must be incremented each time the state of a component changes.
+		static constexpr uint32_t version = 7;
+
+		SaveState() = default;
+		//! @brief Create a state from an image (read from a file for example).
+		explicit SaveState(std::span<const uint8_t> image);
+		SaveState(const SaveState &) = default;
+		SaveState &operator=(const SaveState &) = default;
+		~SaveState() = default;
+
+		//! @brief Start writing a new image from the beginning.
+		void beginWrite();
+		//! @brief Start reading the image from the beginning.
+		void beginRead();
+
+		//! @brief Append raw data to the image.
+		void write(const void *data, size_t size);
+		//! @brief Read raw data from the image.
+		//! @throw InvalidSaveState if the image is too small.
+		void read(void *data, size_t size);
+
+		//! @brief Append a plain data block to the image.
+		template<typename T>
+		inline void write(const T &value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data can be saved as is.");
+			this->write(&value, sizeof(T));
+		}
+		//! @brief Read a plain data block from the image.
+		//! @throw InvalidSaveState if the image is too small.
+		template<typename T>
+		inline void read(T &value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data can be loaded as is.");
+			this->read(&value, sizeof(T));
+		}
+
+		//! @brief Overwrite a block that has already been written (used to write the header once the size is known).
+		template<typename T>
+		inline void writeAt(size_t offset, const T &value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data can be saved as is.");
+			std::memcpy(this->_data.data() + offset, &value, sizeof(T));
+		}
+
+		//! @brief Share the pages of the memories with this state instead of copying them in the image.
+		//! @info This is used to clone a console: the memories are only copied when they are written to.
+		//! The image of a state sharing memories can't be loaded from another process (or saved to a file).
+		void setSharingMemories(bool isSharing);
+		//! @brief Are the memories shared with this state instead of being copied in the image.
+		[[nodiscard]] bool isSharingMemories() const;
+		//! @brief Share a memory with this state.
+		void shareMemory(const Ram::PagedBuffer &memory);
+		//! @brief Get the next memory shared with this state.
+		//! @param size The expected size of the memory.
+		//! @throw InvalidSaveState if there is no more memory or if it does not have the expected size.
+		const Ram::PagedBuffer &readSharedMemory(size_t size);
+		//! @brief Get the memories shared with this state, in the order they have been saved.
+		[[nodiscard]] std::span<const Ram::PagedBuffer> getSharedMemories() const;
+		//! @brief Stop sharing the pages of the memories with this state (they are not copied on write for it anymore).
+		void releaseSharedMemories();
+
+		//! @brief Get the current size of the image.
+		[[nodiscard]] size_t getSize() const;
+		//! @brief Get the image.
+		[[nodiscard]] std::span<const uint8_t> getData() const;
+	};
+}
@@ -0,0 +1,40 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "Scheduler.hpp"
+#include <algorithm>
+
+namespace ComSquare::Scheduler
+{
+	Scheduler::Scheduler()
+		: _nextEvent(never)
+	{
+		this->_events.fill(never);
+	}
+
+	void Scheduler::_updateNextEvent()
+	{
+		this->_nextEvent = *std::min_element(this->_events.begin(), this->_events.end());
+	}
+
+	void Scheduler::schedule(Event event, uint64_t timestamp)
+	{
+		this->_events[event] = timestamp;
+		this->_updateNextEvent();
+	}
+
+	void Scheduler::cancel(Event event)
+	{
+		this->_events[event] = never;
+		this->_updateNextEvent();
+	}
+
+	bool Scheduler::consume(Event event)
+	{
+		if (this->_timestamp < this->_events[event])
+			return false;
+		this->cancel(event);
+		return true;
+	}
+}
@@ -0,0 +1,153 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace ComSquare::Scheduler
+{
+	//! @brief The one-shot events that can be scheduled.
+	enum Event : uint8_t {
+		//! @brief The H/V timer IRQ set by HTIME, VTIME and NMITIMEN.
+		TimerIRQ,
+		//! @brief The start of the vertical blank (raise the NMI).
+		VBlank,
+
+		EventCount
+	};
+
+	//! @brief The master clock of the SNES. Every component derive its timings from the master cycle timestamp.
+	//! @info The position of the beam (H/V counters) is never stored, it is computed when someone needs it.
+	class Scheduler
+	{
+	private:
+		//! @brief The number of master cycles elapsed since the power on.
+		uint64_t _timestamp = 0;
+		//! @brief The timestamp of each event (never if the event is not scheduled).
+		std::array<uint64_t, EventCount> _events;
+		//! @brief The timestamp of the first scheduled event.
+		uint64_t _nextEvent;
+
+		//! @brief Recompute the timestamp of the first scheduled event.
+		void _updateNextEvent();
+	public:
+		//! @brief The timestamp used for events that are not scheduled.
+		static constexpr uint64_t never = std::numeric_limits<uint64_t>::max();
+		//! @brief The frequency of the master clock in Hz (NTSC).
+		static constexpr uint64_t masterClock = 21477272;
+		//! @brief The number of master cycles of a CPU cycle.
+		//! @info The different speeds of the memory regions are not emulated, every cycle is considered to be a fast one.
+		static constexpr unsigned masterCyclesPerCPUCycle = 6;
+		//! @brief The number of master cycles of a dot (one step of the H counter).
+		static constexpr unsigned masterCyclesPerDot = 4;
+		//! @brief The number of dots of a scanline.
+		static constexpr unsigned dotsPerLine = 341;
+		//! @brief The number of master cycles of a scanline.
+		static constexpr unsigned masterCyclesPerLine = 1364;
+		//! @brief The number of scanlines of a frame (NTSC, non interlaced).
+		static constexpr unsigned linesPerFrame = 262;
+		//! @brief The number of master cycles of a frame.
+		static constexpr uint64_t masterCyclesPerFrame = static_cast<uint64_t>(masterCyclesPerLine) * linesPerFrame;
+		//! @brief The first scanline of the vertical blank.
+		static constexpr unsigned vblankStartLine = 225;
+		//! @brief The first dot of the horizontal blank.
+		static constexpr unsigned hblankStartDot = 274;
+
+		Scheduler();
+		//! @brief A scheduler is copyable (used to save the state of the console).
+		Scheduler(const Scheduler &) = default;
+		//! @brief A scheduler is assignable.
+		Scheduler &operator=(const Scheduler &) = default;
+		//! @brief A default destructor.
+		~Scheduler() = default;
+
+		//! @brief Get the number of master cycles elapsed since the power on.
+		[[nodiscard]] inline uint64_t getTimestamp() const
+		{
+			return this->_timestamp;
+		}
+
+		//! @brief Advance the clock.
+		//! @param masterCycles The number of master cycles elapsed.
+		inline void advance(uint64_t masterCycles)
+		{
+			this->_timestamp += masterCycles;
+		}
+
+		//! @brief Get the H counter (dot of the current scanline) at the given timestamp.
+		[[nodiscard]] static inline uint16_t getHCounter(uint64_t timestamp)
+		{
+			return timestamp % masterCyclesPerLine / masterCyclesPerDot;
+		}
+		//! @brief Get the V counter (current scanline) at the given timestamp.
+		[[nodiscard]] static inline uint16_t getVCounter(uint64_t timestamp)
+		{
+			return timestamp % masterCyclesPerFrame / masterCyclesPerLine;
+		}
+		//! @brief Get the timestamp of the start of the frame containing the given timestamp.
+		[[nodiscard]] static inline uint64_t getFrameStart(uint64_t timestamp)
+		{
+			return timestamp - timestamp % masterCyclesPerFrame;
+		}
+		//! @brief Get the timestamp of the start of the scanline containing the given timestamp.
+		[[nodiscard]] static inline uint64_t getLineStart(uint64_t timestamp)
+		{
+			return timestamp - timestamp % masterCyclesPerLine;
+		}
+
+		//! @brief Get the current H counter.
+		[[nodiscard]] inline uint16_t getHCounter() const
+		{
+			return getHCounter(this->_timestamp);
+		}
+		//! @brief Get the current V counter.
+		[[nodiscard]] inline uint16_t getVCounter() const
+		{
+			return getVCounter(this->_timestamp);
+		}
+		//! @brief Get the number of frames elapsed since the power on.
+		[[nodiscard]] inline uint64_t getFrame() const
+		{
+			return this->_timestamp / masterCyclesPerFrame;
+		}
+		//! @brief Is the beam currently in the vertical blank.
+		[[nodiscard]] inline bool isInVBlank() const
+		{
+			return this->getVCounter() >= vblankStartLine;
+		}
+		//! @brief Is the beam currently in the horizontal blank.
+		[[nodiscard]] inline bool isInHBlank() const
+		{
+			return this->getHCounter() >= hblankStartDot;
+		}
+
+		//! @brief Schedule an event, replacing the previous occurrence if it was already scheduled.
+		//! @param event The event to schedule.
+		//! @param timestamp The master cycle timestamp at which the event should be triggered.
+		void schedule(Event event, uint64_t timestamp);
+		//! @brief Cancel an event. Nothing happens if the event was not scheduled.
+		void cancel(Event event);
+		//! @brief Get the timestamp of an event (never if it is not scheduled).
+		[[nodiscard]] inline uint64_t getEventTimestamp(Event event) const
+		{
+			return this->_events[event];
+		}
+		//! @brief Get the timestamp of the first scheduled event.
+		[[nodiscard]] inline uint64_t getNextEventTimestamp() const
+		{
+			return this->_nextEvent;
+		}
+		//! @brief Is any event due. This is the only check made by the components on the hot path.
+		[[nodiscard]] inline bool hasDueEvent() const
+		{
+			return this->_timestamp >= this->_nextEvent;
+		}
+		//! @brief Check if an event is due and unschedule it if it is (events are one-shot).
+		//! @return True if the event should be handled now.
+		bool consume(Event event);
+	};
+}
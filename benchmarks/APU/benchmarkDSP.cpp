@@ -0,0 +1,66 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "../benchmarks.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of samples computed per benchmark.
+	constexpr uint64_t sampleCount = 32'000;
+	//! @brief The number of samples rendered per call, about what the APU renders for a frame.
+	constexpr unsigned batchSize = 128;
+
+	//! @brief Run the DSP for sampleCount full samples.
+	static uint64_t runSamples(APU::DSP::DSP &dsp)
+	{
+		for (uint64_t i = 0; i < sampleCount; i += batchSize)
+			dsp.renderSamples(batchSize);
+		return sampleCount;
+	}
+
+	Result benchmarkDSPSilent()
+	{
+		Init()
+		return measure("DSP silent", "samples", [&snes] {
+			return runSamples(snes.apu._dsp);
+		});
+	}
+
+	Result benchmarkDSPVoices()
+	{
+		Init()
+		APU::DSP::DSP &dsp = snes.apu._dsp;
+		// The sample directory is at $0200, its first entry points to a BRR block at $0300 that loops on itself.
+		const uint8_t directory[] = {0x00, 0x03, 0x00, 0x03};
+		// Shift of 11, no filter, loop and end flags set, followed by 16 nibbles of a saw.
+		const uint8_t block[] = {0xB3, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+		for (unsigned i = 0; i < sizeof(directory); i++)
+			snes.apu._map.ram[0x0200 + i] = directory[i];
+		for (unsigned i = 0; i < sizeof(block); i++)
+			snes.apu._map.ram[0x0300 + i] = block[i];
+
+		for (uint8_t voice = 0; voice < 8; voice++) {
+			uint8_t base = voice << 4u;
+			dsp.write(base + 0x0, 0x7F);  // VOL (L)
+			dsp.write(base + 0x1, 0x7F);  // VOL (R)
+			dsp.write(base + 0x2, 0x00);  // P (L)
+			dsp.write(base + 0x3, 0x10);  // P (H), the original pitch
+			dsp.write(base + 0x4, 0x00);  // SRCN
+			dsp.write(base + 0x5, 0x8F);  // ADSR (1), fastest attack
+			dsp.write(base + 0x6, 0xE0);  // ADSR (2), sustain at the maximum
+		}
+		dsp.write(0x0C, 0x7F); // MVOL (L)
+		dsp.write(0x1C, 0x7F); // MVOL (R)
+		dsp.write(0x6C, 0x20); // FLG, echo writes disabled
+		dsp.write(0x5D, 0x02); // DIR
+		dsp.write(0x5C, 0x00); // KOF
+		dsp.write(0x4C, 0xFF); // KON
+		// The KON register is not latched by the voices yet, so they are started directly (else they would all be silent).
+		for (APU::DSP::Voice &voice : dsp._voices)
+			voice.envelopeMode = APU::DSP::Envelope::Attack;
+		return measure("DSP 8 voices", "samples", [&dsp] {
+			return runSamples(dsp);
+		});
+	}
+}
@@ -0,0 +1,40 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include "../benchmarks.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of SPC700 instructions to run per benchmark.
+	constexpr uint64_t spcInstructionCount = 10'000'000;
+
+	//! @brief A small loop of direct page, register and branch instructions.
+	static const uint8_t spcProgram[] = {
+		0xCD, 0x00, // 0200: MOV X, #$00
+		0x3D,       // 0202: INC X
+		0x84, 0x10, // 0203: ADC A, $10
+		0xC4, 0x11, // 0205: MOV $11, A
+		0xAB, 0x12, // 0207: INC $12
+		0x1A, 0x14, // 0209: DECW $14
+		0x7D,       // 020B: MOV A, X
+		0x28, 0x0F, // 020C: AND A, #$0F
+		0x5D,       // 020E: MOV X, A
+		0xD4, 0x20, // 020F: MOV $20+X, A
+		0xFE, 0xEF, // 0211: DBNZ Y, $0202
+		0x2F, 0xEB, // 0213: BRA $0200
+	};
+
+	Result benchmarkSPC700Dispatch()
+	{
+		Init()
+		std::copy(std::begin(spcProgram), std::end(spcProgram), snes.apu._map.ram.begin() + 0x0200);
+		snes.apu._internalRegisters.pc = 0x0200;
+		return measure("SPC700 dispatch", "instructions", [&snes] {
+			for (uint64_t i = 0; i < spcInstructionCount; i++)
+				snes.apu._executeInstruction();
+			return spcInstructionCount;
+		});
+	}
+}
@@ -0,0 +1,38 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <limits>
+#include "../benchmarks.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of transfers run per benchmark.
+	constexpr uint64_t transferCount = 500;
+	//! @brief The number of bytes of a transfer.
+	constexpr uint16_t transferSize = 0x2000;
+
+	Result benchmarkDMA()
+	{
+		Init()
+		CPU::DMA &channel = snes.cpu._dmaChannels[0];
+		// WRAM ($7E0000) to VRAM via VMDATAL/VMDATAH, two registers written once.
+		snes.bus.write(0x2115, 0b10000000);
+		snes.bus.write(0x4300, 0x01);
+		snes.bus.write(0x4301, 0x18);
+		return measure("DMA WRAM to VRAM", "bytes", [&] {
+			for (uint64_t i = 0; i < transferCount; i++) {
+				snes.bus.write(0x2116, 0x00);
+				snes.bus.write(0x2117, 0x00);
+				snes.bus.write(0x4302, 0x00);
+				snes.bus.write(0x4303, 0x00);
+				snes.bus.write(0x4304, 0x7E);
+				snes.bus.write(0x4305, transferSize & 0xFF);
+				snes.bus.write(0x4306, transferSize >> 8);
+				channel.enabled = true;
+				channel.run(std::numeric_limits<unsigned>::max());
+			}
+			return transferCount * transferSize;
+		});
+	}
+}
@@ -0,0 +1,97 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include "../benchmarks.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of instructions to run per benchmark.
+	constexpr uint64_t instructionCount = 200'000;
+
+	//! @brief A small loop mixing 8 bits accumulator and 16 bits index instructions.
+	static const uint8_t program[] = {
+		0x18,             // 0100: CLC
+		0xFB,             // 0101: XCE
+		0xC2, 0x10,       // 0102: REP #$10
+		0xA2, 0x00, 0x00, // 0104: LDX #$0000
+		0xA9, 0x01,       // 0107: LDA #$01
+		0x69, 0x02,       // 0109: ADC #$02
+		0x8D, 0x00, 0x02, // 010B: STA $0200
+		0xE8,             // 010E: INX
+		0xE0, 0x00, 0x10, // 010F: CPX #$1000
+		0xD0, 0xF3,       // 0112: BNE $0107
+		0x80, 0xEE,       // 0114: BRA $0104
+	};
+
+	//! @brief Load the benchmark program in the WRAM and jump to it.
+	static void loadProgram(SNES &snes)
+	{
+		std::copy(std::begin(program), std::end(program), snes.wram._data.begin() + 0x100);
+		snes.cpu._registers.pac = 0x000100;
+	}
+
+	Result benchmarkGenericDispatch()
+	{
+		Init()
+		loadProgram(snes);
+		return measure("CPU generic dispatch", "instructions", [&snes] {
+			CPU::CPU &cpu = snes.cpu;
+			for (uint64_t i = 0; i < instructionCount; i++) {
+				const CPU::Instruction &instruction = cpu.instructions[cpu._readPC()];
+				cpu._hasIndexCrossedPageBoundary = false;
+				uint24_t valueAddr = cpu._getValueAddr(instruction.addressingMode);
+				(cpu.*instruction.call)(valueAddr, instruction.addressingMode);
+			}
+			return instructionCount;
+		});
+	}
+
+	Result benchmarkSpecializedDispatch()
+	{
+		Init()
+		loadProgram(snes);
+		return measure("CPU specialized dispatch", "instructions", [&snes] {
+			for (uint64_t i = 0; i < instructionCount; i++)
+				snes.cpu.executeInstruction();
+			return instructionCount;
+		});
+	}
+
+	Result benchmarkBlockCache()
+	{
+		Init()
+		loadProgram(snes);
+		snes.cpu.executionMode = CPU::ExecutionMode::BlockCache;
+		return measure("CPU block cache", "instructions", [&snes] {
+			CPU::CPU &cpu = snes.cpu;
+			uint64_t instructions = 0;
+			while (instructions < instructionCount) {
+				unsigned flags = cpu._registers.p.m | cpu._registers.p.x_b << 1u | cpu._isEmulationMode << 2u;
+				uint32_t key = CPU::BlockCache::getKey(cpu._registers.pac, flags);
+				cpu._executeBlock();
+				instructions += cpu._blockCache.find(key)->instructions.size();
+			}
+			return instructions;
+		});
+	}
+
+	Result benchmarkNative()
+	{
+		Init()
+		loadProgram(snes);
+		snes.cpu.executionMode = CPU::ExecutionMode::Native;
+		return measure("CPU native blocks", "instructions", [&snes] {
+			CPU::CPU &cpu = snes.cpu;
+			uint64_t instructions = 0;
+			while (instructions < instructionCount) {
+				unsigned flags = cpu._registers.p.m | cpu._registers.p.x_b << 1u | cpu._isEmulationMode << 2u;
+				uint32_t key = CPU::BlockCache::getKey(cpu._registers.pac, flags);
+				cpu._executeBlock();
+				instructions += cpu._blockCache.find(key)->instructions.size();
+			}
+			return instructions;
+		});
+	}
+}
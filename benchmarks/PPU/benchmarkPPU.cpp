@@ -0,0 +1,62 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "../benchmarks.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of tiles rendered per benchmark.
+	constexpr uint64_t tileCount = 200'000;
+	//! @brief The number of backgrounds rendered per benchmark.
+	constexpr uint64_t backgroundCount = 20;
+
+	//! @brief Fill the VRAM and the CGRAM with pseudo random bytes, so every pixel and color is used.
+	static void fillVideoMemories(SNES &snes)
+	{
+		uint32_t seed = 0x12345678;
+		for (size_t i = 0; i < snes.ppu.vram.getSize(); i++) {
+			seed = seed * 1103515245 + 12345;
+			snes.ppu.vram._data[i] = seed >> 16;
+		}
+		for (size_t i = 0; i < snes.ppu.cgram.getSize(); i++) {
+			seed = seed * 1103515245 + 12345;
+			snes.ppu.cgram._data[i] = seed >> 16;
+		}
+	}
+
+	Result benchmarkTileRenderer(int bpp)
+	{
+		Init()
+		fillVideoMemories(snes);
+		PPU::TileRenderer renderer(snes.ppu.vram, snes.ppu.cgram);
+		renderer.setBpp(bpp);
+		renderer.setPaletteIndex(0);
+		return measure("TileRenderer " + std::to_string(bpp) + "bpp", "tiles", [&] {
+			// A tile uses 8 bytes per bit of depth.
+			uint16_t tileSize = 8 * bpp;
+			for (uint64_t i = 0; i < tileCount; i++)
+				renderer.render((i * tileSize) & 0xFFFF);
+			doNotOptimize(renderer.buffer);
+			return tileCount;
+		});
+	}
+
+	Result benchmarkBackground()
+	{
+		Init()
+		fillVideoMemories(snes);
+		PPU::Background &background = snes.ppu._backgrounds[0];
+		background.setBpp(4);
+		background.setCharacterSize({8, 8});
+		background.setTileMapStartAddress(0x0000);
+		background.setTilesetAddress(0x4000);
+		background.setTileMapMirroring({true, true});
+		return measure("Background 64x64 tiles 4bpp", "backgrounds", [&] {
+			for (uint64_t i = 0; i < backgroundCount; i++)
+				background.renderBackground();
+			doNotOptimize(background.buffer);
+			return backgroundCount;
+		});
+	}
+}
@@ -0,0 +1,84 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "benchmarks.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of accesses to run per benchmark.
+	constexpr uint64_t accessCount = 2'000'000;
+
+	Result benchmarkBusReadWRAM()
+	{
+		Init()
+		return measure("Bus read WRAM", "reads", [&snes] {
+			uint8_t sum = 0;
+			for (uint64_t i = 0; i < accessCount; i++)
+				sum += snes.bus.read(0x7E0000 + (i % snes.wram.getSize()));
+			doNotOptimize(sum);
+			return accessCount;
+		});
+	}
+
+	Result benchmarkBusReadWRAMMirror()
+	{
+		Init()
+		return measure("Bus read WRAM mirror", "reads", [&snes] {
+			uint8_t sum = 0;
+			// The first 8KB of the WRAM are mirrored in the bank $00, where the CPU reads most of its data.
+			for (uint64_t i = 0; i < accessCount; i++)
+				sum += snes.bus.read(i & 0x1FFF);
+			doNotOptimize(sum);
+			return accessCount;
+		});
+	}
+
+	Result benchmarkBusWriteWRAM()
+	{
+		Init()
+		return measure("Bus write WRAM", "writes", [&snes] {
+			for (uint64_t i = 0; i < accessCount; i++)
+				snes.bus.write(0x7E0000 + (i % snes.wram.getSize()), i);
+			return accessCount;
+		});
+	}
+
+	Result benchmarkBusReadROM()
+	{
+		Init()
+		snes.cartridge._data.resize(0x8000);
+		return measure("Bus read ROM", "reads", [&snes] {
+			uint8_t sum = 0;
+			for (uint64_t i = 0; i < accessCount; i++)
+				sum += snes.bus.read(0x808000 + (i & 0x7FFF));
+			doNotOptimize(sum);
+			return accessCount;
+		});
+	}
+
+	Result benchmarkBusReadMMIO()
+	{
+		Init()
+		return measure("Bus read MMIO", "reads", [&snes] {
+			uint8_t sum = 0;
+			// RDDIVL, the low byte of the result of a division.
+			for (uint64_t i = 0; i < accessCount; i++)
+				sum += snes.bus.read(0x4214);
+			doNotOptimize(sum);
+			return accessCount;
+		});
+	}
+
+	Result benchmarkBusWriteMMIO()
+	{
+		Init()
+		// Increment the VRAM address after each write to VMDATAL.
+		snes.bus.write(0x2115, 0x00);
+		return measure("Bus write MMIO", "writes", [&snes] {
+			for (uint64_t i = 0; i < accessCount; i++)
+				snes.bus.write(0x2118, i);
+			return accessCount;
+		});
+	}
+}
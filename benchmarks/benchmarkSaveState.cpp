@@ -0,0 +1,92 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <algorithm>
+#include "benchmarks.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of saves or loads to run per benchmark.
+	constexpr uint64_t stateCount = 10'000;
+
+	Result benchmarkSaveState()
+	{
+		Init()
+		SaveState::SaveState state;
+		return measure("Save state", "saves", [&] {
+			for (uint64_t i = 0; i < stateCount; i++)
+				snes.saveState(state);
+			return stateCount;
+		});
+	}
+
+	//! @brief Sum the bytes of the memories of a console that are not shared with another console.
+	static size_t getOwnedBytes(const SNES &snes)
+	{
+		return snes.cartridge.getPages().getOwnedBytes()
+			+ snes.wram.getPages().getOwnedBytes()
+			+ snes.sram.getPages().getOwnedBytes()
+			+ snes.ppu.vram.getPages().getOwnedBytes()
+			+ snes.ppu.oamram.getPages().getOwnedBytes()
+			+ snes.ppu.cgram.getPages().getOwnedBytes()
+			+ snes.apu._map.ram.getOwnedBytes();
+	}
+
+	Result benchmarkClone()
+	{
+		Init()
+		auto target = snes.clone(norenderer);
+		return measure("Clone", "clones", [&] {
+			for (uint64_t i = 0; i < stateCount; i++)
+				snes.cloneTo(*target);
+			return stateCount;
+		});
+	}
+
+	Result benchmarkFullCopy()
+	{
+		Init()
+		auto target = snes.clone(norenderer);
+		SaveState::SaveState state;
+		return measure("Full copy", "copies", [&] {
+			for (uint64_t i = 0; i < stateCount; i++) {
+				snes.saveState(state);
+				target->loadState(state);
+			}
+			return stateCount;
+		});
+	}
+
+	void reportCloneMemory()
+	{
+		Init()
+		// STA $0010; BRA $0100
+		const uint8_t program[] = {0x8D, 0x10, 0x00, 0x80, 0xFB};
+		std::copy(std::begin(program), std::end(program), snes.wram._data.begin() + 0x100);
+		snes.cpu._registers.pac = 0x000100;
+		SaveState::SaveState state;
+		snes.saveState(state);
+		auto clone = snes.clone(norenderer);
+		size_t afterClone = getOwnedBytes(*clone);
+		for (int i = 0; i < 10'000; i++) {
+			clone->cpu.update(0x0C);
+			clone->apu.sync();
+		}
+		std::cout << "Clone memory: " << afterClone << " bytes after cloning, "
+		          << getOwnedBytes(*clone) << " bytes after 10000 updates, "
+		          << "full copy: " << state.getSize() << " bytes" << std::endl;
+	}
+
+	Result benchmarkLoadState()
+	{
+		Init()
+		SaveState::SaveState state;
+		snes.saveState(state);
+		return measure("Load state", "loads", [&] {
+			for (uint64_t i = 0; i < stateCount; i++)
+				snes.loadState(state);
+			return stateCount;
+		});
+	}
+}
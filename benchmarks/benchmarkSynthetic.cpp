@@ -0,0 +1,30 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include "benchmarks.hpp"
+#include "Headless/RomGenerator.hpp"
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The minimum number of instructions to run per benchmark.
+	constexpr uint64_t syntheticInstructionCount = 200'000;
+
+	Result benchmarkWorkload(Headless::Workload workload)
+	{
+		Renderer::NoRenderer renderer(0, 0, 0);
+		std::string name = Headless::RomGenerator::getName(workload);
+		std::string path = (std::filesystem::temp_directory_path() / ("comsquare_" + name + ".sfc")).string();
+		Headless::RomGenerator(name).add(workload).write(path);
+		auto snes = std::make_unique<SNES>(path, renderer);
+		std::filesystem::remove(path);
+
+		// Only the CPU (and the DMA it starts) runs, the other components would hide its cost.
+		return measure("Synthetic " + name, "instructions", [&snes] {
+			uint64_t start = snes->cpu.instructionCount;
+			while (snes->cpu.instructionCount - start < syntheticInstructionCount)
+				snes->cpu.update(0x0C);
+			return snes->cpu.instructionCount - start;
+		});
+	}
+}
@@ -0,0 +1,155 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+// The include here is to prevent successive includes of this file to come after the define.
+#include <filesystem>
+
+#define private public
+#define protected public
+
+#include "Headless/RomGenerator.hpp"
+#include "Renderer/NoRenderer.hpp"
+#include "SNES.hpp"
+
+//! @brief Create a SNES with an empty LoRom cartridge and no renderer (same setup as the unit tests).
+#define Init() \
+	Renderer::NoRenderer norenderer(0, 0, 0);                  \
+	auto snesPtr = std::make_unique<SNES>(norenderer);         \
+	SNES &snes = *snesPtr;                                     \
+	snes.cartridge._data.resize(100);                          \
+	snes.cartridge.header.mappingMode = Cartridge::LoRom;      \
+	snes.sram._data.resize(100);                               \
+	snes.bus.mapComponents(snes);
+
+namespace ComSquare::Benchmarks
+{
+	//! @brief The number of timed runs of each benchmark (the median is reported).
+	constexpr unsigned repetitions = 5;
+
+	//! @brief The result of a benchmark.
+	struct Result
+	{
+		//! @brief The name of the benchmark.
+		std::string name;
+		//! @brief The number of operations run by each repetition.
+		uint64_t operations;
+		//! @brief The unit of an operation (used for display).
+		std::string unit;
+		//! @brief The median wall time of a repetition.
+		std::chrono::duration<double> elapsed;
+		//! @brief The wall time of the fastest repetition.
+		std::chrono::duration<double> fastest;
+	};
+
+	//! @brief Prevent the compiler from removing the computation of a value that is never used.
+	template<typename T>
+	inline void doNotOptimize(const T &value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	//! @brief Run a function once to warm the caches, then time it a few times.
+	//! @param name The name of the benchmark.
+	//! @param unit The unit of an operation.
+	//! @param func The function to time. It should return the number of operations it ran.
+	//! @info The function is called repetitions + 1 times on the same state, it should not rely on being called once.
+	template<typename Func>
+	Result measure(const std::string &name, const std::string &unit, Func &&func)
+	{
+		std::vector<std::chrono::duration<double>> times;
+		uint64_t operations = 0;
+
+		func();
+		for (unsigned i = 0; i < repetitions; i++) {
+			auto start = std::chrono::steady_clock::now();
+			operations = func();
+			times.emplace_back(std::chrono::steady_clock::now() - start);
+		}
+		std::sort(times.begin(), times.end());
+		return Result{name, operations, unit, times[times.size() / 2], times.front()};
+	}
+
+	//! @brief Print a result to the standard output.
+	inline void report(const Result &result)
+	{
+		std::cout << result.name << ": "
+		          << static_cast<uint64_t>(result.operations / result.elapsed.count()) << " " << result.unit << "/s"
+		          << " (" << result.operations << " " << result.unit << " in " << result.elapsed.count() << "s, "
+		          << "fastest " << result.fastest.count() << "s)"
+		          << std::endl;
+	}
+
+	//! @brief Print every result as a JSON document, so runs can be compared by scripts.
+	inline void reportJson(const std::vector<Result> &results)
+	{
+		std::cout << "{\n\t\"repetitions\": " << repetitions << ",\n\t\"benchmarks\": [";
+		for (size_t i = 0; i < results.size(); i++) {
+			const Result &result = results[i];
+			std::cout << (i ? "," : "") << "\n\t\t{"
+			          << "\"name\": \"" << result.name << "\", "
+			          << "\"unit\": \"" << result.unit << "\", "
+			          << "\"operations\": " << result.operations << ", "
+			          << "\"seconds\": " << result.elapsed.count() << ", "
+			          << "\"fastestSeconds\": " << result.fastest.count() << ", "
+			          << "\"operationsPerSecond\": " << result.operations / result.elapsed.count()
+			          << "}";
+		}
+		std::cout << "\n\t]\n}" << std::endl;
+	}
+
+	//! @brief Run the CPU with the generic handlers (checking the m, x and e flags at runtime).
+	Result benchmarkGenericDispatch();
+	//! @brief Run the CPU with the handlers specialized for the current m, x and e flags.
+	Result benchmarkSpecializedDispatch();
+	//! @brief Run the CPU from the block cache.
+	Result benchmarkBlockCache();
+	//! @brief Run the CPU from the native code of the blocks.
+	Result benchmarkNative();
+	//! @brief Save the state of the whole console repeatedly in the same buffer.
+	Result benchmarkSaveState();
+	//! @brief Restore the state of the whole console repeatedly.
+	Result benchmarkLoadState();
+	//! @brief Clone the console repeatedly (the memories are shared until written).
+	Result benchmarkClone();
+	//! @brief Copy the console to another instance with a full save state, as the clone did before sharing memories.
+	Result benchmarkFullCopy();
+	//! @brief Print the memory used by a clone compared to a full save state.
+	void reportCloneMemory();
+
+	//! @brief Read bytes of the WRAM through the memory bus.
+	Result benchmarkBusReadWRAM();
+	//! @brief Read bytes of the WRAM through its mirror in the bank $00.
+	Result benchmarkBusReadWRAMMirror();
+	//! @brief Write bytes to the WRAM through the memory bus.
+	Result benchmarkBusWriteWRAM();
+	//! @brief Read bytes of the ROM through the memory bus.
+	Result benchmarkBusReadROM();
+	//! @brief Read a CPU register through the memory bus.
+	Result benchmarkBusReadMMIO();
+	//! @brief Write to the VRAM data port of the PPU through the memory bus.
+	Result benchmarkBusWriteMMIO();
+	//! @brief Render tiles of the VRAM with the given number of bits per pixel.
+	Result benchmarkTileRenderer(int bpp);
+	//! @brief Render a whole 64x64 tiles background.
+	Result benchmarkBackground();
+	//! @brief Run the DSP for full samples without any voice playing.
+	Result benchmarkDSPSilent();
+	//! @brief Run the DSP for full samples with the 8 voices playing a looping sample.
+	Result benchmarkDSPVoices();
+	//! @brief Run the SPC700 of the APU through its dispatch table.
+	Result benchmarkSPC700Dispatch();
+	//! @brief Transfer WRAM to the VRAM with a DMA channel.
+	Result benchmarkDMA();
+	//! @brief Run the CPU on a synthetic rom made of a single workload.
+	Result benchmarkWorkload(Headless::Workload workload);
+}
@@ -0,0 +1,51 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <cstring>
+#include "benchmarks.hpp"
+
+using namespace ComSquare;
+
+int main(int argc, char **argv)
+{
+	bool json = argc > 1 && !std::strcmp(argv[1], "--json");
+	std::vector<Benchmarks::Result> results = {
+		Benchmarks::benchmarkBusReadWRAM(),
+		Benchmarks::benchmarkBusReadWRAMMirror(),
+		Benchmarks::benchmarkBusWriteWRAM(),
+		Benchmarks::benchmarkBusReadROM(),
+		Benchmarks::benchmarkBusReadMMIO(),
+		Benchmarks::benchmarkBusWriteMMIO(),
+		Benchmarks::benchmarkGenericDispatch(),
+		Benchmarks::benchmarkSpecializedDispatch(),
+		Benchmarks::benchmarkBlockCache(),
+		Benchmarks::benchmarkNative(),
+		Benchmarks::benchmarkWorkload(Headless::Workload::AddressingModes),
+		Benchmarks::benchmarkWorkload(Headless::Workload::Arithmetic16),
+		Benchmarks::benchmarkWorkload(Headless::Workload::BlockMoves),
+		Benchmarks::benchmarkWorkload(Headless::Workload::Subroutines),
+		Benchmarks::benchmarkWorkload(Headless::Workload::DmaBursts),
+		Benchmarks::benchmarkTileRenderer(2),
+		Benchmarks::benchmarkTileRenderer(4),
+		Benchmarks::benchmarkTileRenderer(8),
+		Benchmarks::benchmarkBackground(),
+		Benchmarks::benchmarkSPC700Dispatch(),
+		Benchmarks::benchmarkDSPSilent(),
+		Benchmarks::benchmarkDSPVoices(),
+		Benchmarks::benchmarkDMA(),
+		Benchmarks::benchmarkSaveState(),
+		Benchmarks::benchmarkLoadState(),
+		Benchmarks::benchmarkClone(),
+		Benchmarks::benchmarkFullCopy(),
+	};
+
+	if (json) {
+		Benchmarks::reportJson(results);
+		return 0;
+	}
+	for (const Benchmarks::Result &result : results)
+		Benchmarks::report(result);
+	Benchmarks::reportCloneMemory();
+	return 0;
+}
@@ -2,6 +2,7 @@
 // Created by Melefo on 12/02/2020.
 //
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include "tests.hpp"
 #include "SNES.hpp"
@@ -30,7 +31,7 @@ TEST_CASE("Page0 read Read", "[Read]")
 	Init()
 	uint8_t result;
 
-	snes.apu._map.Page0._data[0x0010] = 123;
+	snes.apu._map.ram[0x0010] = 123;
 	result = snes.apu._internalRead(0x0010);
 	REQUIRE(result == 123);
 }
@@ -40,7 +41,7 @@ TEST_CASE("Page1 read Read", "[Read]")
 	Init()
 	uint8_t result = 0;
 
-	snes.apu._map.Page1._data[0x0042] = 123;
+	snes.apu._map.ram[0x0142] = 123;
 	result = snes.apu._internalRead(0x0142);
 	REQUIRE(result == 123);
 }
@@ -50,7 +51,7 @@ TEST_CASE("Memory internalRead", "[internalRead]")
 	Init()
 	uint8_t result = 0;
 
-	snes.apu._map.Memory._data[0xFCDC] = 123;
+	snes.apu._map.ram[0xFEDC] = 123;
 	result = snes.apu._internalRead(0xFEDC);
 	REQUIRE(result == 123);
 }
@@ -65,6 +66,19 @@ TEST_CASE("IPL internalRead", "[internalRead]")
 	REQUIRE(result == 123);
 }
 
+TEST_CASE("DSP ram internalRead", "[internalRead]")
+{
+	Init()
+
+	snes.apu._map.ram[0x00F4] = 123;
+	snes.apu._map.ram[0xFFC0] = 45;
+	snes.apu._registers.port0 = 67;
+	REQUIRE(snes.apu._internalRead(0x00F4) == 67);
+	REQUIRE(snes.apu._internalRead(0xFFC0) == snes.apu._map.IPL._data[0]);
+	REQUIRE(snes.apu._dsp._readRAM(0x00F4) == 123);
+	REQUIRE(snes.apu._dsp._readRAM(0xFFC0) == 45);
+}
+
 TEST_CASE("Invalid internalRead", "[internalRead]")
 {
 	Init()
@@ -85,7 +99,7 @@ TEST_CASE("Page0 write Write", "[Write]")
 
 
 	snes.apu._internalWrite(0x0001, 123);
-	REQUIRE(snes.apu._map.Page0._data[0x0001] == 123);
+	REQUIRE(snes.apu._map.ram[0x0001] == 123);
 }
 
 TEST_CASE("register write Write", "[Write]")
@@ -103,7 +117,7 @@ TEST_CASE("Page1 internalWrite", "[internalWrite]")
 
 
 	snes.apu._internalWrite(0x01FF, 123);
-	REQUIRE(snes.apu._map.Page1._data[0x00FF] == 123);
+	REQUIRE(snes.apu._map.ram[0x01FF] == 123);
 }
 
 TEST_CASE("Memory write internalWrite", "[internalWrite]")
@@ -112,7 +126,7 @@ TEST_CASE("Memory write internalWrite", "[internalWrite]")
 
 
 	snes.apu._internalWrite(0x0789, 123);
-	REQUIRE(snes.apu._map.Memory._data[0x0589] == 123);
+	REQUIRE(snes.apu._map.ram[0x0789] == 123);
 }
 
 TEST_CASE("IPL internalWrite", "[internalWrite]")
@@ -195,6 +209,34 @@ TEST_CASE("Valid executeInstruction", "[executeInstruction]")
 	REQUIRE(result == 2);
 }
 
+TEST_CASE("DirectPage executeInstruction", "[executeInstruction]")
+{
+	Init()
+	const uint8_t program[] = {
+		0xC4, 0x10, // MOV $10, A
+		0x40,       // SETP
+		0xC4, 0x10, // MOV $10, A
+		0x20,       // CLRP
+		0xD4, 0x20, // MOV $20+X, A
+	};
+
+	std::copy(std::begin(program), std::end(program), snes.apu._map.ram.begin() + 0x0200);
+	snes.apu._internalRegisters.pc = 0x0200;
+	snes.apu._internalRegisters.a = 0x12;
+	snes.apu._internalRegisters.x = 0x03;
+	REQUIRE(snes.apu._executeInstruction() == 4);
+	REQUIRE(snes.apu._map.ram[0x0010] == 0x12);
+	snes.apu._executeInstruction();
+	snes.apu._internalRegisters.a = 0x34;
+	snes.apu._executeInstruction();
+	REQUIRE(snes.apu._map.ram[0x0110] == 0x34);
+	REQUIRE(snes.apu._map.ram[0x0010] == 0x12);
+	snes.apu._executeInstruction();
+	REQUIRE(snes.apu._executeInstruction() == 5);
+	REQUIRE(snes.apu._map.ram[0x0023] == 0x34);
+	REQUIRE(snes.apu._internalRegisters.pc == 0x0208);
+}
+
 ///////////////////////
 //					 //
 // APU::update tests //
@@ -221,6 +263,257 @@ TEST_CASE("stopped update", "[update]")
 	REQUIRE(snes.apu._paddingCycles == 0);
 }
 
+TEST_CASE("dsp update", "[update]")
+{
+	Init()
+	snes.apu._state = APU::Stopped;
+	for (int i = 0; i < 40; i++)
+		snes.apu.update(1);
+	// The DSP only renders whole samples (a stereo pair every 32 cycles).
+	REQUIRE(snes.apu._dsp.getSamplesCount() == 2);
+	REQUIRE(snes.apu._dspCycles == 32);
+
+	snes.apu._runSPC700(40);
+	REQUIRE(snes.apu._dsp.getSamplesCount() == 2);
+	snes.apu.update(0);
+	REQUIRE(snes.apu._dsp.getSamplesCount() == 4);
+	REQUIRE(snes.apu._dspCycles == 64);
+	snes.apu._cycles = 128;
+	// Accessing the DSP registers lets it catch up first.
+	snes.apu._internalWrite(0xF2, 0x0C);
+	snes.apu._internalWrite(0xF3, 0x7F);
+	REQUIRE(snes.apu._dsp.getSamplesCount() == 8);
+	REQUIRE(snes.apu._dspCycles == 128);
+}
+
+TEST_CASE("sync update", "[update]")
+{
+	Init()
+	snes.apu._state = APU::Stopped;
+	// A frame lasts for 17038.7 cycles of the SPC700, the fraction is carried to the next sync.
+	snes.scheduler.advance(Scheduler::Scheduler::masterCyclesPerFrame);
+	snes.apu.sync();
+	REQUIRE(snes.apu._cycles == 17038);
+	snes.scheduler.advance(Scheduler::Scheduler::masterCyclesPerFrame);
+	snes.apu.sync();
+	REQUIRE(snes.apu._cycles == 34077);
+	REQUIRE(snes.apu._dsp.getSamplesCount() == 34077 / 32 * 2);
+}
+
+TEST_CASE("silent voices dsp", "[dsp]")
+{
+	Init()
+	auto referencePtr = std::make_unique<SNES>(norenderer);
+	APU::DSP::DSP &dsp = snes.apu._dsp;
+	APU::DSP::DSP &reference = referencePtr->apu._dsp;
+	reference.isSilentVoiceSkippingEnabled = false;
+	for (SNES *console : {&snes, referencePtr.get()}) {
+		std::fill_n(console->apu._map.ram.begin() + 0x200, 0x100, 0x03);
+		console->apu._dsp.write(0x5D, 0x02); // DIR
+		for (int voice = 0; voice < 8; voice++)
+			console->apu._dsp.write(voice << 4 | 0x03, 0x3F); // P (H)
+	}
+
+	dsp.renderSamples(100);
+	reference.renderSamples(100);
+	REQUIRE(dsp.voiceStatistics.voiceSamples == 800);
+	REQUIRE(dsp.voiceStatistics.silentVoiceSamples == 800);
+	REQUIRE(reference.voiceStatistics.silentVoiceSamples == 0);
+	// The voices still reach the end of their sample.
+	REQUIRE(dsp.read(0x7C) != 0);
+	REQUIRE(dsp.read(0x7C) == reference.read(0x7C));
+	for (int voice = 0; voice < 8; voice++) {
+		REQUIRE(dsp.read(voice << 4 | 0x08) == reference.read(voice << 4 | 0x08));
+		REQUIRE(dsp.read(voice << 4 | 0x09) == reference.read(voice << 4 | 0x09));
+		// The decoded samples are still there for the first block after a key on.
+		REQUIRE(dsp._lanes.samples[voice] == reference._lanes.samples[voice]);
+	}
+	REQUIRE(std::equal(dsp.getSoundBuffer().begin(), dsp.getSoundBuffer().end(), reference.getSoundBuffer().begin()));
+
+	dsp._voices[0].envelopeMode = APU::DSP::Envelope::Attack;
+	dsp._lanes.envelope[0] = 0x400;
+	dsp.renderSamples(100);
+	REQUIRE(dsp.voiceStatistics.silentVoiceSamples == 1500);
+}
+
+TEST_CASE("brr cache dsp", "[dsp]")
+{
+	Init()
+	APU::DSP::DSP &dsp = snes.apu._dsp;
+	APU::DSP::Voice &voice = dsp._voices[0];
+	std::array<uint16_t, 24> &samples = dsp._lanes.samples[0];
+	uint8_t &sampleOffset = dsp._lanes.sampleOffset[0];
+	snes.apu._map.ram[0x0302] = 0x37;
+	dsp._brr.header = 0x00; // Range 0, no filter
+	dsp._brr.value = 0x00;
+	voice.brrAddress = 0x0300;
+	voice.brrOffset = 1;
+	sampleOffset = 0;
+	samples = {};
+	dsp.decodeBRR(voice);
+	std::array<uint16_t, 24> decoded = samples;
+	REQUIRE(dsp.brrCacheStatistics.misses == 1);
+	REQUIRE(dsp.brrCacheStatistics.hits == 0);
+
+	// Without filter, the previous samples do not matter.
+	sampleOffset = 0;
+	samples = {};
+	samples[11] = 0x08;
+	dsp.decodeBRR(voice);
+	REQUIRE(dsp.brrCacheStatistics.hits == 1);
+	REQUIRE(sampleOffset == 4);
+	REQUIRE(std::equal(decoded.begin(), decoded.begin() + 4, samples.begin()));
+
+	// With a filter, they do.
+	dsp._brr.header = 0x04;
+	sampleOffset = 0;
+	dsp.decodeBRR(voice);
+	sampleOffset = 0;
+	samples[11] = 0x0A;
+	dsp.decodeBRR(voice);
+	REQUIRE(dsp.brrCacheStatistics.misses == 3);
+	REQUIRE(dsp.brrCacheStatistics.hits == 1);
+
+	// Writing to the RAM of the block decodes it again.
+	dsp._brr.header = 0x00;
+	snes.apu._map.ram[0x0302] = 0x12;
+	sampleOffset = 0;
+	samples = {};
+	dsp.decodeBRR(voice);
+	REQUIRE(dsp.brrCacheStatistics.misses == 4);
+	REQUIRE(samples != decoded);
+}
+
+TEST_CASE("interpolate dsp", "[dsp]")
+{
+	Init()
+	APU::DSP::VoiceLanes &lanes = snes.apu._dsp._lanes;
+	for (unsigned i = 0; i < 12; i++) {
+		// The samples of the voice 2 are rotated so that the ones it reads wrap around the end of its buffer.
+		lanes.samples[1][i] = i * 2;
+		lanes.samples[1][i + 12] = i * 2;
+		lanes.samples[2][(i + 7) % 12] = i * 2;
+		lanes.samples[2][(i + 7) % 12 + 12] = i * 2;
+	}
+	lanes.sampleOffset[1] = 0;
+	lanes.sampleOffset[2] = 7;
+	for (unsigned voice : {1, 2}) {
+		lanes.gaussOffset[voice] = 0x3800;
+		lanes.envelope[voice] = 0x7FF;
+	}
+	snes.apu._dsp.interpolate();
+	REQUIRE(lanes.output[1] == 4);
+	REQUIRE(lanes.output[2] == 4);
+	REQUIRE(lanes.output[0] == 0);
+}
+
+TEST_CASE("echo filter dsp", "[dsp]")
+{
+	Init()
+	APU::DSP::DSP &dsp = snes.apu._dsp;
+	dsp.renderSamples(20);
+	REQUIRE(dsp._echo.historyOffset == 4);
+
+	dsp._echo.address = 0x4000;
+	snes.apu._map.ram[0x4001] = 0x10; // Left: $1000
+	snes.apu._map.ram[0x4003] = 0xF0; // Right: -$1000
+	dsp._echo.historyOffset = 3;
+	dsp._echo.history = {};
+	dsp._echo.history[8] = 0x100;
+	dsp._echo.history[9] = 0x100;
+	dsp._echo.FIR = {0x20, 0, 0, 0, 0, 0, 0, 0x40};
+	dsp.loadEcho();
+	REQUIRE(dsp._echo.history[6] == 0x800);
+	REQUIRE(dsp._echo.history[23] == -0x800);
+	dsp.filterEcho();
+	REQUIRE(dsp._echo.input[0] == 0x880);
+	REQUIRE(dsp._echo.input[1] == 0xF880);
+
+	dsp._echo.toggle = false;
+	for (uint16_t address : {0x4000, 0xFFFE}) {
+		dsp._echo.address = address;
+		dsp._echo.output = {0x1234, 0xFEDC};
+		dsp.writeEcho();
+		REQUIRE(dsp._echo.output[0] == 0);
+		REQUIRE(snes.apu._map.ram[address] == 0x34);
+		REQUIRE(snes.apu._map.ram[static_cast<uint16_t>(address + 1)] == 0x12);
+		REQUIRE(snes.apu._map.ram[static_cast<uint16_t>(address + 2)] == 0xDC);
+		REQUIRE(snes.apu._map.ram[static_cast<uint16_t>(address + 3)] == 0xFE);
+	}
+}
+
+TEST_CASE("lazy update", "[update]")
+{
+	Init()
+	snes.apu._internalRegisters.pc = 0x0200;
+	snes.apu._map.ram[0x200] = 0xAB; // INC $10
+	snes.apu._map.ram[0x201] = 0x10;
+	snes.apu._map.ram[0x202] = 0x2F; // BRA $0200
+	snes.apu._map.ram[0x203] = 0xFC;
+	// 120 cycles of the SPC700.
+	snes.scheduler.advance(2517);
+	REQUIRE(snes.apu._internalRegisters.pc == 0x0200);
+	REQUIRE(snes.apu._map.ram[0x10] == 0);
+
+	snes.apu.read(0x00);
+	REQUIRE(snes.apu._timestamp == 2517);
+	// 120 cycles of 4 cycles INC and 4 cycles BRA.
+	REQUIRE(snes.apu._map.ram[0x10] == 15);
+}
+
+/////////////////////////
+//					   //
+// APU timers tests	   //
+//					   //
+/////////////////////////
+
+TEST_CASE("8kHz timers", "[timers]")
+{
+	Init()
+	snes.apu._internalWrite(0xFA, 2);
+	snes.apu._internalWrite(0xF1, 0x01);
+	snes.apu._cycles += 128 * 5;
+	REQUIRE(snes.apu._internalRead(0xFD) == 2);
+	REQUIRE(snes.apu._internalRead(0xFD) == 0);
+	REQUIRE(snes.apu._timerStages[0] == 1);
+	REQUIRE(snes.apu._internalRead(0xFE) == 0);
+}
+
+TEST_CASE("64kHz timers", "[timers]")
+{
+	Init()
+	snes.apu._internalWrite(0xFC, 0);
+	snes.apu._internalWrite(0xF1, 0x04);
+	snes.apu._cycles += 16 * 256 * 3 + 8;
+	REQUIRE(snes.apu._internalRead(0xFF) == 3);
+	snes.apu._cycles += 16 * 256 * 17;
+	REQUIRE(snes.apu._internalRead(0xFF) == 1);
+}
+
+TEST_CASE("reconfigure timers", "[timers]")
+{
+	Init()
+	snes.apu._internalWrite(0xFA, 100);
+	snes.apu._internalWrite(0xF1, 0x01);
+	snes.apu._cycles += 128 * 50;
+	REQUIRE(snes.apu._internalRead(0xFD) == 0);
+	// The internal counter is already past the new target, it has to wrap around.
+	snes.apu._internalWrite(0xFA, 10);
+	snes.apu._cycles += 128 * 215;
+	REQUIRE(snes.apu._internalRead(0xFD) == 0);
+	snes.apu._cycles += 128;
+	REQUIRE(snes.apu._internalRead(0xFD) == 1);
+
+	snes.apu._internalWrite(0xF1, 0x00);
+	snes.apu._cycles += 128 * 100;
+	REQUIRE(snes.apu._internalRead(0xFD) == 0);
+	// Enabling the timer again resets it.
+	snes.apu._timerStages[0] = 9;
+	snes.apu._internalWrite(0xF1, 0x01);
+	snes.apu._cycles += 128 * 9;
+	REQUIRE(snes.apu._internalRead(0xFD) == 0);
+}
+
 //////////////////////////
 //						//
 // APU::_get*Addr tests	//
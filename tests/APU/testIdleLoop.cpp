@@ -0,0 +1,87 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../tests.hpp"
+using namespace ComSquare;
+
+TEST_CASE("portPolling apuIdleLoop", "[apuIdleLoop]")
+{
+	Init()
+	snes.apu._internalRegisters.pc = 0x0200;
+	snes.apu._internalRegisters.a = 0x42;
+	snes.apu._map.ram[0x200] = 0x64; // CMP A, $F4
+	snes.apu._map.ram[0x201] = 0xF4;
+	snes.apu._map.ram[0x202] = 0xD0; // BNE $0200
+	snes.apu._map.ram[0x203] = 0xFC;
+	snes.apu.update(100);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedLoops == 1);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedCycles > 50);
+	REQUIRE(snes.apu._internalRegisters.pc == 0x200);
+	snes.apu.update(100);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedLoops == 1);
+	REQUIRE(snes.apu._internalRegisters.pc == 0x200);
+
+	snes.apu.write(0x00, 0x42);
+	snes.apu.update(100);
+	REQUIRE(snes.apu._internalRegisters.pc > 0x203);
+}
+
+TEST_CASE("counterPolling apuIdleLoop", "[apuIdleLoop]")
+{
+	Init()
+	snes.apu._internalRegisters.pc = 0x0200;
+	snes.apu._map.ram[0x200] = 0x1E; // CMP X, $00FD
+	snes.apu._map.ram[0x201] = 0xFD;
+	snes.apu._map.ram[0x202] = 0x00;
+	snes.apu._map.ram[0x203] = 0xF0; // BEQ $0200
+	snes.apu._map.ram[0x204] = 0xFB;
+	snes.apu.update(100);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedLoops == 1);
+	REQUIRE_FALSE(snes.apu._isWaitingForPort);
+	snes.apu.update(100);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedLoops == 2);
+}
+
+TEST_CASE("timerPolling apuIdleLoop", "[apuIdleLoop]")
+{
+	Init()
+	snes.apu._internalWrite(0xFC, 4);
+	snes.apu._internalWrite(0xF1, 0x04);
+	snes.apu._internalRegisters.pc = 0x0200;
+	snes.apu._map.ram[0x200] = 0x1E; // CMP X, $00FF
+	snes.apu._map.ram[0x201] = 0xFF;
+	snes.apu._map.ram[0x202] = 0x00;
+	snes.apu._map.ram[0x203] = 0xF0; // BEQ $0200
+	snes.apu._map.ram[0x204] = 0xFB;
+	snes.apu._map.ram[0x205] = 0xFF; // STOP
+	snes.apu.update(100);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedLoops == 1);
+	// The loop runs again when the counter is incremented, after 4 ticks of 16 cycles.
+	REQUIRE(snes.apu._internalRegisters.pc == 0x0206);
+	REQUIRE(snes.apu._state == APU::Stopped);
+}
+
+TEST_CASE("ramPolling apuIdleLoop", "[apuIdleLoop]")
+{
+	Init()
+	snes.apu._internalRegisters.pc = 0x0200;
+	snes.apu._map.ram[0x200] = 0x64; // CMP A, $10
+	snes.apu._map.ram[0x201] = 0x10;
+	snes.apu._map.ram[0x202] = 0xF0; // BEQ $0200
+	snes.apu._map.ram[0x203] = 0xFC;
+	snes.apu.update(100);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedLoops == 0);
+}
+
+TEST_CASE("disabled apuIdleLoop", "[apuIdleLoop]")
+{
+	Init()
+	snes.apu.isIdleLoopSkippingEnabled = false;
+	snes.apu._internalRegisters.pc = 0x0200;
+	snes.apu._map.ram[0x200] = 0x2F; // BRA $0200
+	snes.apu._map.ram[0x201] = 0xFE;
+	snes.apu.update(100);
+	REQUIRE(snes.apu.idleLoopStatistics.skippedLoops == 0);
+}
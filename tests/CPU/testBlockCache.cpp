@@ -0,0 +1,201 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../tests.hpp"
+#include "Differential/Differential.hpp"
+#include "Exceptions/InvalidAction.hpp"
+#include "Exceptions/InvalidAddress.hpp"
+using namespace ComSquare;
+
+//! @brief A loop using 8 and 16 bits instructions, leaving its results in the WRAM.
+static const uint8_t loopProgram[] = {
+	0x18,             // 0100: CLC
+	0xFB,             // 0101: XCE
+	0xC2, 0x10,       // 0102: REP #$10
+	0xA2, 0x00, 0x00, // 0104: LDX #$0000
+	0x8A,             // 0107: TXA
+	0x69, 0x03,       // 0108: ADC #$03
+	0x9D, 0x00, 0x02, // 010A: STA $0200,X
+	0xE8,             // 010D: INX
+	0xE0, 0x40, 0x00, // 010E: CPX #$0040
+	0xD0, 0xF4,       // 0111: BNE $0107
+	0x80, 0xFE,       // 0113: BRA $0113
+};
+
+//! @brief A program that overwrites the opcode of an instruction of its own block (LDA #$07 becomes LDX #$07).
+static const uint8_t selfModifyingProgram[] = {
+	0xA9, 0xA2,       // 0100: LDA #$A2
+	0x8D, 0x05, 0x01, // 0102: STA $0105
+	0xA9, 0x07,       // 0105: LDA #$07
+	0x80, 0xFE,       // 0107: BRA $0107
+};
+
+//! @brief A program using the instructions the native code runs inline, then a write out of the SRAM.
+static const uint8_t inlineProgram[] = {
+	0x38,                   // 0100: SEC
+	0xF8,                   // 0101: SED
+	0xD8,                   // 0102: CLD
+	0xCA,                   // 0103: DEX
+	0x88,                   // 0104: DEY
+	0xC8,                   // 0105: INY
+	0xE8,                   // 0106: INX
+	0xE8,                   // 0107: INX
+	0xEA,                   // 0108: NOP
+	0x8F, 0x00, 0x02, 0x70, // 0109: STA $700200
+	0x80, 0xFE,             // 010D: BRA $010D
+};
+
+template<size_t size>
+static void loadProgram(SNES &snes, const uint8_t (&program)[size])
+{
+	std::copy(std::begin(program), std::end(program), snes.wram._data.begin() + 0x100);
+	snes.cpu._registers.pac = 0x000100;
+}
+
+//! @brief Run the loop program with the interpreter and with another execution mode and check that the results match.
+static void requireSameAsInterpreter(CPU::ExecutionMode mode)
+{
+	Init()
+	Renderer::NoRenderer otherRenderer(0, 0, 0);
+	auto otherPtr = std::make_unique<SNES>(otherRenderer);
+	SNES &other = *otherPtr;
+	other.cartridge._data.resize(100);
+	other.cartridge.header.mappingMode = Cartridge::LoRom;
+	other.sram._data.resize(100);
+	other.bus.mapComponents(other);
+
+	loadProgram(snes, loopProgram);
+	loadProgram(other, loopProgram);
+	other.cpu.executionMode = mode;
+	for (int i = 0; i < 200; i++) {
+		snes.cpu.update(0x0C);
+		other.cpu.update(0x0C);
+	}
+	REQUIRE(other.cpu._blockCache.size() > 0);
+	REQUIRE(other.cpu._registers.pac == snes.cpu._registers.pac);
+	REQUIRE(other.cpu._registers.a == snes.cpu._registers.a);
+	REQUIRE(other.cpu._registers.x == snes.cpu._registers.x);
+	REQUIRE(other.cpu._registers.p.flags == snes.cpu._registers.p.flags);
+	REQUIRE(other.wram._data == snes.wram._data);
+	REQUIRE(other.wram._data[0x0202] == 0x05);
+}
+
+TEST_CASE("sameAsInterpreter blockCache", "[blockCache]")
+{
+	requireSameAsInterpreter(CPU::ExecutionMode::BlockCache);
+}
+
+TEST_CASE("sameAsInterpreter native", "[blockCache]")
+{
+	requireSameAsInterpreter(CPU::ExecutionMode::Native);
+}
+
+TEST_CASE("selfModifying blockCache", "[blockCache]")
+{
+	Init()
+	loadProgram(snes, selfModifyingProgram);
+	snes.cpu.executionMode = CPU::ExecutionMode::BlockCache;
+	snes.cpu.update(0x20);
+	REQUIRE(snes.cpu._registers.a == 0xA2);
+	REQUIRE(snes.cpu._registers.x == 0x07);
+	REQUIRE(snes.cpu._registers.pc == 0x0107);
+}
+
+TEST_CASE("selfModifying native", "[blockCache]")
+{
+	Init()
+	loadProgram(snes, selfModifyingProgram);
+	snes.cpu.executionMode = CPU::ExecutionMode::Native;
+	snes.cpu.update(0x20);
+	REQUIRE(snes.cpu._registers.a == 0xA2);
+	REQUIRE(snes.cpu._registers.x == 0x07);
+	REQUIRE(snes.cpu._registers.pc == 0x0107);
+}
+
+TEST_CASE("outdated blockCache", "[blockCache]")
+{
+	Init()
+	loadProgram(snes, selfModifyingProgram);
+	snes.cpu.executionMode = CPU::ExecutionMode::BlockCache;
+	snes.cpu._registers.pac = 0x000105;
+	snes.cpu._executeBlock();
+	REQUIRE(snes.cpu._registers.a == 0x07);
+	snes.bus.write(0x000105, 0xA2);
+	snes.cpu._registers.pac = 0x000105;
+	snes.cpu._executeBlock();
+	REQUIRE(snes.cpu._registers.x == 0x07);
+}
+
+TEST_CASE("differential blockCache", "[blockCache]")
+{
+	Init()
+	loadProgram(snes, loopProgram);
+	Differential::Differential checker(snes);
+	REQUIRE(snes.cpu.executionMode == CPU::ExecutionMode::Differential);
+	for (int i = 0; i < 50; i++)
+		snes.cpu.update(0x0C);
+	REQUIRE(snes.cpu._blockCache.size() > 0);
+	// Writing directly in the data is not tracked, the cached block now differs from the memory.
+	snes.cpu._registers.pac = 0x000107;
+	snes.cpu._executeBlock();
+	snes.wram._data[0x0107] = 0x98; // TYA
+	snes.cpu._registers.pac = 0x000107;
+	REQUIRE_THROWS_AS(snes.cpu._executeBlock(), InvalidAction);
+}
+
+TEST_CASE("differential stop blockCache", "[blockCache]")
+{
+	Init()
+	loadProgram(snes, loopProgram);
+	snes.cpu.executionMode = CPU::ExecutionMode::Native;
+	{
+		Differential::Differential checker(snes);
+	}
+	REQUIRE(snes.cpu.executionMode == CPU::ExecutionMode::Native);
+	snes.cpu.onBlockStart();
+	snes.cpu.onBlockEnd(0, 0);
+}
+
+TEST_CASE("inline native", "[blockCache]")
+{
+	Init()
+	loadProgram(snes, inlineProgram);
+	snes.cpu.executionMode = CPU::ExecutionMode::Native;
+	snes.cpu._registers.x = 0x00;
+	snes.cpu._registers.y = 0xFF;
+	snes.cpu._registers.p.x_b = true;
+	snes.cpu._updateDispatchTable();
+	// The SRAM is only 100 bytes long, the write throws out of the native code.
+	REQUIRE_THROWS_AS(snes.cpu._executeBlock(), InvalidAddress);
+	REQUIRE(snes.cpu._registers.x == 0x01);
+	REQUIRE(snes.cpu._registers.y == 0xFF);
+	REQUIRE(snes.cpu._registers.p.c);
+	REQUIRE_FALSE(snes.cpu._registers.p.d);
+	REQUIRE(snes.cpu._registers.pc == 0x010D);
+	REQUIRE(snes.cpu.instructionCount == 9);
+	snes.cpu._materializeNZ();
+	REQUIRE_FALSE(snes.cpu._registers.p.z);
+	REQUIRE_FALSE(snes.cpu._registers.p.n);
+
+	snes.cpu._registers.pac = 0x000103;
+	snes.cpu._registers.x = 0x0000;
+	snes.cpu._registers.y = 0xFFFF;
+	snes.cpu._isEmulationMode = false;
+	snes.cpu._registers.p.x_b = false;
+	snes.cpu._updateDispatchTable();
+	REQUIRE_THROWS_AS(snes.cpu._executeBlock(), InvalidAddress);
+	REQUIRE(snes.cpu._registers.x == 0x0001);
+	REQUIRE(snes.cpu._registers.y == 0xFFFF);
+	snes.cpu._registers.x = 0xFFFE;
+	snes.cpu._registers.pac = 0x000106;
+	REQUIRE_THROWS_AS(snes.cpu._executeBlock(), InvalidAddress);
+	REQUIRE(snes.cpu._registers.x == 0x0000);
+	snes.cpu._materializeNZ();
+	REQUIRE(snes.cpu._registers.p.z);
+	if constexpr (CPU::Recompiler::isSupported) {
+		unsigned flags = snes.cpu._registers.p.m | snes.cpu._registers.p.x_b << 1u | snes.cpu._isEmulationMode << 2u;
+		REQUIRE(snes.cpu._blockCache.find(CPU::BlockCache::getKey(0x000106, flags))->native);
+	}
+}
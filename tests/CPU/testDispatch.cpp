@@ -0,0 +1,92 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../tests.hpp"
+using namespace ComSquare;
+
+TEST_CASE("reset dispatch", "[dispatch]")
+{
+	Init()
+	REQUIRE((snes.cpu._dispatchTable->at(0x69) == &CPU::CPU::ADC<true>));
+	REQUIRE((snes.cpu._dispatchTable->at(0xE8) == &CPU::CPU::INX<true>));
+	REQUIRE((snes.cpu._dispatchTable->at(0xD0) == &CPU::CPU::BNE<true>));
+	REQUIRE((snes.cpu._dispatchTable->at(0xEA) == &CPU::CPU::NOP));
+}
+
+TEST_CASE("REP dispatch", "[dispatch]")
+{
+	Init()
+	snes.cpu._isEmulationMode = false;
+	snes.wram._data[0] = 0x20;
+	snes.cpu.REP(0x0, ComSquare::CPU::AddressingMode::Implied);
+	REQUIRE((snes.cpu._dispatchTable->at(0x69) == &CPU::CPU::ADC<false>));
+	REQUIRE((snes.cpu._dispatchTable->at(0xE8) == &CPU::CPU::INX<true>));
+	REQUIRE((snes.cpu._dispatchTable->at(0xD0) == &CPU::CPU::BNE<false>));
+}
+
+TEST_CASE("SEP dispatch", "[dispatch]")
+{
+	Init()
+	snes.cpu._isEmulationMode = false;
+	snes.cpu._registers.p.flags = 0;
+	snes.wram._data[0] = 0x10;
+	snes.cpu.SEP(0x0, ComSquare::CPU::AddressingMode::Implied);
+	REQUIRE((snes.cpu._dispatchTable->at(0xA9) == &CPU::CPU::LDA<false>));
+	REQUIRE((snes.cpu._dispatchTable->at(0xA2) == &CPU::CPU::LDX<true>));
+}
+
+TEST_CASE("XCE dispatch", "[dispatch]")
+{
+	Init()
+	snes.cpu._registers.p.c = false;
+	snes.cpu.XCE(0x0, ComSquare::CPU::AddressingMode::Implied);
+	REQUIRE((snes.cpu._dispatchTable->at(0x80) == &CPU::CPU::BRA<false>));
+	snes.cpu._registers.p.c = true;
+	snes.cpu.XCE(0x0, ComSquare::CPU::AddressingMode::Implied);
+	REQUIRE((snes.cpu._dispatchTable->at(0x80) == &CPU::CPU::BRA<true>));
+}
+
+TEST_CASE("execute dispatch", "[dispatch]")
+{
+	Init()
+	snes.cpu._isEmulationMode = false;
+	snes.cpu._registers.pac = 0x000000;
+	snes.wram._data[0] = 0xC2; // REP #$20
+	snes.wram._data[1] = 0x20;
+	snes.wram._data[2] = 0xA9; // LDA #$1234
+	snes.wram._data[3] = 0x34;
+	snes.wram._data[4] = 0x12;
+	snes.cpu.executeInstruction();
+	snes.cpu.executeInstruction();
+	REQUIRE(snes.cpu._registers.a == 0x1234);
+	REQUIRE(snes.cpu._registers.pc == 0x5);
+}
+
+TEST_CASE("names dispatch", "[dispatch]")
+{
+	REQUIRE(CPU::CPU::instructionNames[0x69] == "adc");
+	REQUIRE(CPU::CPU::instructionNames[0xFB] == "xce");
+	REQUIRE(CPU::CPU::instructions[0x69].addressingMode == CPU::AddressingMode::ImmediateForA);
+	REQUIRE(CPU::CPU::instructions[0x69].cycleCount == 2);
+}
+
+TEST_CASE("lazy flags dispatch", "[dispatch]")
+{
+	Init()
+	snes.cpu._isEmulationMode = false;
+	snes.cpu._registers.pac = 0x000000;
+	snes.cpu._registers.p.m = true;
+	snes.cpu._updateDispatchTable();
+	snes.wram._data[0] = 0xA9; // LDA #$00
+	snes.wram._data[1] = 0x00;
+	snes.wram._data[2] = 0xF0; // BEQ $05
+	snes.wram._data[3] = 0x01;
+	snes.cpu.executeInstruction();
+	REQUIRE(snes.cpu._hasLazyNZ);
+	snes.cpu.executeInstruction();
+	REQUIRE_FALSE(snes.cpu._hasLazyNZ);
+	REQUIRE(snes.cpu._registers.p.z);
+	REQUIRE(snes.cpu._registers.pc == 0x5);
+}
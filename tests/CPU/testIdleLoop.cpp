@@ -0,0 +1,109 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../tests.hpp"
+using namespace ComSquare;
+
+TEST_CASE("statusPolling idleLoop", "[idleLoop]")
+{
+	Init()
+	snes.cpu._registers.pac = 0x000100;
+	snes.wram._data[0x100] = 0xAD; // LDA $4212
+	snes.wram._data[0x101] = 0x12;
+	snes.wram._data[0x102] = 0x42;
+	snes.wram._data[0x103] = 0x10; // BPL $0100
+	snes.wram._data[0x104] = 0xFB;
+	REQUIRE(snes.cpu.update(100) >= 100);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedLoops == 1);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedCycles > 50);
+	// HVBJOY also reports the hblank, the skip stops at its start.
+	REQUIRE(snes.scheduler.isInHBlank());
+	REQUIRE(snes.scheduler.getVCounter() == 0);
+	REQUIRE(snes.cpu._registers.pc == 0x100);
+}
+
+TEST_CASE("nmiPolling idleLoop", "[idleLoop]")
+{
+	Init()
+	snes.cpu._registers.pac = 0x000100;
+	snes.wram._data[0x100] = 0xAD; // LDA $4210
+	snes.wram._data[0x101] = 0x10;
+	snes.wram._data[0x102] = 0x42;
+	snes.wram._data[0x103] = 0x10; // BPL $0100
+	snes.wram._data[0x104] = 0xFB;
+	uint64_t vblank = snes.scheduler.getEventTimestamp(Scheduler::VBlank);
+	// The CPU is run by small slices, like in SNES::runFrame.
+	for (int i = 0; i < 10 && snes.cpu.idleLoopStatistics.skippedLoops == 0; i++)
+		snes.cpu.update(0x0C);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedLoops == 1);
+	REQUIRE(snes.scheduler.getTimestamp() >= vblank);
+	REQUIRE(snes.scheduler.getTimestamp() < vblank + Scheduler::Scheduler::masterCyclesPerCPUCycle);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedCycles * Scheduler::Scheduler::masterCyclesPerCPUCycle > vblank - 120 * Scheduler::Scheduler::masterCyclesPerCPUCycle);
+	REQUIRE(snes.cpu._internalRegisters.rdnmi & 0x80u);
+	REQUIRE(snes.cpu._registers.pc == 0x100);
+}
+
+TEST_CASE("apuPolling idleLoop", "[idleLoop]")
+{
+	Init()
+	snes.cpu._registers.pac = 0x000100;
+	snes.wram._data[0x100] = 0xAD; // LDA $2140
+	snes.wram._data[0x101] = 0x40;
+	snes.wram._data[0x102] = 0x21;
+	snes.wram._data[0x103] = 0xF0; // BEQ $0100
+	snes.wram._data[0x104] = 0xFB;
+	// The APU can answer at any time, the skip stops at the end of the update.
+	REQUIRE(snes.cpu.update(100) == 100);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedLoops == 1);
+}
+
+TEST_CASE("branchToSelf idleLoop", "[idleLoop]")
+{
+	Init()
+	snes.cpu._registers.pac = 0x000100;
+	snes.wram._data[0x100] = 0x80; // BRA $0100
+	snes.wram._data[0x101] = 0xFE;
+	uint64_t vblank = snes.scheduler.getEventTimestamp(Scheduler::VBlank);
+	REQUIRE(snes.cpu.update(100) > 100);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedLoops == 1);
+	REQUIRE(snes.scheduler.getTimestamp() >= vblank);
+	REQUIRE(snes.cpu._registers.pc == 0x100);
+}
+
+TEST_CASE("counter idleLoop", "[idleLoop]")
+{
+	Init()
+	snes.cpu._registers.pac = 0x000100;
+	snes.wram._data[0x100] = 0xE8; // INX
+	snes.wram._data[0x101] = 0x80; // BRA $0100
+	snes.wram._data[0x102] = 0xFD;
+	snes.cpu.update(100);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedLoops == 0);
+	REQUIRE(snes.cpu._registers.x != 0);
+}
+
+TEST_CASE("wramPolling idleLoop", "[idleLoop]")
+{
+	Init()
+	snes.cpu._registers.pac = 0x000100;
+	snes.wram._data[0x100] = 0xAD; // LDA $0010
+	snes.wram._data[0x101] = 0x10;
+	snes.wram._data[0x102] = 0x00;
+	snes.wram._data[0x103] = 0xF0; // BEQ $0100
+	snes.wram._data[0x104] = 0xFB;
+	snes.cpu.update(100);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedLoops == 0);
+}
+
+TEST_CASE("disabled idleLoop", "[idleLoop]")
+{
+	Init()
+	snes.cpu.isIdleLoopSkippingEnabled = false;
+	snes.cpu._registers.pac = 0x000100;
+	snes.wram._data[0x100] = 0x80; // BRA $0100
+	snes.wram._data[0x101] = 0xFE;
+	snes.cpu.update(100);
+	REQUIRE(snes.cpu.idleLoopStatistics.skippedLoops == 0);
+}
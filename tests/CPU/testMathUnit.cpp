@@ -0,0 +1,59 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../tests.hpp"
+using namespace ComSquare;
+
+TEST_CASE("multiply MathUnit", "[MathUnit]")
+{
+	Init()
+	snes.bus.write(0x4202, 0xFE);
+	snes.bus.write(0x4203, 0x12);
+	snes.cpu._advanceClock(CPU::CPU::_multiplyCycles);
+	REQUIRE(snes.bus.read(0x4216) == 0xDC);
+	REQUIRE(snes.bus.read(0x4217) == 0x11);
+	REQUIRE(snes.bus.read(0x4214) == 0x12);
+	REQUIRE(snes.bus.read(0x4215) == 0x00);
+}
+
+TEST_CASE("divide MathUnit", "[MathUnit]")
+{
+	Init()
+	snes.bus.write(0x4204, 0x39);
+	snes.bus.write(0x4205, 0x30);
+	snes.bus.write(0x4206, 0x10);
+	snes.cpu._advanceClock(CPU::CPU::_divideCycles);
+	REQUIRE(snes.bus.read(0x4214) == 0x03);
+	REQUIRE(snes.bus.read(0x4215) == 0x03);
+	REQUIRE(snes.bus.read(0x4216) == 0x09);
+	REQUIRE(snes.bus.read(0x4217) == 0x00);
+}
+
+TEST_CASE("divideByZero MathUnit", "[MathUnit]")
+{
+	Init()
+	snes.bus.write(0x4204, 0x34);
+	snes.bus.write(0x4205, 0x12);
+	snes.bus.write(0x4206, 0x00);
+	snes.cpu._advanceClock(CPU::CPU::_divideCycles);
+	REQUIRE(snes.bus.read(0x4214) == 0xFF);
+	REQUIRE(snes.bus.read(0x4215) == 0xFF);
+	REQUIRE(snes.bus.read(0x4216) == 0x34);
+	REQUIRE(snes.bus.read(0x4217) == 0x12);
+}
+
+TEST_CASE("delay MathUnit", "[MathUnit]")
+{
+	Init()
+	snes.bus.write(0x4202, 0x02);
+	snes.bus.write(0x4203, 0x03);
+	snes.cpu._advanceClock(CPU::CPU::_multiplyCycles);
+	REQUIRE(snes.bus.read(0x4216) == 0x06);
+	snes.bus.write(0x4203, 0x04);
+	snes.cpu._advanceClock(CPU::CPU::_multiplyCycles - 1);
+	REQUIRE(snes.bus.read(0x4216) == 0x06);
+	snes.cpu._advanceClock(1);
+	REQUIRE(snes.bus.read(0x4216) == 0x08);
+}
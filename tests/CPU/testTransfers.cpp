@@ -3,6 +3,7 @@
 //
 
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <iostream>
 #include <bitset>
 #include "../tests.hpp"
@@ -473,4 +474,24 @@ TEST_CASE("hardCase MVP", "[MVP]")
 	REQUIRE(snes.cpu._registers.y == 0x0FFF);
 	for (int i = 0; i < 0x11; i++)
 		REQUIRE(snes.wram._data[i + 0x1000] == i);
-}
\ No newline at end of file
+}
+TEST_CASE("dispatch MVN", "[MVN]")
+{
+	Init()
+	// MVN $7E,$00 (the destination bank comes first)
+	const uint8_t program[] = {0x54, 0x7E, 0x00};
+	std::copy(std::begin(program), std::end(program), snes.wram._data.begin() + 0x100);
+	snes.cpu._registers.pac = 0x000100;
+	snes.cpu._registers.a = 0x3;
+	snes.cpu._registers.x = 0x0200;
+	snes.cpu._registers.y = 0x0300;
+	for (int i = 0; i < 4; i++)
+		snes.wram._data[0x200 + i] = 0xA0 + i;
+
+	snes.cpu.executeInstruction();
+	REQUIRE(snes.cpu._registers.pc == 0x0103);
+	REQUIRE(snes.cpu._registers.dbr == 0x7E);
+	REQUIRE(snes.cpu._registers.a == 0xFFFF);
+	for (int i = 0; i < 4; i++)
+		REQUIRE(snes.wram._data[0x300 + i] == 0xA0 + i);
+}
@@ -0,0 +1,57 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <vector>
+#include "tests.hpp"
+#include "Headless/BatchRunner.hpp"
+using namespace ComSquare;
+
+//! @brief Write a LoRom that loops forever and return its path.
+static std::string createLoopRom()
+{
+	std::vector<char> rom(0x8000);
+	// SEI; BRA $8001
+	rom[0x0000] = 0x78;
+	rom[0x0001] = static_cast<char>(0x80);
+	rom[0x0002] = static_cast<char>(0xFE);
+	// The emulation mode reset vector of the header at $7FC0.
+	rom[0x7FFC] = 0x00;
+	rom[0x7FFD] = static_cast<char>(0x80);
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "comsquare_batch_runner.sfc";
+	std::ofstream file(path, std::ios::binary);
+	file.write(rom.data(), rom.size());
+	return path.string();
+}
+
+TEST_CASE("run BatchRunner", "[BatchRunner]")
+{
+	std::string rom = createLoopRom();
+	Headless::BatchRunner runner(5, 2);
+	std::vector<Headless::RomResult> results = runner.run({rom, "/nonexistent/rom.sfc", rom});
+
+	REQUIRE(runner.getThreadCount() == 2);
+	REQUIRE(results.size() == 3);
+	for (int i : {0, 2}) {
+		REQUIRE(results[i].path == rom);
+		REQUIRE(results[i].error.empty());
+		REQUIRE(results[i].frames == 5);
+		REQUIRE(results[i].instructions > 0);
+		REQUIRE(results[i].getFramesPerSecond() > 0);
+	}
+	REQUIRE(results[0].instructions == results[2].instructions);
+	REQUIRE_FALSE(results[1].error.empty());
+	REQUIRE(results[1].frames == 0);
+	std::filesystem::remove(rom);
+}
+
+TEST_CASE("defaultThreads BatchRunner", "[BatchRunner]")
+{
+	Headless::BatchRunner runner(1);
+
+	REQUIRE(runner.getThreadCount() >= 1);
+	REQUIRE(runner.run({}).empty());
+}
@@ -0,0 +1,111 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <vector>
+#include "tests.hpp"
+#include "Headless/BatchRunner.hpp"
+#include "Exceptions/InvalidGoldenFile.hpp"
+using namespace ComSquare;
+
+TEST_CASE("saveLoad GoldenFile", "[GoldenFile]")
+{
+	std::string path = (std::filesystem::temp_directory_path() / "comsquare_golden.golden").string();
+	Headless::GoldenFile golden({{0x1, 0x2}, {0xFFFFFFFFFFFFFFFF, 0x0}, {0x123456789ABCDEF, 0x42}});
+	golden.save(path);
+
+	Headless::GoldenFile loaded = Headless::GoldenFile::load(path);
+	REQUIRE(loaded.getFrames() == golden.getFrames());
+	REQUIRE_FALSE(loaded.compare(golden.getFrames()).has_value());
+	std::filesystem::remove(path);
+	REQUIRE_THROWS_AS(Headless::GoldenFile::load(path), InvalidGoldenFile);
+}
+
+TEST_CASE("compare GoldenFile", "[GoldenFile]")
+{
+	Headless::GoldenFile golden({{1, 1}, {2, 2}, {3, 3}});
+
+	auto divergence = golden.compare({{1, 1}, {2, 5}, {4, 3}});
+	REQUIRE(divergence.has_value());
+	REQUIRE(divergence->frame == 1);
+	REQUIRE(divergence->component == "audio");
+	divergence = golden.compare({{1, 1}, {2, 2}, {4, 3}});
+	REQUIRE(divergence->frame == 2);
+	REQUIRE(divergence->component == "video");
+	divergence = golden.compare({{1, 1}, {2, 2}});
+	REQUIRE(divergence->frame == 2);
+	REQUIRE(divergence->component == "length");
+}
+
+TEST_CASE("invalid GoldenFile", "[GoldenFile]")
+{
+	std::string path = (std::filesystem::temp_directory_path() / "comsquare_invalid.golden").string();
+	{
+		std::ofstream file(path);
+		file << Headless::GoldenFile::magic << "\n0 1 2\n2 3 4\n";
+	}
+	REQUIRE_THROWS_AS(Headless::GoldenFile::load(path), InvalidGoldenFile);
+	{
+		std::ofstream file(path);
+		file << "0 1 2\n";
+	}
+	REQUIRE_THROWS_AS(Headless::GoldenFile::load(path), InvalidGoldenFile);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("apply InputScript", "[GoldenFile]")
+{
+	Init()
+	std::string path = (std::filesystem::temp_directory_path() / "comsquare_inputs.txt").string();
+	{
+		std::ofstream file(path);
+		file << "# frame port buttons\n"
+		        "\n"
+		        "2 0 0x8000 # B\n"
+		        "0 1 12\n";
+	}
+	Headless::InputScript script = Headless::InputScript::load(path);
+	REQUIRE(script.size() == 2);
+
+	script.apply(snes, 1);
+	REQUIRE(snes.cpu._internalRegisters.joy1h == 0);
+	script.apply(snes, 0);
+	REQUIRE(snes.cpu._internalRegisters.joy2l == 12);
+	script.apply(snes, 2);
+	REQUIRE(snes.cpu._internalRegisters.joy1h == 0x80);
+
+	{
+		std::ofstream file(path);
+		file << "2 4 0x8000\n";
+	}
+	REQUIRE_THROWS_AS(Headless::InputScript::load(path), InvalidGoldenFile);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("hash BatchRunner", "[GoldenFile]")
+{
+	std::vector<char> rom(0x8000);
+	// SEI; BRA $8001
+	rom[0x0000] = 0x78;
+	rom[0x0001] = static_cast<char>(0x80);
+	rom[0x0002] = static_cast<char>(0xFE);
+	rom[0x7FFC] = 0x00;
+	rom[0x7FFD] = static_cast<char>(0x80);
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "comsquare_hash.sfc";
+	{
+		std::ofstream file(path, std::ios::binary);
+		file.write(rom.data(), rom.size());
+	}
+
+	Headless::BatchRunner runner(3, 2);
+	REQUIRE(runner.run({path.string()})[0].hashes.empty());
+	runner.setHashing(true);
+	std::vector<Headless::RomResult> results = runner.run({path.string(), path.string()});
+	REQUIRE(results[0].error.empty());
+	REQUIRE(results[0].hashes.size() == 3);
+	REQUIRE(results[0].hashes == results[1].hashes);
+	REQUIRE_FALSE(Headless::GoldenFile(results[0].hashes).compare(results[1].hashes).has_value());
+	std::filesystem::remove(path);
+}
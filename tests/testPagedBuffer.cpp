@@ -0,0 +1,72 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <vector>
+#include "tests.hpp"
+using namespace ComSquare;
+
+TEST_CASE("copyOnWrite PagedBuffer", "[PagedBuffer]")
+{
+	Ram::PagedBuffer buffer(0x3000);
+	buffer.write(0x10, 0x42);
+	Ram::PagedBuffer copy = buffer;
+
+	REQUIRE(copy.read(0x10) == 0x42);
+	REQUIRE(buffer.getSharedPageCount() == 3);
+	copy.write(0x1010, 0x24);
+	REQUIRE(copy.read(0x1010) == 0x24);
+	REQUIRE(buffer.read(0x1010) == 0x00);
+	REQUIRE(buffer.getSharedPageCount() == 2);
+	REQUIRE(copy.getOwnedBytes() == Ram::PagedBuffer::pageSize);
+	buffer.write(0x10, 0x00);
+	REQUIRE(copy.read(0x10) == 0x42);
+	REQUIRE(buffer.getSharedPageCount() == 1);
+}
+
+TEST_CASE("constRead PagedBuffer", "[PagedBuffer]")
+{
+	Ram::PagedBuffer buffer(0x1000);
+	Ram::PagedBuffer copy = buffer;
+	const Ram::PagedBuffer &constCopy = copy;
+
+	REQUIRE(constCopy[0x20] == 0);
+	REQUIRE(copy.read(0x20) == 0);
+	REQUIRE(buffer.getSharedPageCount() == 1);
+	copy[0x20] = 1;
+	REQUIRE(buffer.getSharedPageCount() == 0);
+	REQUIRE(buffer[0x20] == 0);
+}
+
+TEST_CASE("copy PagedBuffer", "[PagedBuffer]")
+{
+	Ram::PagedBuffer buffer(0x2100);
+	std::vector<uint8_t> data(0x1800);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = i;
+
+	buffer.copyFrom(0x800, data);
+	REQUIRE(buffer.read(0x800) == 0x00);
+	REQUIRE(buffer.read(0x1FFF) == 0xFF);
+	std::vector<uint8_t> output(data.size());
+	buffer.copyTo(0x800, output);
+	REQUIRE(output == data);
+	REQUIRE(buffer.getPageCount() == 3);
+	REQUIRE(buffer.getPage(2).size() == 0x100);
+}
+
+TEST_CASE("resize PagedBuffer", "[PagedBuffer]")
+{
+	Ram::PagedBuffer buffer(0x1800);
+	buffer.write(0x17FF, 0xFF);
+	buffer.resize(0x100);
+	REQUIRE(buffer.size() == 0x100);
+	buffer.resize(0x1800);
+	REQUIRE(buffer.read(0x17FF) == 0x00);
+
+	std::fill(buffer.begin(), buffer.end(), 0x11);
+	REQUIRE(buffer.read(0x0000) == 0x11);
+	REQUIRE(buffer.read(0x17FF) == 0x11);
+}
@@ -0,0 +1,70 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "tests.hpp"
+#include "Headless/RomGenerator.hpp"
+#include "Exceptions/InvalidAction.hpp"
+#include "Renderer/NoRenderer.hpp"
+using namespace ComSquare;
+
+//! @brief Write a synthetic rom and load it in a new console.
+static std::unique_ptr<SNES> loadSynthetic(const Headless::RomGenerator &generator, Renderer::IRenderer &renderer)
+{
+	std::string path = (std::filesystem::temp_directory_path() / "comsquare_synthetic.sfc").string();
+	generator.write(path);
+	auto snes = std::make_unique<SNES>(path, renderer);
+	std::filesystem::remove(path);
+	return snes;
+}
+
+TEST_CASE("header RomGenerator", "[RomGenerator]")
+{
+	Renderer::NoRenderer renderer(0, 0, 0);
+	auto snes = loadSynthetic(Headless::RomGenerator("TEST ROM"), renderer);
+
+	REQUIRE(snes->cartridge.getType() == Cartridge::Game);
+	REQUIRE(snes->cartridge.header.mappingMode & Cartridge::LoRom);
+	REQUIRE(snes->cartridge.header.gameName == "TEST ROM             ");
+	REQUIRE(snes->cartridge.header.emulationInterrupts.reset == 0x8000);
+	REQUIRE(snes->cartridge.header.checksum + snes->cartridge.header.checksumComplement == 0xFFFF);
+	uint16_t sum = 0;
+	for (uint8_t byte : Headless::RomGenerator("TEST ROM").generate())
+		sum += byte;
+	REQUIRE(sum == snes->cartridge.header.checksum);
+}
+
+TEST_CASE("workloads RomGenerator", "[RomGenerator]")
+{
+	Renderer::NoRenderer renderer(0, 0, 0);
+	Headless::RomGenerator generator;
+	for (const char *name : {"addressing", "arithmetic", "blockmove", "subroutines", "dma"})
+		generator.add(Headless::RomGenerator::parseWorkload(name), 2);
+	auto snes = loadSynthetic(generator, renderer);
+
+	for (int i = 0; i < 2000; i++)
+		snes->cpu.update(0x0C);
+	REQUIRE(snes->cpu.instructionCount > 1000);
+	REQUIRE_FALSE(snes->cpu._isEmulationMode);
+	// The subroutines pull everything they push, the stack never grows past their deepest call.
+	REQUIRE(snes->cpu._registers.s >= 0x1EE0);
+	REQUIRE(snes->cpu._registers.s <= 0x1EFF);
+	// The MVN copied $1000-$10FF to $1100-$11FF, which the MVP copied to $1200-$12FF.
+	for (int i = 0; i < 0x100; i++) {
+		REQUIRE(snes->wram._data[0x1100 + i] == snes->wram._data[0x1000 + i]);
+		REQUIRE(snes->wram._data[0x1200 + i] == snes->wram._data[0x1100 + i]);
+	}
+}
+
+TEST_CASE("invalid RomGenerator", "[RomGenerator]")
+{
+	Headless::RomGenerator generator;
+
+	REQUIRE_THROWS_AS(Headless::RomGenerator::parseWorkload("nothing"), InvalidAction);
+	REQUIRE_THROWS_AS(generator.add(Headless::Workload::Arithmetic16, 0), InvalidAction);
+	for (int i = 0; i < 1000; i++)
+		generator.add(Headless::Workload::AddressingModes);
+	REQUIRE_THROWS_AS(generator.generate(), InvalidAction);
+}
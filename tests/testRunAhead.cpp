@@ -0,0 +1,130 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <fstream>
+#include "tests.hpp"
+#include "RunAhead/RunAhead.hpp"
+using namespace ComSquare;
+
+//! @brief Create a console running a loop that copies the first controller port to the WRAM every instruction.
+static std::unique_ptr<SNES> createSnes(Renderer::IRenderer &renderer)
+{
+	auto snes = std::make_unique<SNES>(renderer);
+	snes->cartridge._data.resize(100);
+	snes->cartridge.header.mappingMode = Cartridge::LoRom;
+	snes->sram._data.resize(100);
+	snes->bus.mapComponents(*snes);
+	snes->cpu._registers.pac = 0x000100;
+	const uint8_t program[] = {
+		0xE8,             // INX
+		0x8E, 0x10, 0x00, // STX $0010
+		0xAD, 0x18, 0x42, // LDA $4218
+		0x8D, 0x12, 0x00, // STA $0012
+		0x80, 0xF4,       // BRA $0100
+	};
+	std::copy(std::begin(program), std::end(program), snes->wram._data.begin() + 0x100);
+	return snes;
+}
+
+//! @brief Check that two consoles are in the same state.
+static bool isSameState(const SNES &a, const SNES &b)
+{
+	SaveState::SaveState stateA;
+	SaveState::SaveState stateB;
+
+	a.saveState(stateA);
+	b.saveState(stateB);
+	return std::ranges::equal(stateA.getData(), stateB.getData());
+}
+
+TEST_CASE("runFrame SNES", "[RunAhead]")
+{
+	Renderer::NoRenderer renderer(0, 0, 0);
+	auto snes = createSnes(renderer);
+
+	snes->runFrame(false);
+	REQUIRE(snes->scheduler.getFrame() == 1);
+	REQUIRE(snes->scheduler.getVCounter() == 0);
+	snes->runFrame(false);
+	REQUIRE(snes->scheduler.getFrame() == 2);
+}
+
+TEST_CASE("runFrame SPC", "[RunAhead]")
+{
+	std::vector<char> spc(0x10200);
+	const std::string_view magic = Cartridge::Cartridge::_magicSPC;
+	std::copy(magic.begin(), magic.end(), spc.begin());
+	spc[0x21] = 0x1A;
+	spc[0x22] = 0x1A;
+	spc[0x23] = 0x1A;
+	spc[0x24] = 0x1E;
+	// The SPC700 starts at $0200, on a BRA $0200.
+	spc[0x26] = 0x02;
+	spc[0x100 + 0x200] = 0x2F;
+	spc[0x100 + 0x201] = static_cast<char>(0xFE);
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "comsquare_run_frame.spc";
+	std::ofstream(path, std::ios::binary).write(spc.data(), spc.size());
+
+	Renderer::NoRenderer renderer(0, 0, 0);
+	auto snes = std::make_unique<SNES>(path.string(), renderer);
+	REQUIRE(snes->cartridge.getType() == Cartridge::Audio);
+	snes->runFrame(false);
+	// A frame lasts for 17038.7 cycles of the SPC700 and the DSP renders a stereo sample every 32 cycles.
+	REQUIRE(snes->scheduler.getFrame() == 1);
+	REQUIRE(snes->apu.getDSP().getSamplesCount() / 2 >= 530);
+	REQUIRE(snes->apu.getDSP().getSamplesCount() / 2 <= 536);
+}
+
+TEST_CASE("singleInstance RunAhead", "[RunAhead]")
+{
+	Renderer::NoRenderer renderer(0, 0, 0);
+	auto expected = createSnes(renderer);
+	auto snes = createSnes(renderer);
+	RunAhead::RunAhead runAhead(*snes, 2);
+
+	runAhead.setInput(0, 0x8001);
+	expected->cpu.setJoypad(0, 0x8001);
+	for (int i = 0; i < 3; i++) {
+		runAhead.runFrame();
+		expected->runFrame(false);
+		REQUIRE(isSameState(*snes, *expected));
+	}
+	REQUIRE(snes->scheduler.getFrame() == 3);
+	REQUIRE(snes->wram._data[0x12] == 0x01);
+	REQUIRE_FALSE(snes->apu._dsp.isMuted);
+}
+
+TEST_CASE("secondInstance RunAhead", "[RunAhead]")
+{
+	Renderer::NoRenderer renderer(0, 0, 0);
+	auto expected = createSnes(renderer);
+	auto snes = createSnes(renderer);
+	auto ahead = createSnes(renderer);
+	SNES &aheadRef = *ahead;
+	RunAhead::RunAhead runAhead(*snes, 2, std::move(ahead));
+
+	REQUIRE(aheadRef.apu._dsp.isMuted);
+	for (int i = 0; i < 3; i++) {
+		runAhead.setInput(0, i);
+		expected->cpu.setJoypad(0, i);
+		runAhead.runFrame();
+		expected->runFrame(false);
+		REQUIRE(isSameState(*snes, *expected));
+	}
+	// The second instance ran from the state of the second frame, with the input of the third one, up to 2 frames after the main console.
+	REQUIRE(aheadRef.scheduler.getFrame() == 5);
+	REQUIRE(aheadRef.wram._data[0x12] == 2);
+}
+
+TEST_CASE("disabled RunAhead", "[RunAhead]")
+{
+	Renderer::NoRenderer renderer(0, 0, 0);
+	auto snes = createSnes(renderer);
+	RunAhead::RunAhead runAhead(*snes, 0);
+
+	runAhead.runFrame();
+	REQUIRE(snes->scheduler.getFrame() == 1);
+}
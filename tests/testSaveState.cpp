@@ -0,0 +1,237 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include "tests.hpp"
+#include "SaveState/Rewind.hpp"
+using namespace ComSquare;
+
+//! @brief Run the CPU and the APU without rendering anything.
+static void run(SNES &snes, unsigned updates)
+{
+	for (unsigned i = 0; i < updates; i++) {
+		snes.cpu.update(0x0C);
+		snes.apu.sync();
+	}
+}
+
+//! @brief Load a loop that increments X and writes to the WRAM.
+static void loadProgram(SNES &snes)
+{
+	snes.cpu._registers.pac = 0x000100;
+	const uint8_t program[] = {
+		0xE8,             // INX
+		0x8E, 0x10, 0x00, // STX $0010
+		0xEE, 0x11, 0x00, // INC $0011
+		0x80, 0xF7,       // BRA $0100
+	};
+	std::copy(std::begin(program), std::end(program), snes.wram._data.begin() + 0x100);
+}
+
+TEST_CASE("roundTrip SaveState", "[SaveState]")
+{
+	Init()
+	loadProgram(snes);
+	SaveState::SaveState start;
+	SaveState::SaveState expected;
+	SaveState::SaveState result;
+
+	run(snes, 100);
+	snes.saveState(start);
+	run(snes, 1000);
+	snes.saveState(expected);
+	snes.loadState(start);
+	REQUIRE(snes.cpu._registers.x != 0);
+	run(snes, 1000);
+	snes.saveState(result);
+	REQUIRE(result.getSize() == expected.getSize());
+	REQUIRE(std::ranges::equal(result.getData(), expected.getData()));
+}
+
+TEST_CASE("restore SaveState", "[SaveState]")
+{
+	Init()
+	loadProgram(snes);
+	SaveState::SaveState state;
+
+	run(snes, 100);
+	snes.saveState(state);
+	uint16_t x = snes.cpu._registers.x;
+	uint8_t counter = snes.wram._data[0x11];
+	uint64_t timestamp = snes.scheduler.getTimestamp();
+	run(snes, 100);
+	snes.loadState(state);
+	REQUIRE(snes.cpu._registers.x == x);
+	REQUIRE(snes.wram._data[0x11] == counter);
+	REQUIRE(snes.scheduler.getTimestamp() == timestamp);
+}
+
+TEST_CASE("invalid SaveState", "[SaveState]")
+{
+	Init()
+	SaveState::SaveState state;
+	snes.saveState(state);
+
+	std::vector<uint8_t> image(state.getData().begin(), state.getData().end());
+	std::span<const uint8_t> view = image;
+	SaveState::SaveState truncated(view.first(image.size() - 1));
+	REQUIRE_THROWS_AS(snes.loadState(truncated), InvalidSaveState);
+
+	image[0] = 'X';
+	SaveState::SaveState corrupted(image);
+	REQUIRE_THROWS_AS(snes.loadState(corrupted), InvalidSaveState);
+
+	snes.cartridge.header.checksum++;
+	REQUIRE_THROWS_AS(snes.loadState(state), InvalidSaveState);
+}
+
+//! @brief Run the program and push a frame to the rewind buffer after each step.
+//! @return The images pushed.
+static std::vector<std::vector<uint8_t>> pushFrames(SNES &snes, SaveState::Rewind &rewind, unsigned count)
+{
+	std::vector<std::vector<uint8_t>> images;
+	SaveState::SaveState state;
+
+	for (unsigned i = 0; i < count; i++) {
+		run(snes, 50);
+		snes.saveState(state);
+		images.emplace_back(state.getData().begin(), state.getData().end());
+		rewind.push(state);
+	}
+	return images;
+}
+
+TEST_CASE("pop Rewind", "[Rewind]")
+{
+	Init()
+	loadProgram(snes);
+	SaveState::Rewind rewind(1 << 24, 4);
+	SaveState::SaveState state;
+
+	auto images = pushFrames(snes, rewind, 10);
+	REQUIRE(rewind.size() == 10);
+	REQUIRE(rewind.getStatistics().keyframes == 3);
+	for (auto it = images.rbegin(); it != images.rend(); it++) {
+		REQUIRE(rewind.pop(state));
+		REQUIRE(std::ranges::equal(state.getData(), *it));
+	}
+	REQUIRE_FALSE(rewind.pop(state));
+}
+
+TEST_CASE("pushAfterPop Rewind", "[Rewind]")
+{
+	Init()
+	loadProgram(snes);
+	SaveState::Rewind rewind(1 << 24, 4);
+	SaveState::SaveState state;
+
+	auto images = pushFrames(snes, rewind, 6);
+	REQUIRE(rewind.pop(state));
+	REQUIRE(rewind.pop(state));
+	REQUIRE(rewind.pop(state));
+	snes.loadState(state);
+	images.resize(3);
+	auto newImages = pushFrames(snes, rewind, 3);
+	images.insert(images.end(), newImages.begin(), newImages.end());
+	for (auto it = images.rbegin(); it != images.rend(); it++) {
+		REQUIRE(rewind.pop(state));
+		REQUIRE(std::ranges::equal(state.getData(), *it));
+	}
+}
+
+TEST_CASE("capacity Rewind", "[Rewind]")
+{
+	Init()
+	loadProgram(snes);
+	SaveState::Rewind rewind(0, 5);
+	pushFrames(snes, rewind, 1);
+	size_t keyframeSize = rewind.getStatistics().usedBytes;
+
+	SaveState::Rewind limited(keyframeSize * 3, 5);
+	SaveState::SaveState state;
+	auto images = pushFrames(snes, limited, 50);
+	SaveState::RewindStatistics statistics = limited.getStatistics();
+	REQUIRE(statistics.usedBytes <= statistics.capacity);
+	REQUIRE(statistics.frames < 50);
+	REQUIRE(statistics.frames >= 5);
+	REQUIRE(statistics.averagePushTime.count() > 0);
+	REQUIRE(statistics.averageCompressionTime.count() > 0);
+	for (size_t i = 0; i < statistics.frames; i++) {
+		REQUIRE(limited.pop(state));
+		REQUIRE(std::ranges::equal(state.getData(), images[images.size() - 1 - i]));
+	}
+	REQUIRE_FALSE(limited.pop(state));
+}
+
+//! @brief Sum the bytes of the memories of a console that are not shared with another console.
+static size_t getOwnedBytes(const SNES &snes)
+{
+	return snes.cartridge.getPages().getOwnedBytes()
+		+ snes.wram.getPages().getOwnedBytes()
+		+ snes.sram.getPages().getOwnedBytes()
+		+ snes.ppu.vram.getPages().getOwnedBytes()
+		+ snes.ppu.oamram.getPages().getOwnedBytes()
+		+ snes.ppu.cgram.getPages().getOwnedBytes();
+}
+
+TEST_CASE("state Clone", "[Clone]")
+{
+	Init()
+	snes.cartridge._data.resize(0x8000);
+	loadProgram(snes);
+	run(snes, 100);
+	auto clone = snes.clone(norenderer);
+	SaveState::SaveState expected;
+	SaveState::SaveState result;
+
+	snes.saveState(expected);
+	clone->saveState(result);
+	REQUIRE(std::ranges::equal(result.getData(), expected.getData()));
+	REQUIRE(getOwnedBytes(*clone) == 0);
+	REQUIRE(clone->cartridge.getPages().getSharedPageCount() == clone->cartridge.getPages().getPageCount());
+
+	run(snes, 1000);
+	run(*clone, 1000);
+	snes.saveState(expected);
+	clone->saveState(result);
+	REQUIRE(std::ranges::equal(result.getData(), expected.getData()));
+}
+
+TEST_CASE("copyOnWrite Clone", "[Clone]")
+{
+	Init()
+	loadProgram(snes);
+	run(snes, 100);
+	uint16_t x = snes.cpu._registers.x;
+	auto clone = snes.clone(norenderer);
+
+	run(*clone, 1000);
+	REQUIRE(snes.cpu._registers.x == x);
+	REQUIRE(snes.wram._data[0x10] == static_cast<uint8_t>(x));
+	REQUIRE(clone->wram._data[0x10] != snes.wram._data[0x10]);
+	// Only the page of the WRAM written by the program has been copied (the APU also writes to its own ram).
+	REQUIRE(clone->wram.getPages().getOwnedBytes() == Ram::PagedBuffer::pageSize);
+	REQUIRE(clone->ppu.vram.getPages().getOwnedBytes() == 0);
+	REQUIRE(getOwnedBytes(*clone) <= 3 * Ram::PagedBuffer::pageSize);
+}
+
+TEST_CASE("audioRam Clone", "[Clone]")
+{
+	Init()
+	snes.apu._map.ram[0x1234] = 0x56;
+	auto clone = snes.clone(norenderer);
+	REQUIRE(clone->apu._map.ram.read(0x1234) == 0x56);
+	REQUIRE(clone->apu._map.ram._pages.getOwnedBytes() == 0);
+
+	clone->apu._map.ram.write(0x1234, 0x78);
+	snes.apu._map.ram.write(0x5678, 0x9A);
+	snes.cloneTo(*clone);
+	REQUIRE(clone->apu._map.ram.read(0x1234) == 0x56);
+	REQUIRE(clone->apu._map.ram.read(0x5678) == 0x9A);
+	// The page written by the console has been copied once, then shared with the clone.
+	REQUIRE(snes.apu._map.ram._pages.getOwnedBytes() == 0);
+	REQUIRE(clone->apu._map.ram._pages.getSharedPageCount() == clone->apu._map.ram._pages.getPageCount());
+	REQUIRE(clone->apu._map.ram == snes.apu._map.ram);
+}
@@ -0,0 +1,111 @@
+//
+// Created by agent on 10/19/26.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "tests.hpp"
+using namespace ComSquare;
+
+TEST_CASE("counters Scheduler", "[Scheduler]")
+{
+	Scheduler::Scheduler scheduler;
+	scheduler.advance(Scheduler::Scheduler::masterCyclesPerLine * 10 + 40);
+	REQUIRE(scheduler.getVCounter() == 10);
+	REQUIRE(scheduler.getHCounter() == 10);
+	REQUIRE(scheduler.getFrame() == 0);
+	scheduler.advance(Scheduler::Scheduler::masterCyclesPerFrame);
+	REQUIRE(scheduler.getVCounter() == 10);
+	REQUIRE(scheduler.getFrame() == 1);
+}
+
+TEST_CASE("events Scheduler", "[Scheduler]")
+{
+	Scheduler::Scheduler scheduler;
+	REQUIRE(scheduler.getNextEventTimestamp() == Scheduler::Scheduler::never);
+	scheduler.schedule(Scheduler::TimerIRQ, 100);
+	scheduler.schedule(Scheduler::VBlank, 50);
+	REQUIRE(scheduler.getNextEventTimestamp() == 50);
+	scheduler.advance(60);
+	REQUIRE(scheduler.hasDueEvent());
+	REQUIRE_FALSE(scheduler.consume(Scheduler::TimerIRQ));
+	REQUIRE(scheduler.consume(Scheduler::VBlank));
+	REQUIRE_FALSE(scheduler.hasDueEvent());
+	REQUIRE(scheduler.getNextEventTimestamp() == 100);
+}
+
+TEST_CASE("latch Scheduler", "[Scheduler]")
+{
+	Init()
+	snes.scheduler.advance(Scheduler::Scheduler::masterCyclesPerLine * 0x105 + 0x123 * 4);
+	snes.bus.read(0x2137);
+	REQUIRE(snes.bus.read(0x213C) == 0x23);
+	REQUIRE(snes.bus.read(0x213C) == 0x01);
+	REQUIRE(snes.bus.read(0x213D) == 0x05);
+	REQUIRE((snes.bus.read(0x213F) & 0x40) == 0x40);
+	REQUIRE((snes.bus.read(0x213F) & 0x40) == 0x00);
+	REQUIRE(snes.bus.read(0x213D) == 0x05);
+	REQUIRE(snes.bus.read(0x213D) == 0x01);
+}
+
+TEST_CASE("vTimer Scheduler", "[Scheduler]")
+{
+	Init()
+	snes.bus.write(0x4209, 5);
+	snes.bus.write(0x4200, 0x20);
+	REQUIRE(snes.scheduler.getEventTimestamp(Scheduler::TimerIRQ) == Scheduler::Scheduler::masterCyclesPerLine * 5);
+	snes.cpu._advanceClock(Scheduler::Scheduler::masterCyclesPerLine * 5 / 6);
+	REQUIRE_FALSE(snes.cpu.IsIRQRequested);
+	snes.cpu._advanceClock(1);
+	REQUIRE(snes.cpu.IsIRQRequested);
+	REQUIRE(snes.bus.read(0x4211) == 0x80);
+	REQUIRE_FALSE(snes.cpu.IsIRQRequested);
+	REQUIRE(snes.bus.read(0x4211) == 0x00);
+	REQUIRE(snes.scheduler.getEventTimestamp(Scheduler::TimerIRQ)
+		== Scheduler::Scheduler::masterCyclesPerFrame + Scheduler::Scheduler::masterCyclesPerLine * 5);
+}
+
+TEST_CASE("hTimer Scheduler", "[Scheduler]")
+{
+	Init()
+	snes.bus.write(0x4207, 100);
+	snes.bus.write(0x4200, 0x10);
+	for (unsigned line = 0; line < 3; line++) {
+		REQUIRE(snes.scheduler.getEventTimestamp(Scheduler::TimerIRQ) == Scheduler::Scheduler::masterCyclesPerLine * line + 400);
+		snes.cpu._advanceClock(Scheduler::Scheduler::masterCyclesPerLine / 6);
+		REQUIRE(snes.cpu.IsIRQRequested);
+		snes.bus.read(0x4211);
+	}
+	snes.bus.write(0x4200, 0x00);
+	REQUIRE(snes.scheduler.getEventTimestamp(Scheduler::TimerIRQ) == Scheduler::Scheduler::never);
+}
+
+TEST_CASE("vblank Scheduler", "[Scheduler]")
+{
+	Init()
+	snes.bus.write(0x4200, 0x80);
+	REQUIRE((snes.bus.read(0x4212) & 0x80) == 0);
+	snes.cpu._advanceClock(Scheduler::Scheduler::masterCyclesPerLine * Scheduler::Scheduler::vblankStartLine / 6 + 1);
+	REQUIRE(snes.cpu.IsNMIRequested);
+	REQUIRE((snes.bus.read(0x4212) & 0x80) == 0x80);
+	REQUIRE((snes.bus.read(0x4210) & 0x80) == 0x80);
+	REQUIRE((snes.bus.read(0x4210) & 0x80) == 0x00);
+}
+
+TEST_CASE("waitForTimer Scheduler", "[Scheduler]")
+{
+	Init()
+	snes.cpu._registers.pac = 0x000100;
+	snes.cpu._registers.p.i = false;
+	snes.cartridge.header.emulationInterrupts.irq = 0x200;
+	snes.wram._data[0x100] = 0xCB; // WAI
+	snes.wram._data[0x200] = 0x80; // BRA $0200
+	snes.wram._data[0x201] = 0xFE;
+	// The handler spins in an idle loop, it would jump the clock to the vblank.
+	snes.cpu.isIdleLoopSkippingEnabled = false;
+	snes.bus.write(0x4209, 1);
+	snes.bus.write(0x4200, 0x20);
+	while (snes.cpu._registers.pc != 0x200 && snes.scheduler.getFrame() == 0)
+		snes.cpu.update(0x0C);
+	REQUIRE(snes.cpu._registers.pc == 0x200);
+	REQUIRE(snes.scheduler.getVCounter() == 1);
+}